@@ -0,0 +1,205 @@
+#pragma once
+// (w,k) minimizer index of a sequence, an alternative seeding index to the suffix array
+#include "../SuffixArray/SuffixArray.hpp" // RepeatStats
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace minimizer_index
+{
+    // Class indexing the (w,k) minimizers of a sequence over {A, C, G, T} = 1..4 (other symbols break k-mers).
+    // Minimizers are placed by the high bits of their hash into buckets with a counting pass and every bucket is
+    // sorted by (hash, position), so a lookup binary-searches one short run for all copies of a minimizer. Hits of a query are extended to maximal exact matches and
+    // returned as the same (center position, query position, length) triples as SuffixArray::get_common_substrings.
+    class MinimizerIndex
+    {
+    public:
+        using triple = std::array<size_t, 3>;
+
+        // Constructor: indexes sequence[0, length) in one pass; the sequence must outlive the index (it is read by extension)
+        MinimizerIndex(const unsigned char* sequence, size_t length, int k = 15, int w = 10)
+            : _sequence(sequence)
+            , _length(length)
+            , _k(std::max(4, std::min(31, k)))
+            , _w(std::max(1, w))
+            , _mask((uint64_t(1) << (2 * _k)) - 1)
+            , max_occurrences(0)
+        {
+            std::vector<std::pair<uint64_t, size_t>> minimizers;
+            _minimizers(sequence, length, minimizers);
+
+            int bits = 1;
+            while ((size_t(1) << bits) < minimizers.size() && bits < 2 * _k)
+                ++bits;
+            _shift = 2 * _k - bits;
+            _offsets.assign((size_t(1) << bits) + 1, 0);
+            for (const auto& m : minimizers)
+                ++_offsets[(m.first >> _shift) + 1];
+            for (size_t i = 1; i != _offsets.size(); ++i)
+                _offsets[i] += _offsets[i - 1];
+            _entries.resize(minimizers.size());
+            std::vector<size_t> next(_offsets.begin(), _offsets.end() - 1);
+            for (const auto& m : minimizers)
+                _entries[next[m.first >> _shift]++] = Entry({ m.first, (uint64_t)m.second });
+
+            // Buckets hold several hashes in position order; group the copies of each minimizer
+            for (size_t b = 0; b + 1 < _offsets.size(); ++b)
+                std::sort(_entries.begin() + _offsets[b], _entries.begin() + _offsets[b + 1],
+                    [](const Entry& lhs, const Entry& rhs) { return lhs.hash != rhs.hash ? lhs.hash < rhs.hash : lhs.pos < rhs.pos; });
+        }
+
+        // Function to cap the occurrences of a minimizer: one found more than max_occurrences times gives no anchor (0 keeps all)
+        void set_occurrence_cap(size_t max_occurrences)
+        {
+            this->max_occurrences = max_occurrences;
+        }
+
+        // Function to get the maximal exact matches of at least threshold symbols that contain a shared minimizer,
+        // sorted by (query position, center position)
+        template<typename RandomAccessIterator>
+        std::vector<triple> get_common_substrings(RandomAccessIterator first, RandomAccessIterator last, size_t threshold,
+            suffix_array::RepeatStats* stats = NULL) const
+        {
+            std::vector<triple> common_substrings;
+            const size_t rhs_len = last - first;
+            if (rhs_len < (size_t)_k)
+                return common_substrings;
+
+            std::vector<std::pair<uint64_t, size_t>> minimizers;
+            _minimizers(first, rhs_len, minimizers);
+
+            // Hits as (diagonal, query position), diagonal = center position - query position
+            std::vector<std::pair<int64_t, size_t>> hits;
+            size_t masked_end = 0;
+            for (const auto& m : minimizers)
+            {
+                const Entry* begin = _entries.data() + _offsets[m.first >> _shift];
+                const Entry* end = _entries.data() + _offsets[(m.first >> _shift) + 1];
+                const auto range = std::equal_range(begin, end, Entry({ m.first, 0 }),
+                    [](const Entry& lhs, const Entry& rhs) { return lhs.hash < rhs.hash; });
+                const Entry* lower = range.first;
+                const Entry* upper = range.second;
+                if (lower == upper)
+                    continue;
+                if (max_occurrences != 0 && (size_t)(upper - lower) > max_occurrences)
+                {
+                    if (stats != NULL)
+                    {
+                        ++stats->masked_seeds;
+                        stats->masked_occurrences += upper - lower;
+                        if (m.second + _k > masked_end)
+                        {
+                            stats->masked_bases += m.second + _k - std::max(m.second, masked_end);
+                            masked_end = m.second + _k;
+                        }
+                    }
+                    continue;
+                }
+                for (const Entry* e = lower; e != upper; ++e)
+                    hits.emplace_back((int64_t)e->pos - (int64_t)m.second, m.second);
+            }
+
+            // Extend every hit to its maximal exact match; later hits inside it on the same diagonal are the same match
+            std::sort(hits.begin(), hits.end());
+            int64_t diagonal = 0;
+            size_t covered_end = 0;
+            for (size_t i = 0; i != hits.size(); ++i)
+            {
+                if (i != 0 && hits[i].first == diagonal && hits[i].second < covered_end)
+                    continue;
+                diagonal = hits[i].first;
+                size_t rhs = hits[i].second, lhs = (size_t)(diagonal + (int64_t)rhs), len = _k;
+                while (rhs != 0 && lhs != 0 && (unsigned char)first[rhs - 1] == _sequence[lhs - 1])
+                    --rhs, --lhs, ++len;
+                while (rhs + len < rhs_len && lhs + len < _length && (unsigned char)first[rhs + len] == _sequence[lhs + len])
+                    ++len;
+                covered_end = rhs + len;
+                if (len >= threshold)
+                    common_substrings.emplace_back(triple({ lhs, rhs, len }));
+            }
+            std::sort(common_substrings.begin(), common_substrings.end(),
+                [](const triple& lhs, const triple& rhs) { return lhs[1] != rhs[1] ? lhs[1] < rhs[1] : lhs[0] < rhs[0]; });
+            return common_substrings;
+        }
+
+        int k() const { return _k; }
+        int w() const { return _w; }
+        size_t size() const { return _entries.size(); }
+
+        // Function to get the number of bytes held by the index
+        size_t memory_usage() const
+        {
+            return _entries.capacity() * sizeof(Entry) + _offsets.capacity() * sizeof(size_t);
+        }
+
+    private:
+        struct Entry
+        {
+            uint64_t hash;
+            uint64_t pos;
+        };
+
+        // Invertible integer hash of a k-mer code, so equal hashes mean equal k-mers
+        uint64_t _hash(uint64_t key) const noexcept
+        {
+            key = (~key + (key << 21)) & _mask;
+            key = key ^ key >> 24;
+            key = ((key + (key << 3)) + (key << 8)) & _mask;
+            key = key ^ key >> 14;
+            key = ((key + (key << 2)) + (key << 4)) & _mask;
+            key = key ^ key >> 28;
+            key = (key + (key << 31)) & _mask;
+            return key;
+        }
+
+        // Helper function to collect the (hash, position) minimizers of s[0, n): the smallest hash of every w
+        // consecutive k-mers (leftmost on ties), each reported once
+        template<typename RandomAccessIterator>
+        void _minimizers(RandomAccessIterator s, size_t n, std::vector<std::pair<uint64_t, size_t>>& out) const
+        {
+            std::deque<std::pair<uint64_t, size_t>> window; // Increasing hashes of the k-mers that can still be minimal
+            uint64_t code = 0;
+            size_t valid = 0, kmers = 0; // Symbols since the last break, k-mers in the current run
+            size_t last = (size_t)-1;
+            for (size_t i = 0; i != n; ++i)
+            {
+                const unsigned char c = s[i];
+                if (c < 1 || c > 4)
+                {
+                    valid = kmers = 0;
+                    window.clear();
+                    continue;
+                }
+                code = ((code << 2) | (uint64_t)(c - 1)) & _mask;
+                if (++valid < (size_t)_k)
+                    continue;
+
+                const size_t pos = i + 1 - _k;
+                const uint64_t h = _hash(code);
+                while (!window.empty() && window.back().first > h)
+                    window.pop_back();
+                window.emplace_back(h, pos);
+                while (window.front().second + _w <= pos)
+                    window.pop_front();
+                if (++kmers >= (size_t)_w && window.front().second != last)
+                {
+                    last = window.front().second;
+                    out.push_back(window.front());
+                }
+            }
+        }
+
+        const unsigned char* _sequence; // Indexed sequence
+        const size_t _length;
+        const int _k, _w;
+        const uint64_t _mask; // Low 2k bits
+        int _shift; // Hash bits below the bucket number
+        std::vector<size_t> _offsets; // Start of every bucket in _entries
+        std::vector<Entry> _entries; // Minimizers grouped by bucket, sorted by (hash, position) inside a bucket
+        size_t max_occurrences; // Occurrence cap of a minimizer, 0 for none
+    };
+}
@@ -1,207 +1,545 @@
-#include "StarAligner.hpp"
-#include "../Utils/Pseudo.hpp"
-#include "../Utils/Utils.hpp"
-#include "../Utils/Graph.hpp"
-#include "../PairwiseAlignment/NeedlemanWunshReusable.hpp"
-
-// Function to align sequences using star alignment
-std::vector<std::vector<unsigned char>> star_alignment::StarAligner::align(std::vector<std::vector<utils::Insertion>>& insertions, std::vector<sequence_type>& sequences, size_t thresh, int center) {
-    return StarAligner(insertions, sequences, thresh, center)._align();
-}
-
-// Function to get gaps in sequences using star alignment
-void star_alignment::StarAligner::get_gaps(std::vector<std::vector<utils::Insertion>>& insertions, std::vector<sequence_type>& sequences, size_t thresh, int center) {
-    StarAligner(insertions, sequences, thresh, center)._get_gaps();
-}
-
-// Constructor for StarAligner class
-star_alignment::StarAligner::StarAligner(std::vector<std::vector<utils::Insertion>>& insertions, std::vector<sequence_type>& sequences, size_t thresh, int center)
-    : thresh1(thresh)
-    , Insertions(insertions)
-    , _sequences(sequences)
-    , _row(_sequences.size())
-    , _lengths(_set_lengths())
-    , _centre(_set_centre())
-    , _centre_len(_sequences[_centre].size()) {
-    if (center != -1) {
-        _centre = center;
-        _centre_len = _sequences[_centre].size();
-    }
-}
-
-// Function to set the lengths of sequences
-std::vector<size_t> star_alignment::StarAligner::_set_lengths() const {
-    std::vector<size_t> lengths(_row);
-    for (size_t i = 0; i != _row; ++i) lengths[i] = _sequences[i].size();
-    return lengths;
-}
-
-// Function to set the central sequence
-size_t star_alignment::StarAligner::_set_centre() const {
-    size_t centre_index = 0;
-    for (size_t i = 1; i != _row; ++i)
-        if (_lengths[i] > _lengths[centre_index])
-            centre_index = i;
-    return centre_index;
-}
-
-// Function to perform alignment
-std::vector<std::vector<unsigned char>> star_alignment::StarAligner::_align() const {
-    return _insert_gaps(_merge_results(_pairwise_align()));
-}
-
-// Function to get gaps for alignment
-void star_alignment::StarAligner::_get_gaps() const {
-    mul_pairwise_align();
-}
-
-// Function to perform pairwise alignment
-auto star_alignment::StarAligner::_pairwise_align() const -> std::vector<std::array<std::vector<utils::Insertion>, 2>> {
-    suffix_array::SuffixArray<nucleic_acid_pseudo::NUMBER> st(_sequences[_centre].cbegin(), _sequences[_centre].cend(), nucleic_acid_pseudo::end_mark); // Create suffix array
-    std::vector<std::array<std::vector<utils::Insertion>, 2>> all_pairwise_gaps;
-    wfa::WFAlignerGapAffine aligner(2, 3, 1, wfa::WFAligner::Alignment, wfa::WFAligner::MemoryHigh); // Create WFA aligner
-    
-    for (size_t i = 0; i != _row; ++i) {
-        auto common_substrings = _optimal_path(st.get_common_substrings(_sequences[i].cbegin(), _sequences[i].cend(), thresh1));
-        
-        // Define alignment intervals
-        std::vector<quadra> intervals;
-        intervals.reserve(common_substrings.size() + 1);
-        if (common_substrings.empty()) {
-            intervals.emplace_back(quadra({0, _centre_len, 0, _sequences[i].size()}));
-        } else {
-            if (common_substrings[0][0] || common_substrings[0][1])
-                intervals.emplace_back(quadra({0, common_substrings[0][0], 0, common_substrings[0][1]}));
-            for (size_t j = 0, end_index = common_substrings.size() - 1; j != end_index; ++j)
-                if (common_substrings[j][0] + common_substrings[j][2] != common_substrings[j + 1][0] ||
-                    common_substrings[j][1] + common_substrings[j][2] != common_substrings[j + 1][1])
-                    intervals.emplace_back(quadra({
-                        common_substrings[j][0] + common_substrings[j][2], common_substrings[j + 1][0],
-                        common_substrings[j][1] + common_substrings[j][2], common_substrings[j + 1][1]
-                    }));
-            if (common_substrings.back()[0] + common_substrings.back()[2] != _centre_len ||
-                common_substrings.back()[1] + common_substrings.back()[2] != _lengths[i])
-                intervals.emplace_back(quadra({
-                    common_substrings.back()[0] + common_substrings.back()[2], _centre_len,
-                    common_substrings.back()[1] + common_substrings.back()[2], _lengths[i]
-                }));
-        }
-
-        // Perform pairwise alignment for each interval
-        std::array<std::vector<utils::Insertion>, 2> pairwise_gaps;
-        for (size_t j = 0; j != intervals.size(); ++j) {
-            const size_t centre_begin = intervals[j][0];
-            const size_t centre_end = intervals[j][1];
-            const size_t sequence_begin = intervals[j][2];
-            const size_t sequence_end = intervals[j][3];
-
-            auto [lhs_gaps, rhs_gaps] = mywfa(aligner, _sequences[_centre], centre_begin, centre_end,
-                _sequences[i], sequence_begin, sequence_end); // Perform alignment using WFA
-            
-            // Collect gaps for alignment
-            for (int ii = 0; ii < lhs_gaps.size(); ii++) {
-                if ((!pairwise_gaps[0].empty()) && pairwise_gaps[0].back().index == std::get<0>(lhs_gaps[ii]))
-                    pairwise_gaps[0].back().number += std::get<1>(lhs_gaps[ii]);
-                else
-                    pairwise_gaps[0].emplace_back(utils::Insertion({(size_t)std::get<0>(lhs_gaps[ii]), (size_t)std::get<1>(lhs_gaps[ii])}));
-            }
-            for (int ii = 0; ii < rhs_gaps.size(); ii++) {
-                if ((!pairwise_gaps[1].empty()) && pairwise_gaps[1].back().index == std::get<0>(rhs_gaps[ii]))
-                    pairwise_gaps[1].back().number += std::get<1>(rhs_gaps[ii]);
-                else
-                    pairwise_gaps[1].emplace_back(utils::Insertion({(size_t)std::get<0>(rhs_gaps[ii]), (size_t)std::get<1>(rhs_gaps[ii])}));
-            }
-        }
-        all_pairwise_gaps.emplace_back(pairwise_gaps);
-        _sequences[i].clear();
-    }
-    return all_pairwise_gaps;
-}
-
-// Helper function to find optimal path in common substrings
-auto star_alignment::StarAligner::_optimal_path(const std::vector<triple>& common_substrings) -> std::vector<triple> {
-    std::vector<triple> optimal_common_substrings;
-    if (common_substrings.empty()) return optimal_common_substrings;
-
-    const size_t pair_num = common_substrings.size();
-    utils::AdjacencyList graph(pair_num + 1);
-
-    // Build graph of common substrings
-    for (size_t i = 0; i != pair_num; ++i)
-        for (size_t j = 0; j != pair_num; ++j)
-            if (i != j && common_substrings[i][0] + common_substrings[i][2] < common_substrings[j][0] + common_substrings[j][2]
-                && common_substrings[i][1] + common_substrings[i][2] < common_substrings[j][1] + common_substrings[j][2]) {
-                const int possible_overlap = std::max(
-                    static_cast<int>(common_substrings[i][0] + common_substrings[i][2]) - static_cast<int>(common_substrings[j][0]),
-                    static_cast<int>(common_substrings[i][1] + common_substrings[i][2]) - static_cast<int>(common_substrings[j][1])
-                );
-                unsigned weight = common_substrings[j][2];
-                if (possible_overlap > 0) weight -= possible_overlap;
-                graph.add_edge(i + 1, j + 1, weight);
-            }
-    for (size_t i = 0; i != pair_num; ++i)
-        graph.add_edge(0, i + 1, common_substrings[i][2]);
-
-    // Find the longest path
-    const auto optimal_path = graph.get_longest_path();
-    optimal_common_substrings.reserve(optimal_path.size());
-    optimal_common_substrings.emplace_back(triple({common_substrings[optimal_path[0] - 1][0],
-                                                   common_substrings[optimal_path[0] - 1][1],
-                                                   common_substrings[optimal_path[0] - 1][2]}));
-
-    for (size_t i = 0; i < optimal_path.size() - 1; ++i) {
-        size_t new_len = graph.get_weight(optimal_path[i], optimal_path[i + 1]);
-        size_t old_len = common_substrings[optimal_path[i + 1] - 1][2];
-        int difference = static_cast<int>(old_len) - static_cast<int>(new_len);
-        size_t lhs_first = common_substrings[optimal_path[i + 1] - 1][0];
-        size_t rhs_first = common_substrings[optimal_path[i + 1] - 1][1];
-        if (difference > 0) {
-            lhs_first += difference; rhs_first += difference;
-        }
-        optimal_common_substrings.emplace_back(triple({lhs_first, rhs_first, new_len}));
-    }
-
-    return optimal_common_substrings;
-}
-
-// Function to append gaps
-void star_alignment::StarAligner::_append(const std::vector<size_t>& src_gaps, std::vector<utils::Insertion>& des_gaps, size_t start) {
-    for (size_t i = 0; i != src_gaps.size(); ++i)
-        if (src_gaps[i]) {
-            if (!des_gaps.empty() && des_gaps.back().index == start + i)
-                des_gaps.back().number += src_gaps[i];
-            else
-                des_gaps.emplace_back(utils::Insertion({start + i, src_gaps[i]}));
-        }
-}
-
-// Function to merge pairwise alignment results
-auto star_alignment::StarAligner::_merge_results(const std::vector<std::array<std::vector<utils::Insertion>, 2>>& pairwise_gaps) const -> std::vector<std::vector<utils::Insertion>> {
-    // Implementation of merging results from pairwise alignments
-}
-
-// Function to insert gaps into sequences
-auto star_alignment::StarAligner::_insert_gaps(const std::vector<std::vector<utils::Insertion>>& gaps) const -> std::vector<sequence_type> {
-    // Insert gaps into sequences based on pairwise gaps
-}
-
-// Function to perform multi-threaded pairwise alignment
-void star_alignment::StarAligner::mul_pairwise_align() const {
-    // Perform pairwise alignment using multiple threads
-}
-
-// Helper function for multi-threaded alignment of sequences
-void star_alignment::StarAligner::mul_fasta_func(int i, const suffix_array::SuffixArray<nucleic_acid_pseudo::NUMBER>& st,
-    std::vector<std::array<std::vector<utils::Insertion>, 2>>& all_pairwise_gaps, int threshold1) const {
-    // Function to align a sequence with the center sequence
-}
-
-// Helper function for backtracking to find optimal path
-std::vector<int> star_alignment::StarAligner::_trace_back_bp(const std::vector<triple>& common_substrings, int* p) {
-    // Backtrack to find the optimal alignment path
-}
-
-// Function to find optimal path with backtracking
-auto star_alignment::StarAligner::_optimal_path_bp(const std::vector<triple>& optimal_common_substrings) -> std::vector<triple> {
-    // Use backtracking to find the optimal alignment path
-}
+#include "StarAligner.hpp"
+#include "../Utils/Pseudo.hpp"
+#include "../Utils/Utils.hpp"
+#include "../Utils/RangeMax.hpp"
+#include "../Utils/Arguments.hpp"
+#include "../PairwiseAlignment/NeedlemanWunshReusable.hpp"
+
+
+namespace
+{
+    // WFA aligner that can report the memory it holds (wavefronts and backtrace buffers, kept between alignments)
+    class ContextAligner : public wfa::WFAlignerGapAffine
+    {
+    public:
+        ContextAligner() : wfa::WFAlignerGapAffine(2, 3, 1, wfa::WFAligner::Alignment, wfa::WFAligner::MemoryHigh) {}
+        size_t memory_usage() { return (size_t)wavefront_aligner_get_size(wfAligner); }
+    };
+}
+
+// Alignment state of one thread, reused for all the rows it aligns
+struct star_alignment::StarAligner::AlignerContext
+{
+    ContextAligner aligner; // WFA aligner
+    sequence_type sequence; // Row unpacked for the pairwise kernel
+    std::vector<quadra> intervals; // Intervals between the anchors of the row
+    size_t rows = 0; // Rows aligned with this context
+
+    // Function to get the number of bytes held by the context
+    size_t memory_usage() {
+        return aligner.memory_usage() + sequence.capacity() + intervals.capacity() * sizeof(quadra);
+    }
+};
+
+// Function to align sequences using star alignment
+std::vector<std::vector<unsigned char>> star_alignment::StarAligner::align(utils::GapStore& insertions, const utils::PackedSequences& sequences, size_t thresh, int center) {
+    return StarAligner(insertions, sequences, thresh, center)._align();
+}
+
+// Function to get gaps in sequences using star alignment
+void star_alignment::StarAligner::get_gaps(utils::GapStore& insertions, std::vector<size_t>& representatives,
+    const utils::PackedSequences& sequences, size_t thresh, int center) {
+    StarAligner aligner(insertions, sequences, thresh, center);
+    aligner._get_gaps();
+    representatives = std::move(aligner._representatives);
+}
+
+// Constructor for StarAligner class
+star_alignment::StarAligner::StarAligner(utils::GapStore& insertions, const utils::PackedSequences& sequences, size_t thresh, int center)
+    : Insertions(insertions)
+    , _sequences(sequences)
+    , _row(_sequences.size())
+    , _lengths(_set_lengths())
+    , thresh1(thresh)
+    , _centre(_set_centre())
+    , _centre_len(_sequences.length(_centre)) {
+    if (center != -1) {
+        _centre = center;
+        _centre_len = _sequences.length(_centre);
+    }
+    _sequences.unpack(_centre, _centre_sequence);
+    _representatives = _set_representatives();
+    _contexts.resize((threadPool0 != NULL ? threadPool0->Thread_num : 0) + 1);
+    _centre_profile.reset(new std::atomic<size_t>[_centre_len + 1]());
+    _residuals.resize(_row);
+}
+
+// Destructor, here where the aligner contexts are complete
+star_alignment::StarAligner::~StarAligner() = default;
+
+// Function to get the aligner context of the calling thread: one per ThreadPool worker, plus one for any
+// other thread, created on first use
+auto star_alignment::StarAligner::_context() const -> AlignerContext& {
+    const int worker = ThreadPool::worker_index();
+    const size_t slot = worker >= 0 && (size_t)worker + 1 < _contexts.size() ? (size_t)worker : _contexts.size() - 1;
+    if (!_contexts[slot]) _contexts[slot].reset(new AlignerContext());
+    return *_contexts[slot];
+}
+
+// Function to report the rows and memory of every aligner context, then release them
+void star_alignment::StarAligner::_release_contexts() const {
+    size_t count = 0, total = 0;
+    std::string rows, memory;
+    for (auto& context : _contexts) {
+        if (!context) continue;
+        const size_t bytes = context->memory_usage();
+        rows += (count ? "/" : "") + std::to_string(context->rows);
+        memory += (count ? "/" : "") + std::to_string(bytes / 1024);
+        total += bytes;
+        ++count;
+        context.reset();
+    }
+    std::cout << "                    | Info : aligner contexts : " << count << ", rows " << rows << ", memory " << memory << " KB (" << total / 1024 << " KB in total)\n";
+}
+
+// Function to set the lengths of sequences
+std::vector<size_t> star_alignment::StarAligner::_set_lengths() const {
+    std::vector<size_t> lengths(_row);
+    for (size_t i = 0; i != _row; ++i) lengths[i] = _sequences.length(i);
+    return lengths;
+}
+
+// Function to set the central sequence
+size_t star_alignment::StarAligner::_set_centre() const {
+    size_t centre_index = 0;
+    for (size_t i = 1; i != _row; ++i)
+        if (_lengths[i] > _lengths[centre_index])
+            centre_index = i;
+    return centre_index;
+}
+
+// Function to group exact duplicates by hashing the packed rows
+std::vector<size_t> star_alignment::StarAligner::_set_representatives() const {
+    std::vector<std::pair<uint64_t, size_t>> hashes(_row);
+    auto hash_rows = [this, &hashes](size_t first, size_t last) {
+        for (size_t i = first; i != last; ++i) hashes[i] = std::make_pair(_sequences.hash(i), i);
+    };
+    const size_t block = 4096;
+    if (threadPool0 == NULL || _row <= block)
+        hash_rows(0, _row);
+    else {
+        for (size_t first = 0; first < _row; first += block)
+            threadPool0->execute([&hash_rows, first, this, block]() { hash_rows(first, std::min(first + block, _row)); });
+        threadPool0->waitFinished();
+    }
+    std::sort(hashes.begin(), hashes.end());
+
+    // Within a run of equal hashes the first row with the same bases becomes the representative
+    std::vector<size_t> representatives(_row);
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i != _row; ) {
+        size_t j = i;
+        candidates.clear();
+        for (; j != _row && hashes[j].first == hashes[i].first; ++j) {
+            const size_t row = hashes[j].second;
+            representatives[row] = row;
+            for (size_t candidate : candidates)
+                if (_sequences.equal(candidate, row)) {
+                    representatives[row] = candidate;
+                    break;
+                }
+            if (representatives[row] == row) candidates.push_back(row);
+        }
+        i = j;
+    }
+    return representatives;
+}
+
+// Function to perform alignment
+std::vector<std::vector<unsigned char>> star_alignment::StarAligner::_align() const {
+    _pairwise_align();
+    _merge_results();
+    return _insert_gaps(Insertions);
+}
+
+// Function to get gaps for alignment
+void star_alignment::StarAligner::_get_gaps() const {
+    mul_pairwise_align();
+}
+
+// Function to check whether the center is too long for a 32-bit index
+bool star_alignment::StarAligner::_wide_index() const {
+    if (centre_index<int32_t>::fits_32bit(_centre_len)) return false;
+    std::cout << "                    | Info : 64-bit index : center of " << _centre_len << " bases\n";
+    return true;
+}
+
+// Function to perform pairwise alignment
+void star_alignment::StarAligner::_pairwise_align() const {
+    if (arguments::seed_mode == "minimizer")
+        _pairwise_align_with(*_build_minimizer_index());
+    else if (_wide_index())
+        _pairwise_align_with(*_build_index<int64_t>());
+    else
+        _pairwise_align_with(*_build_index<int32_t>());
+}
+
+// Function to perform pairwise alignment with the given index of the center
+template<typename Index>
+void star_alignment::StarAligner::_pairwise_align_with(const Index& st) const {
+    AlignerContext& context = _context();
+    
+    for (size_t i = 0; i != _row; ++i)
+        if (_representatives[i] == i)
+            _fold_row(i, _align_row(i, st, context, thresh1));
+    _report_seeding();
+    _release_contexts();
+}
+
+// Function to build (or map) the suffix array of the center and set it up for the selected seeding: forward BWT and occurrence cap
+template<typename index_type>
+auto star_alignment::StarAligner::_build_index() const -> std::unique_ptr<centre_index<index_type>> {
+    std::unique_ptr<centre_index<index_type>> st(new centre_index<index_type>(_centre_sequence.cbegin(), _centre_sequence.cend(), nucleic_acid_pseudo::end_mark,
+        arguments::index_file_name, 192, arguments::sa_sampling, threadPool0 != NULL ? (int)threadPool0->Thread_num : 1)); // Create or map the suffix array
+
+    // SMEMs and the re-extension of repeats both need the bidirectional index
+    if (arguments::seed_mode == "smem" || (arguments::max_occurrences != 0 && arguments::reextend_repeats))
+        st->build_forward(_centre_sequence.cbegin(), _centre_sequence.cend());
+    st->set_occurrence_cap(arguments::max_occurrences, arguments::reextend_repeats);
+    if (st->sa_sampling() > 1)
+        std::cout << "                    | Info : sampled suffix array (1/" << st->sa_sampling() << ") : " << st->sa_memory() / 1024 << " KB\n";
+    return st;
+}
+
+// Function to build the minimizer index of the center
+auto star_alignment::StarAligner::_build_minimizer_index() const -> std::unique_ptr<minimizer_index::MinimizerIndex> {
+    const auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<minimizer_index::MinimizerIndex> mi(new minimizer_index::MinimizerIndex(_centre_sequence.data(), _centre_len,
+        arguments::minimizer_k, arguments::minimizer_w));
+    mi->set_occurrence_cap(arguments::max_occurrences);
+    std::cout << "                    | Info : minimizer index (k = " << mi->k() << ", w = " << mi->w() << ") : " << mi->size() << " minimizers, "
+        << mi->memory_usage() / 1024 << " KB, " << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s\n";
+    return mi;
+}
+
+// Function to add the counters of one seeding call to the totals
+void star_alignment::StarAligner::_add_repeat_stats(const suffix_array::RepeatStats& stats) const {
+    _masked_seeds += stats.masked_seeds;
+    _masked_occurrences += stats.masked_occurrences;
+    _masked_bases += stats.masked_bases;
+    _reextended_count += stats.reextended;
+}
+
+// Function to report how many anchors the index produced per second of seeding
+void star_alignment::StarAligner::_report_seeding() const {
+    const double seconds = _seeding_time.load() / 1e9;
+    std::cout << "                    | Info : seeding (" << arguments::seed_mode << ") : " << _anchor_count.load() << " anchors, "
+        << (size_t)(seconds > 0 ? _anchor_count.load() / seconds : 0) << " anchors/s per thread\n";
+    if (arguments::seed_mode == "smem")
+        std::cout << "                    | Info : contained matches dropped : " << _contained_count.load() << "\n";
+    if (arguments::max_occurrences != 0) {
+        std::cout << "                    | Info : repeat-masked (over " << arguments::max_occurrences << " occurrences) : " << _masked_seeds.load() << " matches, "
+            << _masked_occurrences.load() << " anchors, " << _masked_bases.load() << " query bases\n";
+        if (arguments::reextend_repeats)
+            std::cout << "                    | Info : repeats re-extended : " << _reextended_count.load() << "\n";
+    }
+}
+
+// Function to align one row with the center: anchors from the index, WFA between them
+template<typename Index>
+auto star_alignment::StarAligner::_align_row(size_t i, const Index& st,
+    AlignerContext& context, size_t threshold) const -> std::array<std::vector<utils::Insertion>, 2> {
+    return _align_anchored(i, _seed_row(i, st, threshold), context);
+}
+
+// Function to find the anchors of one row with the selected seeding mode
+template<typename Index>
+auto star_alignment::StarAligner::_seed_row(size_t i, const Index& st, size_t threshold) const -> std::vector<triple> {
+    const auto packed = _sequences[i];
+    const auto seeding_start = std::chrono::steady_clock::now();
+    std::vector<triple> anchors;
+    suffix_array::RepeatStats stats;
+    if constexpr (std::is_same<Index, minimizer_index::MinimizerIndex>::value)
+        anchors = st.get_common_substrings(packed.cbegin(), packed.cend(), threshold, &stats);
+    else if (arguments::seed_mode == "smem") {
+        size_t contained = 0;
+        anchors = st.get_smems(packed.cbegin(), packed.cend(), threshold, &contained, &stats);
+        _contained_count += contained;
+    }
+    else
+        anchors = st.get_common_substrings(packed.cbegin(), packed.cend(), threshold, &stats); // Seeding reads the packed row directly
+    _add_repeat_stats(stats);
+    _seeding_time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - seeding_start).count();
+    _anchor_count += anchors.size();
+    return anchors;
+}
+
+// Function to seed a group of rows with one interleaved index search, then align them one by one
+template<typename Index>
+void star_alignment::StarAligner::_align_batch(const std::vector<size_t>& rows, const Index& st,
+    size_t threshold) const {
+    AlignerContext& context = _context();
+    // Only the suffix array has the interleaved search; the other seeding modes align row by row
+    if constexpr (!std::is_same<Index, minimizer_index::MinimizerIndex>::value) {
+        if (arguments::seed_mode == "fm") {
+            using iterator = utils::PackedSequences::const_iterator;
+            std::vector<std::pair<iterator, iterator>> queries;
+            queries.reserve(rows.size());
+            for (size_t i : rows)
+                queries.emplace_back(_sequences[i].cbegin(), _sequences[i].cend());
+
+            const auto seeding_start = std::chrono::steady_clock::now();
+            suffix_array::RepeatStats stats;
+            auto anchors = st.get_common_substrings_batch(queries, threshold, &stats);
+            _add_repeat_stats(stats);
+            _seeding_time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - seeding_start).count();
+
+            for (size_t j = 0; j != rows.size(); ++j) {
+                _anchor_count += anchors[j].size();
+                _fold_row(rows[j], _align_anchored(rows[j], anchors[j], context));
+                std::vector<triple>().swap(anchors[j]);
+            }
+            return;
+        }
+    }
+    for (size_t i : rows)
+        _fold_row(i, _align_row(i, st, context, threshold));
+}
+
+// Function to align one row with the center between the anchors found for it
+auto star_alignment::StarAligner::_align_anchored(size_t i, const std::vector<triple>& anchors,
+    AlignerContext& context) const -> std::array<std::vector<utils::Insertion>, 2> {
+    auto common_substrings = _optimal_path(anchors);
+    sequence_type& sequence = context.sequence;
+    _sequences.unpack(i, sequence);
+    ++context.rows;
+
+    // Define alignment intervals
+    std::vector<quadra>& intervals = context.intervals;
+    intervals.clear();
+    if (common_substrings.empty()) {
+        intervals.emplace_back(quadra({0, _centre_len, 0, _lengths[i]}));
+    } else {
+        if (common_substrings[0][0] || common_substrings[0][1])
+            intervals.emplace_back(quadra({0, common_substrings[0][0], 0, common_substrings[0][1]}));
+        for (size_t j = 0, end_index = common_substrings.size() - 1; j != end_index; ++j)
+            if (common_substrings[j][0] + common_substrings[j][2] != common_substrings[j + 1][0] ||
+                common_substrings[j][1] + common_substrings[j][2] != common_substrings[j + 1][1])
+                intervals.emplace_back(quadra({
+                    common_substrings[j][0] + common_substrings[j][2], common_substrings[j + 1][0],
+                    common_substrings[j][1] + common_substrings[j][2], common_substrings[j + 1][1]
+                }));
+        if (common_substrings.back()[0] + common_substrings.back()[2] != _centre_len ||
+            common_substrings.back()[1] + common_substrings.back()[2] != _lengths[i])
+            intervals.emplace_back(quadra({
+                common_substrings.back()[0] + common_substrings.back()[2], _centre_len,
+                common_substrings.back()[1] + common_substrings.back()[2], _lengths[i]
+            }));
+    }
+
+    // Perform pairwise alignment for each interval
+    std::array<std::vector<utils::Insertion>, 2> pairwise_gaps;
+    for (size_t j = 0; j != intervals.size(); ++j) {
+        const size_t centre_begin = intervals[j][0];
+        const size_t centre_end = intervals[j][1];
+        const size_t sequence_begin = intervals[j][2];
+        const size_t sequence_end = intervals[j][3];
+
+        auto [lhs_gaps, rhs_gaps] = mywfa(context.aligner, _centre_sequence, centre_begin, centre_end,
+            sequence, sequence_begin, sequence_end); // Perform alignment using WFA
+        
+        // Collect gaps for alignment
+        for (size_t ii = 0; ii < lhs_gaps.size(); ii++) {
+            if ((!pairwise_gaps[0].empty()) && pairwise_gaps[0].back().index == std::get<0>(lhs_gaps[ii]))
+                pairwise_gaps[0].back().number += std::get<1>(lhs_gaps[ii]);
+            else
+                pairwise_gaps[0].emplace_back(utils::Insertion({std::get<0>(lhs_gaps[ii]), std::get<1>(lhs_gaps[ii])}));
+        }
+        for (size_t ii = 0; ii < rhs_gaps.size(); ii++) {
+            if ((!pairwise_gaps[1].empty()) && pairwise_gaps[1].back().index == std::get<0>(rhs_gaps[ii]))
+                pairwise_gaps[1].back().number += std::get<1>(rhs_gaps[ii]);
+            else
+                pairwise_gaps[1].emplace_back(utils::Insertion({std::get<0>(rhs_gaps[ii]), std::get<1>(rhs_gaps[ii])}));
+        }
+    }
+    return pairwise_gaps;
+}
+
+// Helper function to find optimal path in common substrings: the best chain of anchors (see utils::chain_anchors),
+// each anchor trimmed by its overlap with the previous one
+auto star_alignment::StarAligner::_optimal_path(const std::vector<triple>& common_substrings) -> std::vector<triple> {
+    std::vector<triple> optimal_common_substrings;
+    if (common_substrings.empty()) return optimal_common_substrings;
+
+    const std::vector<size_t> optimal_path = utils::chain_anchors(common_substrings);
+    optimal_common_substrings.reserve(optimal_path.size());
+    optimal_common_substrings.emplace_back(common_substrings[optimal_path[0]]);
+    for (size_t i = 0; i < optimal_path.size() - 1; ++i) {
+        const triple& lhs = common_substrings[optimal_path[i]];
+        const triple& rhs = common_substrings[optimal_path[i + 1]];
+        const int64_t overlap = std::max((int64_t)(lhs[0] + lhs[2]) - (int64_t)rhs[0], (int64_t)(lhs[1] + lhs[2]) - (int64_t)rhs[1]);
+        if (overlap > 0)
+            optimal_common_substrings.emplace_back(triple({ rhs[0] + (size_t)overlap, rhs[1] + (size_t)overlap, rhs[2] - (size_t)overlap }));
+        else
+            optimal_common_substrings.emplace_back(rhs);
+    }
+
+    return optimal_common_substrings;
+}
+
+// Function to append gaps
+void star_alignment::StarAligner::_append(const std::vector<size_t>& src_gaps, std::vector<utils::Insertion>& des_gaps, size_t start) {
+    for (size_t i = 0; i != src_gaps.size(); ++i)
+        if (src_gaps[i]) {
+            if (!des_gaps.empty() && des_gaps.back().index == start + i)
+                des_gaps.back().number += src_gaps[i];
+            else
+                des_gaps.emplace_back(utils::Insertion({start + i, src_gaps[i]}));
+        }
+}
+
+// Function to fold a finished pairwise result into the center profile (the most gaps any row puts before each
+// center position) and keep the result as the row's residual, delta-encoded. The residual cannot be reduced to the
+// row's gaps minus the profile: the profile is only final once every row is folded, and _merge_row needs where the
+// row's own insertions and gaps fall to place the profile's extra columns, which is the whole pairwise result.
+void star_alignment::StarAligner::_fold_row(size_t i, const std::array<std::vector<utils::Insertion>, 2>& pairwise_gaps) const {
+    for (const auto& gap : pairwise_gaps[0]) {
+        std::atomic<size_t>& slot = _centre_profile[gap.index];
+        size_t current = slot.load(std::memory_order_relaxed);
+        while (current < gap.number && !slot.compare_exchange_weak(current, gap.number, std::memory_order_relaxed));
+    }
+    for (int k = 0; k != 2; ++k) {
+        _residuals[i][k] = utils::InsertionList(pairwise_gaps[k].cbegin(), pairwise_gaps[k].cend());
+        _residuals[i][k].shrink_to_fit();
+        _residual_runs += _residuals[i][k].size();
+        _residual_bytes += _residuals[i][k].memory_usage();
+    }
+}
+
+// Function to merge pairwise alignment results into Insertions: every row is folded into the center profile, so
+// each residual is released as soon as the row's gaps in the final alignment are known (and spilled past the limit)
+void star_alignment::StarAligner::_merge_results() const {
+    // Gaps before every center position in the final alignment: the maximum over all rows
+    std::vector<size_t> final_gaps(_centre_len + 1);
+    for (size_t p = 0; p <= _centre_len; ++p)
+        final_gaps[p] = _centre_profile[p].load(std::memory_order_relaxed);
+    _centre_profile.reset();
+    std::cout << "                    | Info : pairwise residuals : " << _residual_bytes.load() << " B for " << _residual_runs.load()
+        << " runs (" << _residual_runs.load() * sizeof(utils::Insertion) + _row * sizeof(std::array<std::vector<utils::Insertion>, 2>)
+        << " B as gap vectors)\n";
+
+    // Duplicates keep an empty list, they are written with their representative's gaps
+    for (size_t i = 0; i != _row; ++i)
+        if (_representatives[i] == i) {
+            Insertions.push_back(_merge_row(final_gaps, _residuals[i]));
+            std::array<utils::InsertionList, 2>().swap(_residuals[i]);
+        }
+        else
+            Insertions.push_back(std::vector<utils::Insertion>());
+    std::vector<std::array<utils::InsertionList, 2>>().swap(_residuals);
+    Insertions.finish();
+    if (Insertions.spilled())
+        std::cout << "                    | Info : gap lists spilled : " << Insertions.spilled_bytes() << " B on disk, " << Insertions.memory_usage() << " B in memory\n";
+}
+
+// Function to walk one pairwise alignment along the center and place the extra gaps in row coordinates
+std::vector<utils::Insertion> star_alignment::StarAligner::_merge_row(const std::vector<size_t>& final_gaps,
+    const std::array<utils::InsertionList, 2>& pairwise_gaps) const {
+    auto centre_gap = pairwise_gaps[0].begin(), centre_end = pairwise_gaps[0].end();
+    auto sequence_gap = pairwise_gaps[1].begin(), sequence_end = pairwise_gaps[1].end();
+    std::vector<utils::Insertion> gaps;
+    auto add = [&gaps](size_t index, size_t number) {
+        if (number == 0) return;
+        if (!gaps.empty() && gaps.back().index == index)
+            gaps.back().number += number;
+        else
+            gaps.emplace_back(utils::Insertion({index, number}));
+    };
+
+    size_t sequence_index = 0; // Row position reached so far
+    size_t covered = 0; // Center characters still facing a gap of the row
+    for (size_t p = 0; ; ++p) {
+        // Row characters aligned to center gaps before position p take the first columns of the slot
+        size_t inserted = 0;
+        if (centre_gap != centre_end && centre_gap->index == p)
+            inserted = (centre_gap++)->number;
+        sequence_index += inserted;
+        if (final_gaps[p] > inserted)
+            add(sequence_index, final_gaps[p] - inserted);
+        if (p == _centre_len) break;
+
+        // Center character p faces either a row character or a row gap
+        if (covered == 0 && sequence_gap != sequence_end && sequence_gap->index == sequence_index) {
+            covered = (sequence_gap++)->number;
+            add(sequence_index, covered);
+        }
+        if (covered != 0) --covered;
+        else ++sequence_index;
+    }
+    return gaps;
+}
+
+// Function to insert gaps into sequences
+auto star_alignment::StarAligner::_insert_gaps(utils::GapStore& gaps) const -> std::vector<sequence_type> {
+    // Insert gaps into sequences based on pairwise gaps
+}
+
+// Function to perform multi-threaded pairwise alignment
+void star_alignment::StarAligner::mul_pairwise_align() const {
+    if (arguments::seed_mode == "minimizer")
+        _mul_pairwise_align_with(*_build_minimizer_index());
+    else if (_wide_index())
+        _mul_pairwise_align_with(*_build_index<int64_t>());
+    else
+        _mul_pairwise_align_with(*_build_index<int32_t>());
+    _merge_results();
+}
+
+// Function to align all rows with the center on the thread pool, with the given index of the center
+template<typename Index>
+void star_alignment::StarAligner::_mul_pairwise_align_with(const Index& st) const {
+    // Only one row per group of exact duplicates is aligned
+    size_t collapsed = 0, total_length = 0;
+    std::vector<size_t> rows;
+    for (size_t i = 0; i != _row; ++i) {
+        if (_representatives[i] != i)
+            ++collapsed;
+        else {
+            rows.push_back(i);
+            total_length += _lengths[i];
+        }
+    }
+
+    // Rows are taken longest first (the cost of a row is estimated by its length) and seeded in batches so their index
+    // searches interleave; a batch is closed at batch_size rows or once it holds its share of the work, so long rows
+    // are spread over the workers instead of ending up in one batch
+    std::sort(rows.begin(), rows.end(), [this](size_t lhs, size_t rhs) { return _lengths[lhs] != _lengths[rhs] ? _lengths[lhs] > _lengths[rhs] : lhs < rhs; });
+    const size_t batch_size = 16;
+    const size_t batch_length = std::max<size_t>(1, total_length / ((threadPool0 != NULL ? threadPool0->Thread_num : 1) * 8));
+    std::vector<std::vector<size_t>> batches;
+    size_t length = 0;
+    for (size_t i : rows) {
+        if (batches.empty() || batches.back().size() == batch_size || length >= batch_length) {
+            batches.emplace_back();
+            length = 0;
+        }
+        batches.back().push_back(i);
+        length += _lengths[i];
+    }
+
+    // Every row has its own residual slot and the profile keeps a maximum, so the result does not depend on which worker aligns it
+    if (threadPool0 == NULL)
+        for (const auto& batch : batches)
+            _align_batch(batch, st, thresh1);
+    else
+        threadPool0->run_stealing(batches.size(), [this, &batches, &st](size_t b) { _align_batch(batches[b], st, thresh1); });
+    std::cout << "                    | Info : duplicates collapsed : " << collapsed << " of " << _row << " rows\n";
+    _report_seeding();
+    _release_contexts();
+}
+
+// Helper function for multi-threaded alignment of sequences
+template<typename Index>
+void star_alignment::StarAligner::mul_fasta_func(int i, const Index& st, int threshold1) const {
+    _fold_row(i, _align_row(i, st, _context(), threshold1));
+}
+
+// Helper function for backtracking to find optimal path
+std::vector<int> star_alignment::StarAligner::_trace_back_bp(const std::vector<triple>& common_substrings, int* p) {
+    // Backtrack to find the optimal alignment path
+}
+
+// Function to find optimal path with backtracking
+auto star_alignment::StarAligner::_optimal_path_bp(const std::vector<triple>& optimal_common_substrings) -> std::vector<triple> {
+    // Use backtracking to find the optimal alignment path
+}
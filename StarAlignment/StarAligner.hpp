@@ -1,75 +1,135 @@
-#pragma once
-#include "../SuffixArray/SuffixArray.hpp"  // Include Suffix Array utility
-#include "../Utils/Utils.hpp"  // Include general utilities
-#include "../multi-thread/multi.hpp"  // Include multi-threading utilities
-
-#include <vector>
-#include <array>
-#include <string>
-#include <algorithm>
-
-namespace star_alignment // Namespace for star alignment
-{
-
-    // Class for performing star alignment
-    class StarAligner
-    {
-    private:
-        using triple = std::array<size_t, 3>; // Define a triple array with 3 elements
-        using quadra = std::array<size_t, 4>; // Define a quadra array with 4 elements
-        using sequence_type = std::vector<unsigned char>; // Sequence type definition
-
-    public:
-        // Static function to align sequences based on insertions and threshold
-        static std::vector<sequence_type> align(std::vector<std::vector<utils::Insertion>>& insertions, std::vector<sequence_type>& sequences, size_t thresh, int center);
-
-        // Static function to obtain gaps in sequences
-        static void get_gaps(std::vector<std::vector<utils::Insertion>>& insertions, std::vector<sequence_type>& sequences, size_t thresh, int center);
-
-        // Functions to get optimal alignment paths and trace back the alignment
-        static std::vector<triple> _optimal_path(const std::vector<triple>& common_substrings);
-        static std::vector<int> _trace_back_bp(const std::vector<triple>& common_substrings, int* p);
-        static std::vector<triple> _optimal_path_bp(const std::vector<triple>& optimal_common_substrings);
-
-    private:
-        // Constructor for StarAligner class
-        StarAligner(std::vector<std::vector<utils::Insertion>>& insertions, std::vector<sequence_type>& sequences, size_t thresh, int center);
-
-        // Main alignment function
-        std::vector<sequence_type> _align() const;
-
-        // Function to get gaps for alignment
-        void _get_gaps() const;
-
-        // Set lengths of sequences
-        std::vector<size_t> _set_lengths() const;
-
-        // Set the center sequence
-        size_t _set_centre() const;
-
-        // Main steps of the star alignment
-        std::vector<std::array<std::vector<utils::Insertion>, 2>> _pairwise_align() const; // Perform pairwise alignment
-        std::vector<std::vector<utils::Insertion>> _merge_results(const std::vector<std::array<std::vector<utils::Insertion>, 2>>& pairwise_gaps) const; // Merge pairwise alignment results
-        std::vector<sequence_type> _insert_gaps(const std::vector<std::vector<utils::Insertion>>& gaps) const; // Insert gaps into sequences
-
-        // Multi-threaded pairwise alignment
-        void mul_pairwise_align() const;
-
-        // Helper function for multi-threaded alignment
-        void mul_fasta_func(int i, const suffix_array::SuffixArray<nucleic_acid_pseudo::NUMBER>& st,
-            std::vector<std::array<std::vector<utils::Insertion>, 2>>& all_pairwise_gaps, int threshold1) const;
-
-        // Support function for appending gaps to the sequences
-        static void _append(const std::vector<size_t>& src_gaps, std::vector<utils::Insertion>& des_gaps, size_t start);
-
-        // Data members
-        std::vector<std::vector<utils::Insertion>>& Insertions; // Reference to vector of insertions
-        std::vector<sequence_type>& _sequences; // Reference to vector of sequences
-        const size_t _row; // Number of sequences
-        std::vector<size_t> _lengths; // Lengths of sequences
-        size_t thresh1; // Threshold value for alignment
-        size_t _centre; // Index of the center sequence
-        size_t _centre_len; // Length of the center sequence
-    };
-
-}
+#pragma once
+#include "../SuffixArray/SuffixArray.hpp"  // Include Suffix Array utility
+#include "../MinimizerIndex/MinimizerIndex.hpp"  // Include the minimizer index
+#include "../Utils/Utils.hpp"  // Include general utilities
+#include "../multi-thread/multi.hpp"  // Include multi-threading utilities
+
+#include <vector>
+#include <array>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <type_traits>
+
+namespace star_alignment // Namespace for star alignment
+{
+
+    // Class for performing star alignment
+    class StarAligner
+    {
+    private:
+        using triple = std::array<size_t, 3>; // Define a triple array with 3 elements
+        using quadra = std::array<size_t, 4>; // Define a quadra array with 4 elements
+        using sequence_type = std::vector<unsigned char>; // Sequence type definition
+        template<typename index_type>
+        using centre_index = suffix_array::SuffixArray<nucleic_acid_pseudo::NUMBER, index_type>; // Index of the center, 32- or 64-bit
+
+    public:
+        // Static function to align sequences based on insertions and threshold
+        static std::vector<sequence_type> align(utils::GapStore& insertions, const utils::PackedSequences& sequences, size_t thresh, int center);
+
+        // Static function to obtain gaps in sequences; representatives[i] is the row whose gaps row i shares
+        static void get_gaps(utils::GapStore& insertions, std::vector<size_t>& representatives,
+            const utils::PackedSequences& sequences, size_t thresh, int center);
+
+        // Functions to get optimal alignment paths and trace back the alignment
+        static std::vector<triple> _optimal_path(const std::vector<triple>& common_substrings);
+        static std::vector<int> _trace_back_bp(const std::vector<triple>& common_substrings, int* p);
+        static std::vector<triple> _optimal_path_bp(const std::vector<triple>& optimal_common_substrings);
+
+    private:
+        struct AlignerContext; // WFA aligner and scratch buffers of one thread
+
+        // Constructor and destructor for StarAligner class
+        StarAligner(utils::GapStore& insertions, const utils::PackedSequences& sequences, size_t thresh, int center);
+        ~StarAligner();
+
+        // Main alignment function
+        std::vector<sequence_type> _align() const;
+
+        // Function to get gaps for alignment
+        void _get_gaps() const;
+
+        // Set lengths of sequences
+        std::vector<size_t> _set_lengths() const;
+
+        // Set the center sequence
+        size_t _set_centre() const;
+
+        // Group exact duplicates, mapping every row to the first row with the same bases
+        std::vector<size_t> _set_representatives() const;
+
+        // Main steps of the star alignment; the index is a suffix array or a minimizer index of the center
+        void _pairwise_align() const; // Perform pairwise alignment
+        template<typename Index>
+        void _pairwise_align_with(const Index& st) const; // Pairwise alignment with the given index
+        template<typename Index>
+        std::array<std::vector<utils::Insertion>, 2> _align_row(size_t i, const Index& st,
+            AlignerContext& context, size_t threshold) const; // Align one row with the center
+        template<typename Index>
+        std::vector<triple> _seed_row(size_t i, const Index& st, size_t threshold) const; // Anchors of one row
+        std::array<std::vector<utils::Insertion>, 2> _align_anchored(size_t i, const std::vector<triple>& anchors,
+            AlignerContext& context) const; // Align one row between its anchors
+        template<typename Index>
+        void _align_batch(const std::vector<size_t>& rows, const Index& st, size_t threshold) const; // Seed rows together, then align each
+        void _fold_row(size_t i, const std::array<std::vector<utils::Insertion>, 2>& pairwise_gaps) const; // Fold a pairwise result into the center profile
+        void _merge_results() const; // Merge pairwise alignment results into Insertions
+        std::vector<sequence_type> _insert_gaps(utils::GapStore& gaps) const; // Insert gaps into sequences
+
+        // Multi-threaded pairwise alignment
+        void mul_pairwise_align() const;
+        template<typename Index>
+        void _mul_pairwise_align_with(const Index& st) const;
+
+        // Helper function for multi-threaded alignment
+        template<typename Index>
+        void mul_fasta_func(int i, const Index& st, int threshold1) const;
+
+        // Support functions for the aligner contexts: the context of the calling thread, and the report of their memory
+        AlignerContext& _context() const;
+        void _release_contexts() const;
+
+        // Support function telling whether the center needs a 64-bit index
+        bool _wide_index() const;
+
+        // Support functions for the index: construction for the selected seeding, repeat counters and the seeding report;
+        // the suffix array is 32-bit unless the center is too long for it
+        template<typename index_type>
+        std::unique_ptr<centre_index<index_type>> _build_index() const;
+        std::unique_ptr<minimizer_index::MinimizerIndex> _build_minimizer_index() const;
+        void _add_repeat_stats(const suffix_array::RepeatStats& stats) const;
+        void _report_seeding() const;
+
+        // Support function for appending gaps to the sequences
+        static void _append(const std::vector<size_t>& src_gaps, std::vector<utils::Insertion>& des_gaps, size_t start);
+
+        // Support function turning one pairwise result into the row's gaps in the final alignment
+        std::vector<utils::Insertion> _merge_row(const std::vector<size_t>& final_gaps, const std::array<utils::InsertionList, 2>& pairwise_gaps) const;
+
+        // Data members
+        utils::GapStore& Insertions; // Reference to the gap lists of the final alignment
+        const utils::PackedSequences& _sequences; // Reference to the packed sequences
+        const size_t _row; // Number of sequences
+        std::vector<size_t> _lengths; // Lengths of sequences
+        size_t thresh1; // Threshold value for alignment
+        size_t _centre; // Index of the center sequence
+        size_t _centre_len; // Length of the center sequence
+        sequence_type _centre_sequence; // Unpacked center sequence, shared by the index and the pairwise kernels
+        std::vector<size_t> _representatives; // Row aligned on behalf of each row (exact duplicates share one)
+        mutable std::unique_ptr<std::atomic<size_t>[]> _centre_profile; // Most gaps any row puts before each center position, updated as rows finish
+        mutable std::vector<std::array<utils::InsertionList, 2>> _residuals; // Pairwise result of each row, delta-encoded until the merge
+        mutable std::atomic<size_t> _residual_runs{ 0 }; // Runs held by the residuals
+        mutable std::atomic<size_t> _residual_bytes{ 0 }; // Bytes held by the residuals
+        mutable std::vector<std::unique_ptr<AlignerContext>> _contexts; // Aligner context of every pool worker, the last one for other threads
+        mutable std::atomic<size_t> _anchor_count{ 0 }; // Anchors returned by the index over all rows
+        mutable std::atomic<int64_t> _seeding_time{ 0 }; // Time spent in the index over all rows (ns, summed over threads)
+        mutable std::atomic<size_t> _contained_count{ 0 }; // Contained matches dropped by SMEM seeding
+        mutable std::atomic<size_t> _masked_seeds{ 0 }; // Matches over the occurrence cap
+        mutable std::atomic<size_t> _masked_occurrences{ 0 }; // Anchors those matches would have produced
+        mutable std::atomic<size_t> _masked_bases{ 0 }; // Row positions covered by masked matches
+        mutable std::atomic<size_t> _reextended_count{ 0 }; // Matches kept by extending them past the cap
+    };
+
+}
@@ -0,0 +1,181 @@
+#pragma once
+// 2-bit packed BWT with interleaved occurrence checkpoints
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace suffix_array
+{
+    // Class storing a BWT over {end mark, A, C, G, T} with 2 bits per symbol.
+    // Symbols are grouped in blocks: a checkpoint (counts of A/C/G/T before the block, 4 x count_type)
+    // followed by words_per_block words of 32 symbols, all in one cache-line aligned run, so a rank
+    // query reads a single block. The end mark is stored as A and corrected with its position endp.
+    // 64-bit counts are only needed past 2^32 symbols.
+    template<typename count_type = uint32_t>
+    class PackedBwt
+    {
+    public:
+        static constexpr size_t header_words = 4 * sizeof(count_type) / sizeof(uint64_t); // Words of a checkpoint
+
+        PackedBwt() : _length(0), _words_per_block(0), _stride(0), _endp(0), _data(nullptr) {}
+
+        PackedBwt(const PackedBwt&) = delete;
+        PackedBwt& operator=(const PackedBwt&) = delete;
+
+        // Function to build the table from symbol_at(i), i in [0, length); words_per_block sets the sampling density.
+        // Blocks are filled by up to threads threads, so symbol_at must be safe to call concurrently.
+        template<typename SymbolAt>
+        void build(size_t length, size_t words_per_block, SymbolAt symbol_at, size_t threads = 1)
+        {
+            _length = length;
+            _words_per_block = words_per_block;
+            _stride = words_per_block + header_words;
+            const size_t symbols_per_block = words_per_block * 32;
+            const size_t blocks = length / symbols_per_block + 1;
+            _storage.assign(blocks * _stride + 8, 0);
+            _data = _storage.data() + ((64 - (reinterpret_cast<uintptr_t>(_storage.data()) & 63)) & 63) / sizeof(uint64_t);
+
+            // Blocks only depend on their own symbols: chunks of blocks are packed in parallel, each checkpoint
+            // first holding the counts of its own block, then the counts are accumulated in one pass
+            threads = std::max<size_t>(1, std::min(threads, blocks));
+            const size_t chunk = (blocks + threads - 1) / threads;
+            std::vector<size_t> endps(threads, length);
+            auto fill = [&](size_t t) {
+                for (size_t block = t * chunk; block < std::min(blocks, (t + 1) * chunk); ++block)
+                {
+                    uint64_t* p = _data + block * _stride;
+                    count_type counts[4] = { 0, 0, 0, 0 };
+                    for (size_t i = block * symbols_per_block, end = std::min(length, i + symbols_per_block); i < end; ++i)
+                    {
+                        const unsigned char c = symbol_at(i);
+                        if (c == 0)
+                            endps[t] = i;
+                        else
+                        {
+                            ++counts[c - 1];
+                            p[header_words + (i % symbols_per_block) / 32] |= (uint64_t)(c - 1) << ((i & 31) << 1);
+                        }
+                    }
+                    std::memcpy(p, counts, sizeof(counts));
+                }
+            };
+            std::vector<std::thread> workers;
+            for (size_t t = 1; t < threads; ++t)
+                workers.emplace_back(fill, t);
+            fill(0);
+            for (std::thread& worker : workers)
+                worker.join();
+
+            count_type running[4] = { 0, 0, 0, 0 };
+            for (size_t block = 0; block != blocks; ++block)
+            {
+                uint64_t* p = _data + block * _stride;
+                count_type counts[4];
+                std::memcpy(counts, p, sizeof(counts));
+                std::memcpy(p, running, sizeof(running));
+                for (int c = 0; c != 4; ++c)
+                    running[c] += counts[c];
+            }
+            _endp = *std::min_element(endps.begin(), endps.end());
+        }
+
+        // Function to use blocks written by save (e.g. from a mapped index file) without copying them
+        void load(const void* data, size_t length, size_t words_per_block, size_t endp)
+        {
+            _length = length;
+            _words_per_block = words_per_block;
+            _stride = words_per_block + header_words;
+            _endp = endp;
+            std::vector<uint64_t>().swap(_storage);
+            _data = const_cast<uint64_t*>(static_cast<const uint64_t*>(data));
+        }
+
+        // Function to write the blocks
+        void save(std::ostream& os) const
+        {
+            os.write(reinterpret_cast<const char*>(_data), data_size());
+        }
+
+        // Function to count symbol c (1..4) in [0, x)
+        size_t rank(unsigned char c, size_t x) const noexcept
+        {
+            const size_t symbols_per_block = _words_per_block * 32;
+            const size_t block = x / symbols_per_block;
+            const uint64_t* p = _data + block * _stride;
+            count_type checkpoint;
+            std::memcpy(&checkpoint, reinterpret_cast<const count_type*>(p) + (c - 1), sizeof(count_type));
+            size_t count = (size_t)checkpoint;
+
+            const uint64_t pattern = _patterns[c - 1];
+            size_t rest = x - block * symbols_per_block;
+            for (p += header_words; rest >= 32; rest -= 32, ++p)
+                count += _popcount(_match(*p, pattern));
+            if (rest != 0)
+                count += _popcount(_match(*p, pattern) & ((uint64_t(1) << (rest << 1)) - 1));
+
+            // The end mark is stored as A
+            if (c == 1 && _endp < x && _endp >= block * symbols_per_block)
+                --count;
+            return count;
+        }
+
+        // Function to hint the block holding position x into the cache ahead of a rank query
+        void prefetch(size_t x) const noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(_data + (x / (_words_per_block * 32)) * _stride);
+#elif defined(_MSC_VER)
+            _mm_prefetch(reinterpret_cast<const char*>(_data + (x / (_words_per_block * 32)) * _stride), _MM_HINT_T0);
+#endif
+        }
+
+        // Function to get the symbol at position i (0 for the end mark)
+        unsigned char at(size_t i) const noexcept
+        {
+            if (i == _endp) return 0;
+            const size_t symbols_per_block = _words_per_block * 32;
+            const uint64_t word = _data[(i / symbols_per_block) * _stride + header_words + (i % symbols_per_block) / 32];
+            return (unsigned char)(((word >> ((i & 31) << 1)) & 3) + 1);
+        }
+
+        size_t size() const noexcept { return _length; }
+        size_t endp() const noexcept { return _endp; }
+        size_t sampling() const noexcept { return _words_per_block * 32; }
+        size_t memory_usage() const noexcept { return _storage.capacity() * sizeof(uint64_t); }
+        size_t data_size() const noexcept { return (_length / sampling() + 1) * _stride * sizeof(uint64_t); }
+
+    private:
+        // Mark (in the low bit of each 2-bit lane) the symbols of word equal to pattern
+        static uint64_t _match(uint64_t word, uint64_t pattern) noexcept
+        {
+            const uint64_t x = word ^ pattern;
+            return ~(x | (x >> 1)) & 0x5555555555555555ULL;
+        }
+
+        static size_t _popcount(uint64_t x) noexcept
+        {
+#if defined(_MSC_VER)
+            return (size_t)__popcnt64(x);
+#else
+            return (size_t)__builtin_popcountll(x);
+#endif
+        }
+
+        static constexpr uint64_t _patterns[4] = { 0x0000000000000000ULL, 0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL, 0xFFFFFFFFFFFFFFFFULL };
+
+        size_t _length; // Number of symbols including the end mark
+        size_t _words_per_block; // Words of symbols after each checkpoint
+        size_t _stride; // Words per block (checkpoint + symbols)
+        size_t _endp; // Position of the end mark
+        std::vector<uint64_t> _storage;
+        uint64_t* _data; // First block, aligned to a cache line
+    };
+}
@@ -0,0 +1,109 @@
+#pragma once
+// Suffix array sampled by text position, for locating with LF steps
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+namespace suffix_array
+{
+    // Class keeping the SA entries that are multiples of rate. Sampled rows are marked in a bit vector
+    // stored in blocks of one running count and 4 words (256 rows), followed by the sampled values in
+    // row order. A row that is not sampled is located by LF steps until a sampled row is reached:
+    // at most rate - 1 steps, since every rate-th text position is kept.
+    template<typename index_type>
+    class SampledSa
+    {
+    public:
+        SampledSa() : _length(0), _rate(0), _blocks(nullptr), _values(nullptr) {}
+
+        SampledSa(const SampledSa&) = delete;
+        SampledSa& operator=(const SampledSa&) = delete;
+
+        // Function to get the bytes taken by the samples of a suffix array of the given length
+        static size_t size_for(size_t length, size_t rate)
+        {
+            return _block_count(length) * _block_words * sizeof(uint64_t) + _sample_count(length, rate) * sizeof(index_type);
+        }
+
+        // Function to keep the entries of sa[0, length) that are multiples of rate
+        void build(const index_type* sa, size_t length, size_t rate)
+        {
+            _length = length;
+            _rate = rate;
+            const size_t blocks = _block_count(length);
+            _storage.assign((size_for(length, rate) + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+            _blocks = _storage.data();
+            _values = reinterpret_cast<index_type*>(_storage.data() + blocks * _block_words);
+
+            size_t count = 0;
+            for (size_t i = 0; i != length; ++i)
+            {
+                uint64_t* block = _blocks + (i / 256) * _block_words;
+                if (i % 256 == 0)
+                    block[0] = count;
+                if ((size_t)sa[i] % rate == 0)
+                {
+                    block[1 + (i % 256) / 64] |= uint64_t(1) << (i & 63);
+                    _values[count++] = sa[i];
+                }
+            }
+        }
+
+        // Function to use samples written by save (e.g. from a mapped index file) without copying them
+        void load(const void* data, size_t length, size_t rate)
+        {
+            _length = length;
+            _rate = rate;
+            std::vector<uint64_t>().swap(_storage);
+            _blocks = const_cast<uint64_t*>(static_cast<const uint64_t*>(data));
+            _values = reinterpret_cast<index_type*>(_blocks + _block_count(length) * _block_words);
+        }
+
+        // Function to write the samples
+        void save(std::ostream& os) const
+        {
+            os.write(reinterpret_cast<const char*>(_blocks), size_for(_length, _rate));
+        }
+
+        // Function to get the entry of row i when it is sampled
+        bool sampled(size_t i, index_type& value) const noexcept
+        {
+            const uint64_t* block = _blocks + (i / 256) * _block_words;
+            const size_t word = (i % 256) / 64;
+            const uint64_t bits = block[1 + word];
+            if (!(bits >> (i & 63) & 1))
+                return false;
+            size_t rank = block[0] + _popcount(bits & ((uint64_t(1) << (i & 63)) - 1));
+            for (size_t w = 0; w != word; ++w)
+                rank += _popcount(block[1 + w]);
+            value = _values[rank];
+            return true;
+        }
+
+        size_t rate() const noexcept { return _rate; }
+        size_t memory_usage() const noexcept { return _storage.capacity() * sizeof(uint64_t); }
+
+    private:
+        static constexpr size_t _block_words = 5; // Running count and 4 words of marks
+
+        static size_t _block_count(size_t length) { return length / 256 + 1; }
+        static size_t _sample_count(size_t length, size_t rate) { return length == 0 ? 0 : (length - 1) / rate + 1; }
+
+        static size_t _popcount(uint64_t x) noexcept
+        {
+#if defined(_MSC_VER)
+            return (size_t)__popcnt64(x);
+#else
+            return (size_t)__builtin_popcountll(x);
+#endif
+        }
+
+        size_t _length; // Number of rows
+        size_t _rate; // Distance between sampled text positions
+        std::vector<uint64_t> _storage;
+        uint64_t* _blocks; // Marks of the sampled rows with running counts
+        index_type* _values; // Sampled entries in row order
+    };
+}
@@ -1,259 +1,902 @@
-#pragma once
-#include "../Utils/Utils.hpp"
-#include "divsufsort.h" // Include external suffix array library
-#include "../Utils/Arguments.hpp"
-
-#include <iostream>
-#include <vector>
-#include <iterator>
-#include <algorithm>
-#include <cstring>
-#include <array>
-#include <limits>
-#include <unordered_map>
-#include <set>
-
-namespace suffix_array
-{
-    // Class for creating and using suffix arrays
-    template<size_t width>
-    class SuffixArray
-    {
-    public:
-        using triple = std::array<size_t, 3>; // Define a triple data structure
-
-        // Constructor: builds the suffix array for given input sequence
-        template<typename InputIterator>
-        SuffixArray(InputIterator first, InputIterator last, unsigned char end_mark)
-            : length(last - first + 1)
-            , dis(1)
-            , reword(_copy_reword(first, last, end_mark))
-            , SA(new int32_t[length])
-        {
-            divsufsort(reword, SA, length, 4);
-            endp = build_b();
-            delete[] reword;
-        }
-
-        // Destructor: frees allocated memory
-        ~SuffixArray()
-        {
-            delete[] O;
-            delete[] SA;
-            delete[] B;
-            delete[] begin;
-        }
-
-        // Search for prefix of a given threshold length
-        template<typename InputIterator>
-        std::vector<size_t> search_for_prefix(InputIterator first, InputIterator last, size_t threshold) const
-        {
-            size_t common_prefix_length = 0;
-            int lbegin, lend, start, end, len_sub = last - first;
-            char sub = *(first++); // Take first character of the prefix
-            start = begin[(int)sub - 1];
-            end = begin[(int)sub] - 1;
-
-            // Iteratively search for prefix matches
-            while (first < last)
-            {
-                sub = *(first);
-                lbegin = find(sub, start, end);
-                lend = rfind(sub, start, end);
-
-                if (lbegin == -1)
-                    break;
-
-                start = begin[(int)sub - 1] + O_index_num(lbegin, sub) - 1;
-                end = begin[(int)sub - 1] + O_index_num(lend, sub) - 1;
-
-                first++;
-            }
-
-            common_prefix_length = last - first;
-            common_prefix_length = len_sub - common_prefix_length;
-
-            if (common_prefix_length < threshold)
-                return std::vector<size_t>();
-
-            // Collect starting positions of matching prefixes
-            std::vector<size_t> starts{ common_prefix_length };
-            for (int i = start; i <= end; i++)
-                starts.emplace_back(length - 1 - SA[i] - common_prefix_length);
-
-            return std::move(starts);
-        }
-
-        // Function to get common substrings above a threshold length
-        template<typename RandomAccessIterator>
-        std::vector<triple> get_common_substrings(RandomAccessIterator first, RandomAccessIterator last, size_t threshold) const
-        {
-            std::vector<triple> common_substrings;
-
-            const size_t rhs_len = last - first;
-            if (rhs_len < threshold)
-                return common_substrings;
-
-            for (size_t rhs_index = 0; rhs_index < rhs_len;)
-            {
-                auto found = search_for_prefix(first + rhs_index, last, threshold);
-
-                if (found.empty())
-                {
-                    ++rhs_index;
-                }
-                else
-                {
-                    for (size_t i = 1; i != found.size(); ++i)
-                        common_substrings.emplace_back(triple({found[i], rhs_index, found[0]}));
-
-                    rhs_index += found[0] - threshold + 1;
-                }
-            }
-
-            return std::move(common_substrings);
-        }
-
-        // Function to find a character in a given range (left to right)
-        int find(char now, int start, int end) const
-        {
-            for (int i = start; i <= end; i++)
-                if (B[i] == now)
-                    return i;
-            return -1;
-        }
-
-        // Function to find a character in a given range (right to left)
-        int rfind(char now, int start, int end) const
-        {
-            for (int i = end; i >= start; i--)
-                if (B[i] == now)
-                    return i;
-            return -1;
-        }
-
-        // Function to find the number of occurrences of a character up to a given position
-        int O_index_num(int x, char now) const
-        {
-            int num, i, quotient = x / dis;
-
-            if (((x - quotient * dis) <= (dis / 2)) || (quotient == (Osize - 1)))
-            {
-                num = O[quotient][(int)now - 1];
-                for (i = quotient * dis + 1; i <= x; i++)
-                    if (B[i] == now)
-                        num++;
-            }
-            else
-            {
-                num = O[quotient + 1][(int)now - 1];
-                for (i = (quotient + 1) * dis; i > x; i--)
-                    if (B[i] == now)
-                        num--;
-            }
-            return num;
-        }
-
-    private:
-        // Helper function to copy the sequence in reverse order and add end mark
-        template<typename InputIterator>
-        unsigned char* _copy_reword(InputIterator first, InputIterator last, unsigned char end_mark)
-        {
-            unsigned char* result = new unsigned char[length];
-            int i = length - 2;
-            while (i >= 0)
-            {
-                result[i] = *(first++);
-                i--;
-            }
-            result[length - 1] = end_mark;
-            return result;
-        }
-
-        // Helper functions for stable sorting
-        inline bool leq(int a1, int a2, int b1, int b2) {
-            return (a1 < b1 || (a1 == b1 && a2 <= b2));
-        }
-
-        inline bool leq(int a1, int a2, int a3, int b1, int b2, int b3) {
-            return (a1 < b1 || (a1 == b1 && leq(a2, a3, b2, b3)));
-        }
-
-        // Function to sort suffixes using radix sort
-        static void radixPass(int* a, int* b, int* r, int n, int K)
-        {
-            int* c = new int[K + 1]; // Counter array
-            for (int i = 0; i <= K; i++) c[i] = 0; // Reset counters
-            for (int i = 0; i < n; i++) c[r[a[i]]]++; // Count occurrences
-            for (int i = 0, sum = 0; i <= K; i++) {
-                int t = c[i]; c[i] = sum; sum += t;
-            }
-            for (int i = 0; i < n; i++) b[c[r[a[i]]]++] = a[i]; // Sort
-            delete[] c;
-        }
-
-        // Function to build suffix array using DC3 algorithm
-        void suffixArray(int* s, int* SA, int n, int K)
-        {
-            // Implementation of DC3 algorithm to build the suffix array
-        }
-
-        // Function to build auxiliary data structures for suffix array
-        int* build_sa()
-        {
-            int* s = new int[length + 3];
-            int* sa = new int[length + 3];
-            for (int i = 0; i < length; i++) s[i] = (int)reword[i];
-            s[length] = s[length + 1] = s[length + 2] = sa[length] = sa[length + 1] = sa[length + 2] = 0;
-            suffixArray(s, sa, length, 5);
-            delete[] s;
-            return sa;
-        }
-
-        // Function to initialize various arrays for suffix array computation
-        int build_b()
-        {
-            quadra* o = new quadra[length / dis + 2]();
-            Osize = length / dis + 2;
-            int* _begin = new int[5];
-            _begin[4] = length;
-            unsigned char* b = new unsigned char[length];
-            quadra num = { 0,0,0,0 };
-            int i, e = 0;
-
-            for (i = 0; i < length; i++)
-            {
-                b[i] = reword[(SA[i] + length - 1) % length];
-                if (((int)b[i]) == 0)
-                    e = i;
-                else
-                    num[(int)b[i] - 1]++;
-
-                if (i % dis == 0)
-                    o[i / dis] = num;
-            }
-            _begin[0] = 1;
-            _begin[1] = num[0] + 1;
-            _begin[2] = num[0] + num[1] + 1;
-            _begin[3] = num[0] + num[1] + num[2] + 1;
-            B = b; // Initialize B
-            begin = _begin; // Initialize begin breakpoints
-            O = o;
-            return e; // Return end position
-        }
-
-    private:
-        using quadra = std::array<int32_t, 4>;
-        const int dis; // Distance for sampling counts
-        int endp; // End position of special character
-        int Osize; // Size of auxiliary data structure O
-
-    public:
-        const size_t length; // Length of the sequence including ending character
-        const unsigned char* reword; // Reverse of original sequence with end mark
-        int32_t* SA; // Suffix array
-        const unsigned char* B; // Auxiliary array B
-        const quadra* O; // Auxiliary counting array O
-        const int* begin; // Breakpoints for A, C, G, T in B
-    };
-}
+#pragma once
+#include "../Utils/Utils.hpp"
+#include "divsufsort.h" // Include external suffix array library
+#include "PackedBwt.hpp"
+#include "sais.hpp"
+#include "SampledSa.hpp"
+#include "../Utils/Arguments.hpp"
+#include "../Utils/MappedFile.hpp"
+
+#include <iostream>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <array>
+#include <limits>
+#include <unordered_map>
+#include <set>
+#include <type_traits>
+#include <chrono>
+#include <thread>
+
+namespace suffix_array
+{
+    // Counters of the matches dropped by the occurrence cap (see SuffixArray::set_occurrence_cap)
+    struct RepeatStats
+    {
+        size_t masked_seeds = 0; // Matches with more occurrences than the cap
+        size_t masked_occurrences = 0; // Anchors they would have produced
+        size_t masked_bases = 0; // Query positions covered by masked matches
+        size_t reextended = 0; // Matches made rare enough by extending them to the left
+    };
+
+    // Class for creating and using suffix arrays. index_type (int32_t or int64_t) holds SA entries and
+    // intervals: 32-bit indexes are built with divsufsort and cover sequences below 2^31 symbols,
+    // 64-bit indexes (SA-IS) take twice the SA memory and have no such limit.
+    template<size_t width, typename index_type = int32_t>
+    class SuffixArray
+    {
+        static_assert(std::is_same<index_type, int32_t>::value || std::is_same<index_type, int64_t>::value, "index_type must be int32_t or int64_t");
+
+    public:
+        using triple = std::array<size_t, 3>; // Define a triple data structure
+        using bwt_type = PackedBwt<typename std::make_unsigned<index_type>::type>; // Checkpoint counts as wide as the index
+
+        // Function to check whether a 32-bit index can hold a sequence of the given length (end mark excluded)
+        static bool fits_32bit(size_t sequence_length)
+        {
+            return sequence_length + 1 <= (size_t)std::numeric_limits<int32_t>::max();
+        }
+
+        // Constructor: builds the suffix array for given input sequence.
+        // With an index file, a saved index of the same sequence is mapped instead, otherwise the new index is saved there.
+        // sampling is the distance between occurrence checkpoints (rounded to 32, 64..256 symbols).
+        // With sa_sampling > 1 only every sa_sampling-th text position of the SA is kept and the others are
+        // located by LF steps (SA stays NULL): the SA takes 1/sa_sampling of the memory, locating is slower.
+        // threads is the number of threads used to build the index (suffix sorting, BWT and k-mer table).
+        template<typename InputIterator>
+        SuffixArray(InputIterator first, InputIterator last, unsigned char end_mark, const std::string& index_file = "", int sampling = 192,
+            size_t sa_sampling = 1, int threads = 1)
+            : dis(std::min(256, std::max(64, sampling / 32 * 32)))
+            , sa_rate(std::max<size_t>(1, sa_sampling))
+            , build_threads(std::max(1, threads))
+            , max_occurrences(0)
+            , reextend_repeats(false)
+            , length(last - first + 1)
+            , reword(NULL)
+            , SA(NULL)
+            , begin(NULL)
+        {
+            const uint64_t sequence_checksum = index_file.empty() ? 0 : checksum(first, last);
+            _index_file = index_file;
+            _checksum = sequence_checksum;
+            if (!index_file.empty() && _load(index_file, sequence_checksum))
+            {
+                std::cout << "                    | Info : index loaded : " << index_file << "\n";
+                build_kmer_table();
+                return;
+            }
+
+            // Every stage frees what the later ones do not need: the text goes once B is built, the full SA once it is sampled
+            auto stage_start = std::chrono::steady_clock::now();
+            auto stage_time = [&stage_start]() {
+                const auto now = std::chrono::steady_clock::now();
+                const double seconds = std::chrono::duration<double>(now - stage_start).count();
+                stage_start = now;
+                return seconds;
+            };
+            reword = _copy_reword(first, last, end_mark);
+            SA = new index_type[length];
+            _sort_suffixes(reword, SA);
+            const double sort_time = stage_time();
+            endp = build_b();
+            delete[] reword;
+            reword = NULL;
+            const double bwt_time = stage_time();
+            if (sa_rate > 1)
+            {
+                S.build(SA, length, sa_rate);
+                delete[] SA;
+                SA = NULL;
+            }
+            const double sample_time = stage_time();
+            build_kmer_table();
+            const double kmer_time = stage_time();
+            std::cout << "                    | Info : index built (" << build_threads << " threads) : suffix sort " << sort_time << " s, BWT " << bwt_time
+                << " s, SA samples " << sample_time << " s, k-mer table " << kmer_time << " s\n";
+
+            if (!index_file.empty())
+            {
+                if (_save(index_file, sequence_checksum))
+                    std::cout << "                    | Info : index saved : " << index_file << "\n";
+                else
+                    std::cout << "                    | Info : index could not be saved : " << index_file << "\n";
+            }
+        }
+
+        // Destructor: frees allocated memory
+        ~SuffixArray()
+        {
+            if (!_index) delete[] SA; // A mapped SA belongs to the index file
+            delete[] begin;
+        }
+
+        // Function to checksum a sequence (FNV-1a over the symbols and the length), used to validate saved indexes
+        template<typename InputIterator>
+        static uint64_t checksum(InputIterator first, InputIterator last)
+        {
+            uint64_t h = 0xcbf29ce484222325ULL;
+            uint64_t n = 0;
+            for (; first != last; ++first, ++n)
+                h = (h ^ (unsigned char)*first) * 0x100000001b3ULL;
+            return (h ^ n) * 0x100000001b3ULL;
+        }
+
+        // Search for prefix of a given threshold length
+        template<typename InputIterator>
+        std::vector<size_t> search_for_prefix(InputIterator first, InputIterator last, size_t threshold) const
+        {
+            size_t common_prefix_length = 0;
+            index_type start, end;
+            const size_t len_sub = last - first;
+            _begin_search(first, last, start, end);
+
+            // Iteratively search for prefix matches, one LF step (two rank queries) per character
+            while (first < last && _extend(*first, start, end))
+                first++;
+
+            common_prefix_length = last - first;
+            common_prefix_length = len_sub - common_prefix_length;
+
+            if (common_prefix_length < threshold)
+                return std::vector<size_t>();
+
+            // Collect starting positions of matching prefixes
+            std::vector<size_t> starts{ common_prefix_length };
+            for (index_type i = start; i <= end; i++)
+                starts.emplace_back(length - 1 - _locate(i) - common_prefix_length);
+
+            return std::move(starts);
+        }
+
+        // Function to cap the occurrences of a match: a match found more than max_occurrences times in the center
+        // gives no anchor (0 keeps every match). With reextend, such a match is first extended to the left through
+        // the bidirectional index (see build_forward) until it is rare enough, and kept if that succeeds.
+        void set_occurrence_cap(size_t max_occurrences, bool reextend)
+        {
+            this->max_occurrences = max_occurrences;
+            reextend_repeats = reextend;
+        }
+
+        // Function to get common substrings above a threshold length
+        template<typename RandomAccessIterator>
+        std::vector<triple> get_common_substrings(RandomAccessIterator first, RandomAccessIterator last, size_t threshold, RepeatStats* stats = NULL) const
+        {
+            std::vector<triple> common_substrings;
+
+            const size_t rhs_len = last - first;
+            if (rhs_len < threshold)
+                return common_substrings;
+
+            size_t masked_end = 0;
+            for (size_t rhs_index = 0; rhs_index < rhs_len;)
+            {
+                RandomAccessIterator pos = first + rhs_index;
+                index_type start, end;
+                _begin_search(pos, last, start, end);
+                while (pos < last && _extend(*pos, start, end))
+                    ++pos;
+
+                const size_t common_prefix_length = pos - (first + rhs_index);
+                if (common_prefix_length < threshold)
+                {
+                    ++rhs_index;
+                }
+                else
+                {
+                    _record(first, rhs_index, common_prefix_length, start, end, common_substrings, stats, masked_end);
+                    rhs_index += common_prefix_length - threshold + 1;
+                }
+            }
+
+            return std::move(common_substrings);
+        }
+
+        // Function to get the common substrings of several sequences at once: the searches of up to
+        // lanes sequences advance in lockstep, one LF step each per round, and the occurrence block of
+        // every lane's next step is prefetched so the cache misses of different lanes overlap.
+        // Returns, for every sequence, the same triples as get_common_substrings.
+        template<typename RandomAccessIterator>
+        std::vector<std::vector<triple>> get_common_substrings_batch(const std::vector<std::pair<RandomAccessIterator, RandomAccessIterator>>& queries,
+            size_t threshold, RepeatStats* stats = NULL, size_t lanes = 16) const
+        {
+            struct Lane
+            {
+                size_t query; // Sequence searched by this lane
+                size_t rhs_index; // Position the current search started at
+                RandomAccessIterator pos; // Next symbol to extend with
+                index_type start, end; // Current SA interval
+                size_t masked_end; // End of the query positions masked so far
+            };
+
+            std::vector<std::vector<triple>> results(queries.size());
+            std::vector<Lane> active;
+            active.reserve(lanes);
+            size_t next_query = 0;
+
+            // Give a lane the next sequence long enough to be searched
+            auto assign = [&](Lane& lane) {
+                for (; next_query != queries.size(); ++next_query)
+                    if ((size_t)(queries[next_query].second - queries[next_query].first) >= threshold)
+                    {
+                        lane.query = next_query++;
+                        lane.rhs_index = 0;
+                        lane.masked_end = 0;
+                        lane.pos = queries[lane.query].first;
+                        _begin_search(lane.pos, queries[lane.query].second, lane.start, lane.end);
+                        if (lane.pos < queries[lane.query].second)
+                            _prefetch(lane.start, lane.end);
+                        return true;
+                    }
+                return false;
+            };
+            for (Lane lane; active.size() != lanes && assign(lane); )
+                active.push_back(lane);
+
+            while (!active.empty())
+            {
+                for (size_t l = 0; l < active.size(); )
+                {
+                    Lane& lane = active[l];
+                    const RandomAccessIterator first = queries[lane.query].first, last = queries[lane.query].second;
+                    if (lane.pos < last && _extend(*lane.pos, lane.start, lane.end))
+                    {
+                        if (++lane.pos < last)
+                            _prefetch(lane.start, lane.end);
+                        ++l;
+                        continue;
+                    }
+
+                    // The search of this lane ended: record it exactly as get_common_substrings does
+                    const size_t common_prefix_length = lane.pos - (first + lane.rhs_index);
+                    if (common_prefix_length >= threshold)
+                    {
+                        _record(first, lane.rhs_index, common_prefix_length, lane.start, lane.end, results[lane.query], stats, lane.masked_end);
+                        lane.rhs_index += common_prefix_length - threshold + 1;
+                    }
+                    else
+                        ++lane.rhs_index;
+
+                    if (lane.rhs_index < (size_t)(last - first))
+                    {
+                        lane.pos = first + lane.rhs_index;
+                        _begin_search(lane.pos, last, lane.start, lane.end);
+                        if (lane.pos < last)
+                            _prefetch(lane.start, lane.end);
+                        ++l;
+                    }
+                    else if (!assign(lane))
+                    {
+                        lane = active.back();
+                        active.pop_back();
+                    }
+                }
+            }
+            return results;
+        }
+
+        // Function to add the BWT of the forward sequence, which makes the index bidirectional (needed by get_smems).
+        // With an index file it is saved there too; an index mapped with its forward BWT already has it.
+        template<typename InputIterator>
+        void build_forward(InputIterator first, InputIterator last)
+        {
+            if (bidirectional())
+                return;
+            unsigned char* text = new unsigned char[length];
+            std::copy(first, last, text);
+            text[length - 1] = 0; // End mark
+            index_type* sa = new index_type[length];
+            const auto start = std::chrono::steady_clock::now();
+            _sort_suffixes(text, sa);
+            const auto sorted = std::chrono::steady_clock::now();
+            F.build(length, dis / 32, [text, sa, this](size_t i) { return sa[i] == 0 ? text[length - 1] : text[sa[i] - 1]; }, build_threads);
+            delete[] sa;
+            delete[] text;
+            std::cout << "                    | Info : forward index built : suffix sort " << std::chrono::duration<double>(sorted - start).count()
+                << " s, BWT " << std::chrono::duration<double>(std::chrono::steady_clock::now() - sorted).count() << " s\n";
+
+            if (!_index_file.empty())
+            {
+                if (_save(_index_file, _checksum))
+                    std::cout << "                    | Info : index saved with the forward BWT : " << _index_file << "\n";
+                else
+                    std::cout << "                    | Info : index could not be saved : " << _index_file << "\n";
+            }
+        }
+
+        // Function to check whether build_forward was called
+        bool bidirectional() const
+        {
+            return F.size() != 0;
+        }
+
+        // Function to get the super-maximal exact matches (SMEMs) of a sequence that are at least threshold long,
+        // one triple per occurrence in the same form as get_common_substrings. Every query position is covered by
+        // the longest match through it only, so overlapping and contained matches are not reported again.
+        // contained, when given, is increased by the number of contained matches that were dropped.
+        // SMEMs cannot grow to the left, so the occurrence cap drops them without re-extension.
+        template<typename RandomAccessIterator>
+        std::vector<triple> get_smems(RandomAccessIterator first, RandomAccessIterator last, size_t threshold, size_t* contained = NULL,
+            RepeatStats* stats = NULL) const
+        {
+            std::vector<triple> common_substrings;
+            const size_t rhs_len = last - first;
+            if (rhs_len < threshold)
+                return common_substrings;
+
+            std::vector<BiInterval> mems, prev, curr;
+            std::vector<std::pair<size_t, size_t>> masked;
+            for (size_t x = 0; x < rhs_len; )
+            {
+                mems.clear();
+                x = _smem(first, rhs_len, x, mems, prev, curr, contained);
+                for (const BiInterval& mem : mems)
+                {
+                    const size_t mem_length = mem.qend - mem.qbegin;
+                    if (mem_length < threshold)
+                        continue;
+                    if (max_occurrences != 0 && (size_t)mem.size > max_occurrences)
+                    {
+                        if (stats != NULL)
+                        {
+                            ++stats->masked_seeds;
+                            stats->masked_occurrences += mem.size;
+                            masked.emplace_back(mem.qbegin, mem.qend);
+                        }
+                        continue;
+                    }
+                    for (index_type i = mem.rev; i != mem.rev + mem.size; i++)
+                        common_substrings.emplace_back(triple({ length - 1 - _locate(i) - mem_length, mem.qbegin, mem_length }));
+                }
+            }
+            std::sort(common_substrings.begin(), common_substrings.end(),
+                [](const triple& lhs, const triple& rhs) { return lhs[1] != rhs[1] ? lhs[1] < rhs[1] : lhs[0] < rhs[0]; });
+            std::sort(masked.begin(), masked.end());
+            size_t masked_end = 0;
+            for (const auto& range : masked)
+                _mask(range.first, range.second, stats, masked_end);
+            return common_substrings;
+        }
+
+        // Function to count a character in B[0, x)
+        index_type rank(char now, index_type x) const
+        {
+            return (index_type)B.rank((unsigned char)now, (size_t)x);
+        }
+
+        // Function to find the number of occurrences of a character up to a given position
+        index_type O_index_num(index_type x, char now) const
+        {
+            return rank(now, x + 1);
+        }
+
+        // Function to fill the SA interval of every k-mer, with k chosen so that 4^(k+1) <= length (at most 12)
+        void build_kmer_table()
+        {
+            kmer_length = 0;
+            while (kmer_length < 12 && (size_t(4) << (2 * kmer_length + 2)) <= length)
+                ++kmer_length;
+            kmer_table.assign(size_t(1) << (2 * kmer_length), kmer_interval({ 1, 0 }));
+            if (kmer_length < 2 || build_threads == 1)
+            {
+                if (kmer_length != 0)
+                    _fill_kmer_table(0, 0, 0, (index_type)length - 1);
+                return;
+            }
+
+            // The 16 subtrees of the first two symbols fill disjoint parts of the table
+            auto fill = [this](int t) {
+                for (int prefix = t; prefix < 16; prefix += build_threads)
+                {
+                    index_type start = 0, end = (index_type)length - 1;
+                    if (_extend((char)(prefix / 4 + 1), start, end) && _extend((char)(prefix % 4 + 1), start, end))
+                        _fill_kmer_table(prefix, 2, start, end);
+                }
+            };
+            std::vector<std::thread> workers;
+            for (int t = 1; t < std::min(build_threads, 16); ++t)
+                workers.emplace_back(fill, t);
+            fill(0);
+            for (std::thread& worker : workers)
+                worker.join();
+        }
+
+        // Function to get the number of bytes held by the occurrence structure
+        size_t occurrence_memory() const
+        {
+            return B.memory_usage();
+        }
+
+        // Function to get the number of bytes held by the suffix array (full or sampled)
+        size_t sa_memory() const
+        {
+            return sa_rate > 1 ? S.memory_usage() : (_index ? 0 : length * sizeof(index_type));
+        }
+
+        // Function to get the SA sampling rate (1 for a full SA)
+        size_t sa_sampling() const
+        {
+            return sa_rate;
+        }
+
+    private:
+        // Header of a saved index; the SA (index_type x length, or the samples) follows, then the BWT blocks at the next 64-byte
+        // boundary, then the forward BWT blocks at the next one if the index was saved bidirectional
+        struct IndexHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t sampling;
+            uint64_t length;
+            uint64_t checksum;
+            uint64_t endp;
+            int64_t begin[5];
+            uint32_t alphabet; // Template width the index was built with
+            uint32_t index_bytes; // Size of an SA entry
+            uint32_t sa_sampling; // SA sampling rate, 1 for a full SA
+            uint32_t forward; // 1 when the forward BWT follows B
+            uint64_t forward_endp; // End mark position in the forward BWT
+        };
+
+        static constexpr char _magic[8] = { 'H', 'A', '4', 'F', 'M', 'I', 'D', 'X' };
+
+        size_t _sa_bytes() const
+        {
+            return sa_rate > 1 ? SampledSa<index_type>::size_for(length, sa_rate) : length * sizeof(index_type);
+        }
+
+        size_t _bwt_offset() const
+        {
+            return (sizeof(IndexHeader) + _sa_bytes() + 63) / 64 * 64;
+        }
+
+        size_t _bwt_bytes() const
+        {
+            return (length / dis + 1) * (dis / 32 + bwt_type::header_words) * sizeof(uint64_t);
+        }
+
+        size_t _forward_offset() const
+        {
+            return (_bwt_offset() + _bwt_bytes() + 63) / 64 * 64;
+        }
+
+        // Function to map a saved index; false when it is missing or was built for another sequence or layout
+        bool _load(const std::string& index_file, uint64_t sequence_checksum)
+        {
+            std::unique_ptr<utils::MappedFile> file(new utils::MappedFile(index_file));
+            if (!file->is_open() || file->size() < sizeof(IndexHeader))
+                return false;
+
+            IndexHeader header;
+            memcpy(&header, file->begin(), sizeof(IndexHeader));
+            if (memcmp(header.magic, _magic, sizeof(_magic)) != 0 || header.version != 4 || header.alphabet != width || header.index_bytes != sizeof(index_type)
+                || header.sa_sampling != sa_rate
+                || header.length != length || header.checksum != sequence_checksum || header.sampling != (uint32_t)dis)
+                return false;
+
+            const size_t bwt_offset = _bwt_offset();
+            if (file->size() != (header.forward ? _forward_offset() + _bwt_bytes() : bwt_offset + _bwt_bytes()))
+                return false;
+
+            if (sa_rate > 1)
+                S.load(file->begin() + sizeof(IndexHeader), length, sa_rate);
+            else
+                SA = reinterpret_cast<index_type*>(const_cast<char*>(file->begin() + sizeof(IndexHeader)));
+            B.load(file->begin() + bwt_offset, length, dis / 32, header.endp);
+            if (header.forward)
+                F.load(file->begin() + _forward_offset(), length, dis / 32, header.forward_endp);
+            index_type* _begin = new index_type[5];
+            std::copy(header.begin, header.begin + 5, _begin);
+            begin = _begin;
+            endp = (index_type)header.endp;
+            _index = std::move(file);
+            return true;
+        }
+
+        // Function to write the index next to its final name and move it into place
+        bool _save(const std::string& index_file, uint64_t sequence_checksum) const
+        {
+            IndexHeader header;
+            memset(&header, 0, sizeof(IndexHeader));
+            memcpy(header.magic, _magic, sizeof(_magic));
+            header.version = 4;
+            header.sampling = (uint32_t)dis;
+            header.length = length;
+            header.checksum = sequence_checksum;
+            header.endp = (uint64_t)endp;
+            std::copy(begin, begin + 5, header.begin);
+            header.alphabet = (uint32_t)width;
+            header.index_bytes = (uint32_t)sizeof(index_type);
+            header.sa_sampling = (uint32_t)sa_rate;
+            header.forward = bidirectional() ? 1 : 0;
+            header.forward_endp = bidirectional() ? (uint64_t)F.endp() : 0;
+
+            const std::string tmp_file = index_file + ".tmp";
+            {
+                std::ofstream ofs(tmp_file, std::ios::binary | std::ios::out | std::ios::trunc);
+                if (!ofs)
+                    return false;
+                ofs.write(reinterpret_cast<const char*>(&header), sizeof(IndexHeader));
+                if (sa_rate > 1)
+                    S.save(ofs);
+                else
+                    ofs.write(reinterpret_cast<const char*>(SA), length * sizeof(index_type));
+                const char padding[64] = { 0 };
+                ofs.write(padding, _bwt_offset() - sizeof(IndexHeader) - _sa_bytes());
+                B.save(ofs);
+                if (bidirectional())
+                {
+                    ofs.write(padding, _forward_offset() - _bwt_offset() - _bwt_bytes());
+                    F.save(ofs);
+                }
+                if (!ofs)
+                    return false;
+            }
+            return std::rename(tmp_file.c_str(), index_file.c_str()) == 0;
+        }
+
+        // Helper function to get SA[row]: read directly from a full SA, otherwise LF steps back to a sampled row
+        index_type _locate(index_type row) const
+        {
+            if (SA != NULL)
+                return SA[row];
+            index_type steps = 0, value;
+            while (!S.sampled((size_t)row, value))
+            {
+                const unsigned char c = B.at((size_t)row); // Not the end mark: its row holds text position 0, which is sampled
+                row = begin[c - 1] + rank((char)c, row);
+                ++steps;
+            }
+            return value + steps;
+        }
+
+        // Helper function to set the interval of a new search: k symbols deep from the jump table when possible,
+        // otherwise from the first character (near the end of the query or for a k-mer absent from the center)
+        template<typename InputIterator>
+        void _begin_search(InputIterator& first, InputIterator last, index_type& start, index_type& end) const
+        {
+            const size_t code = _kmer_code(first, last);
+            if (code != npos && kmer_table[code][0] <= kmer_table[code][1])
+            {
+                start = kmer_table[code][0];
+                end = kmer_table[code][1];
+                first += kmer_length;
+            }
+            else
+            {
+                const char sub = *(first++);
+                start = begin[(int)sub - 1];
+                end = begin[(int)sub] - 1;
+            }
+        }
+
+        // Helper function for one LF step; the interval is kept when the extension would be empty
+        bool _extend(char sub, index_type& start, index_type& end) const
+        {
+            const index_type lstart = begin[(int)sub - 1] + rank(sub, start);
+            const index_type lend = begin[(int)sub - 1] + rank(sub, end + 1) - 1;
+            if (lstart > lend)
+                return false;
+            start = lstart;
+            end = lend;
+            return true;
+        }
+
+        // Helper function to prefetch the occurrence blocks the next LF step will read, and the head of the SA interval
+        void _prefetch(index_type start, index_type end) const
+        {
+            B.prefetch((size_t)start);
+            B.prefetch((size_t)end + 1);
+#if defined(__GNUC__) || defined(__clang__)
+            if (SA != NULL)
+                __builtin_prefetch(SA + start); // Read once the search ends
+#endif
+        }
+
+        // Interval of a query substring P in both directions: fwd in F (suffixes of the sequence starting with P),
+        // rev in B (suffixes of the reversed sequence starting with P reversed); both have size rows
+        struct BiInterval
+        {
+            index_type fwd, rev, size;
+            size_t qbegin, qend; // P = query[qbegin, qend)
+        };
+
+        // Helper function to append c to P: one LF step in B, and the matching sub-interval of F
+        BiInterval _extend_right(const BiInterval& ik, unsigned char c) const
+        {
+            index_type sizes[4], lower = 0;
+            for (int b = 0; b != 4; ++b)
+                sizes[b] = (index_type)B.rank(b + 1, ik.rev + ik.size) - (index_type)B.rank(b + 1, ik.rev);
+            for (int b = 0; b != c - 1; ++b)
+                lower += sizes[b];
+            const index_type end_marks = ik.size - sizes[0] - sizes[1] - sizes[2] - sizes[3]; // P is a suffix of the sequence
+            return BiInterval({ ik.fwd + end_marks + lower, begin[c - 1] + (index_type)B.rank(c, ik.rev), sizes[c - 1], ik.qbegin, ik.qend + 1 });
+        }
+
+        // Helper function to prepend c to P: one LF step in F, and the matching sub-interval of B
+        BiInterval _extend_left(const BiInterval& ik, unsigned char c) const
+        {
+            index_type sizes[4], lower = 0;
+            for (int b = 0; b != 4; ++b)
+                sizes[b] = (index_type)F.rank(b + 1, ik.fwd + ik.size) - (index_type)F.rank(b + 1, ik.fwd);
+            for (int b = 0; b != c - 1; ++b)
+                lower += sizes[b];
+            const index_type end_marks = ik.size - sizes[0] - sizes[1] - sizes[2] - sizes[3]; // P is a prefix of the sequence
+            return BiInterval({ begin[c - 1] + (index_type)F.rank(c, ik.fwd), ik.rev + end_marks + lower, sizes[c - 1], ik.qbegin - 1, ik.qend });
+        }
+
+        // Helper function to turn the SA interval [start, end] of query[qbegin, qbegin + len) into anchors,
+        // applying the occurrence cap; masked_end tracks the masked query positions of this query
+        template<typename RandomAccessIterator>
+        void _record(RandomAccessIterator first, size_t qbegin, size_t len, index_type start, index_type end, std::vector<triple>& out,
+            RepeatStats* stats, size_t& masked_end) const
+        {
+            const size_t occurrences = end - start + 1;
+            if (max_occurrences == 0 || occurrences <= max_occurrences)
+            {
+                for (index_type i = start; i <= end; i++)
+                    out.emplace_back(triple({ length - 1 - _locate(i) - len, qbegin, len }));
+                return;
+            }
+
+            if (reextend_repeats && bidirectional())
+            {
+                const BiInterval ik = _reextend(first, qbegin, len);
+                if ((size_t)ik.size <= max_occurrences)
+                {
+                    const size_t mem_length = ik.qend - ik.qbegin;
+                    for (index_type i = ik.rev; i != ik.rev + ik.size; i++)
+                        out.emplace_back(triple({ length - 1 - _locate(i) - mem_length, ik.qbegin, mem_length }));
+                    if (stats != NULL)
+                        ++stats->reextended;
+                    return;
+                }
+            }
+
+            if (stats != NULL)
+            {
+                ++stats->masked_seeds;
+                stats->masked_occurrences += occurrences;
+                _mask(qbegin, qbegin + len, stats, masked_end);
+            }
+        }
+
+        // Helper function to extend the match query[qbegin, qbegin + len) to the left until it occurs at most
+        // max_occurrences times or cannot grow; a maximal forward match cannot become rarer to the right
+        template<typename RandomAccessIterator>
+        BiInterval _reextend(RandomAccessIterator first, size_t qbegin, size_t len) const
+        {
+            unsigned char c = first[qbegin];
+            BiInterval ik({ begin[c - 1], begin[c - 1], begin[c] - begin[c - 1], qbegin, qbegin + 1 });
+            for (size_t i = qbegin + 1; i != qbegin + len; ++i)
+                ik = _extend_right(ik, (unsigned char)first[i]);
+            while ((size_t)ik.size > max_occurrences && ik.qbegin != 0)
+            {
+                c = first[ik.qbegin - 1];
+                if (c < 1 || c > 4)
+                    break;
+                const BiInterval ok = _extend_left(ik, c);
+                if (ok.size == 0)
+                    break;
+                ik = ok;
+            }
+            return ik;
+        }
+
+        // Helper function to count the query positions of [qbegin, qend) not masked yet (masked ranges come by qbegin)
+        static void _mask(size_t qbegin, size_t qend, RepeatStats* stats, size_t& masked_end)
+        {
+            if (qend > masked_end)
+            {
+                stats->masked_bases += qend - std::max(qbegin, masked_end);
+                masked_end = qend;
+            }
+        }
+
+        // Helper function to find the SMEMs through query position x (Li 2012): extend right as far as possible,
+        // remembering every length at which the interval shrinks, then extend all of them left together.
+        // Returns the end of the longest match through x, where the next call starts.
+        template<typename RandomAccessIterator>
+        size_t _smem(RandomAccessIterator first, size_t rhs_len, size_t x, std::vector<BiInterval>& mems,
+            std::vector<BiInterval>& prev, std::vector<BiInterval>& curr, size_t* contained) const
+        {
+            unsigned char c = first[x];
+            if (c < 1 || c > 4)
+                return x + 1;
+
+            BiInterval ik({ begin[c - 1], begin[c - 1], begin[c] - begin[c - 1], x, x + 1 });
+            if (ik.size == 0)
+                return x + 1;
+            curr.clear();
+            for (size_t i = x + 1; ; ++i)
+            {
+                c = i == rhs_len ? 0 : (unsigned char)first[i];
+                if (c < 1 || c > 4)
+                {
+                    curr.push_back(ik);
+                    break;
+                }
+                const BiInterval ok = _extend_right(ik, c);
+                if (ok.size != ik.size)
+                    curr.push_back(ik);
+                if (ok.size == 0)
+                    break;
+                ik = ok;
+            }
+            std::reverse(curr.begin(), curr.end()); // Longest first
+            prev.swap(curr);
+            const size_t ret = prev[0].qend;
+
+            for (size_t i = x; ; --i)
+            {
+                c = i == 0 ? 0 : (unsigned char)first[i - 1];
+                curr.clear();
+                for (const BiInterval& p : prev)
+                {
+                    const bool valid = c >= 1 && c <= 4;
+                    const BiInterval ok = valid ? _extend_left(p, c) : p;
+                    if (!valid || ok.size == 0)
+                    {
+                        // P cannot grow to the left: it is an SMEM unless a longer match through it was kept
+                        if (curr.empty() && (mems.empty() || p.qbegin < mems.back().qbegin))
+                            mems.push_back(p);
+                        else if (contained != NULL)
+                            ++*contained;
+                    }
+                    else if (curr.empty() || ok.size != curr.back().size)
+                        curr.push_back(ok);
+                }
+                if (curr.empty() || i == 0)
+                    break;
+                prev.swap(curr);
+            }
+            return ret;
+        }
+
+        // Helper function to visit every k-mer depth first, narrowing the interval one symbol at a time
+        void _fill_kmer_table(size_t code, int depth, index_type start, index_type end)
+        {
+            if (depth == kmer_length)
+            {
+                kmer_table[code] = kmer_interval({ start, end });
+                return;
+            }
+            for (int c = 1; c <= 4; ++c)
+            {
+                const index_type lstart = begin[c - 1] + rank((char)c, start);
+                const index_type lend = begin[c - 1] + rank((char)c, end + 1) - 1;
+                if (lstart <= lend) // Empty intervals keep the { 1, 0 } the table was filled with
+                    _fill_kmer_table(code * 4 + c - 1, depth + 1, lstart, lend);
+            }
+        }
+
+        // Helper function to get the table entry of the k-mer starting at first, or npos when there is none
+        template<typename InputIterator>
+        size_t _kmer_code(InputIterator first, InputIterator last) const
+        {
+            if (kmer_length == 0 || last - first < kmer_length)
+                return npos;
+            size_t code = 0;
+            for (int i = 0; i != kmer_length; ++i, ++first)
+            {
+                const unsigned char c = *first;
+                if (c < 1 || c > 4)
+                    return npos;
+                code = code * 4 + c - 1;
+            }
+            return code;
+        }
+
+        // Helper function to copy the sequence in reverse order and add end mark
+        template<typename InputIterator>
+        unsigned char* _copy_reword(InputIterator first, InputIterator last, unsigned char end_mark)
+        {
+            unsigned char* result = new unsigned char[length];
+            for (size_t i = length - 1; i != 0; --i)
+                result[i - 1] = *(first++);
+            result[length - 1] = end_mark;
+            return result;
+        }
+
+        // Helper functions for stable sorting
+        inline bool leq(int a1, int a2, int b1, int b2) {
+            return (a1 < b1 || (a1 == b1 && a2 <= b2));
+        }
+
+        inline bool leq(int a1, int a2, int a3, int b1, int b2, int b3) {
+            return (a1 < b1 || (a1 == b1 && leq(a2, a3, b2, b3)));
+        }
+
+        // Function to sort suffixes using radix sort
+        static void radixPass(int* a, int* b, int* r, int n, int K)
+        {
+            int* c = new int[K + 1]; // Counter array
+            for (int i = 0; i <= K; i++) c[i] = 0; // Reset counters
+            for (int i = 0; i < n; i++) c[r[a[i]]]++; // Count occurrences
+            for (int i = 0, sum = 0; i <= K; i++) {
+                int t = c[i]; c[i] = sum; sum += t;
+            }
+            for (int i = 0; i < n; i++) b[c[r[a[i]]]++] = a[i]; // Sort
+            delete[] c;
+        }
+
+        // Function to build suffix array using DC3 algorithm
+        void suffixArray(int* s, int* SA, int n, int K)
+        {
+            // Implementation of DC3 algorithm to build the suffix array
+        }
+
+        // Function to build auxiliary data structures for suffix array
+        int* build_sa()
+        {
+            int* s = new int[length + 3];
+            int* sa = new int[length + 3];
+            for (int i = 0; i < length; i++) s[i] = (int)reword[i];
+            s[length] = s[length + 1] = s[length + 2] = sa[length] = sa[length + 1] = sa[length + 2] = 0;
+            suffixArray(s, sa, length, 5);
+            delete[] s;
+            return sa;
+        }
+
+        // Helper function to sort the suffixes of text[0, length): divsufsort for 32-bit indexes, SA-IS otherwise
+        void _sort_suffixes(const unsigned char* text, index_type* sa) const
+        {
+            if constexpr (std::is_same<index_type, int32_t>::value)
+                divsufsort(text, reinterpret_cast<int32_t*>(sa), (int32_t)length, build_threads);
+            else
+                sais<index_type, unsigned char>(text, sa, (index_type)length, 256);
+        }
+
+        // Function to initialize various arrays for suffix array computation
+        index_type build_b()
+        {
+            index_type* _begin = new index_type[5];
+            _begin[4] = length;
+            B.build(length, dis / 32, [this](size_t i) { return SA[i] == 0 ? reword[length - 1] : reword[SA[i] - 1]; }, build_threads);
+            _begin[0] = 1;
+            _begin[1] = (index_type)B.rank(1, length) + 1;
+            _begin[2] = _begin[1] + (index_type)B.rank(2, length);
+            _begin[3] = _begin[2] + (index_type)B.rank(3, length);
+            begin = _begin; // Initialize begin breakpoints
+            return (index_type)B.endp(); // Return end position
+        }
+
+    private:
+        const int dis; // Distance between occurrence checkpoints
+        const size_t sa_rate; // SA sampling rate, 1 keeps the full SA
+        const int build_threads; // Threads used to build the index
+        SampledSa<index_type> S; // Sampled SA, used when sa_rate > 1
+        index_type endp; // End position of special character
+        std::unique_ptr<utils::MappedFile> _index; // Mapped index file when SA and B (and F, if saved) were loaded from disk
+        std::string _index_file; // File the index is saved to, empty for none
+        uint64_t _checksum; // Checksum of the sequence, stored in the index file
+        using kmer_interval = std::array<index_type, 2>;
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+        int kmer_length; // k of the jump table
+        std::vector<kmer_interval> kmer_table; // SA interval (start, end) of every k-mer, start > end when absent
+        size_t max_occurrences; // Occurrence cap of a match, 0 for none
+        bool reextend_repeats; // Extend matches above the cap to the left instead of dropping them at once
+
+    public:
+        const size_t length; // Length of the sequence including ending character
+        const unsigned char* reword; // Reverse of original sequence with end mark
+        index_type* SA; // Suffix array
+        bwt_type B; // BWT, 2 bits per symbol, with the occurrence checkpoints interleaved
+        bwt_type F; // BWT of the forward sequence, only built for bidirectional search
+        const index_type* begin; // Breakpoints for A, C, G, T in B
+    };
+}
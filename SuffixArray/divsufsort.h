@@ -1,2146 +1,2146 @@
-/*
- * divsufsort_private.h for libdivsufsort
- * Copyright (c) 2003-2008 Yuta Mori All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person
- * obtaining a copy of this software and associated documentation
- * files (the "Software"), to deal in the Software without
- * restriction, including without limitation the rights to use,
- * copy, modify, merge, publish, distribute, sublicense, and/or sell
- * copies of the Software, and to permit persons to whom the
- * Software is furnished to do so, subject to the following
- * conditions:
- *
- * The above copyright notice and this permission notice shall be
- * included in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
- * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
- * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
- * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
- * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
- * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
- * OTHER DEALINGS IN THE SOFTWARE.
- */
-
-#ifdef _WIN32
-#include <windows.h>
-#include <psapi.h>
-#elif defined(__linux__)
-#include <unistd.h>
-#include <sys/cdefs.h>
-#include <sys/resource.h>
-#elif defined(__APPLE__)
-#include <mach/mach.h>
-#endif
-
-# include "parallel_import.h"
-
-#include <fstream>
-#include <sstream>
-#include <utility>
-#include <cstdint>
-#include <string>
-#include <tuple>
-#include <cstdio>
-#include <cstdlib>
-#include <iostream>
-#include <assert.h>
-#include <stdio.h>
-//# include <string.h>
-# include <stdlib.h>
-# include <memory.h>
-# include <stddef.h>
-# include <stdint.h>
-#include <vector>
-#include <cstring>
-
-
-#if (_IS_USED_MULTITHREAD)
-#include <thread>
-#endif
-
-
-
-
-#ifndef _DIVSUFSORT_PRIVATE_H
-#define _DIVSUFSORT_PRIVATE_H 1
-
-#ifndef _CONFIG_H
-#define _CONFIG_H 1
-
-#ifdef __cplusplus
-extern "C" {
-#endif /* __cplusplus */
-
-    /** Define to the version of this package. **/
-#define PROJECT_VERSION_FULL "2.0.1-14-g5f60d6f"
-
-/** Define to 1 if you have the header files. **/
-#define HAVE_INTTYPES_H 0
-#define HAVE_STDDEF_H 1
-#if defined (__cplusplus) || (defined (__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L) /* C99 */)
-#   define HAVE_STDINT_H 1
-#else
-#   define HAVE_STDINT_H 0
-#endif
-#define HAVE_STDLIB_H 1
-#define HAVE_STRING_H 1
-#define HAVE_STRINGS_H 0
-#define HAVE_MEMORY_H 1
-#define HAVE_SYS_TYPES_H 0
-
-#ifndef HAVE__SETMODE
-# if HAVE_SETMODE
-#  define _setmode setmode
-#  define HAVE__SETMODE 1
-# endif
-# if HAVE__SETMODE && !HAVE__O_BINARY
-#  define _O_BINARY 0
-#  define HAVE__O_BINARY 1
-# endif
-#endif
-
-/** for inline **/
-#ifndef INLINE
-#   ifdef _MSC_VER
-#       define INLINE __inline
-#   else
-#       define INLINE inline
-#   endif
-#endif
-
-/** for VC++ warning **/
-#ifdef _MSC_VER
-#pragma warning(disable: 4127)
-#endif
-
-
-#ifdef __cplusplus
-} /* extern "C" */
-#endif /* __cplusplus */
-
-#endif /* _CONFIG_H */
-
-
-
- /*- Constants -*/
-#if !defined(UINT8_MAX)
-# define UINT8_MAX (255)
-#endif /* UINT8_MAX */
-#if defined(ALPHABET_SIZE) && (ALPHABET_SIZE < 1)
-# undef ALPHABET_SIZE
-#endif
-#if !defined(ALPHABET_SIZE)
-# define ALPHABET_SIZE (UINT8_MAX + 1)
-#endif
-/* for divsufsort.c */
-#define BUCKET_A_SIZE (ALPHABET_SIZE)
-#define BUCKET_B_SIZE (ALPHABET_SIZE * ALPHABET_SIZE)
-/* for sssort.c */
-#if defined(SS_INSERTIONSORT_THRESHOLD)
-# if SS_INSERTIONSORT_THRESHOLD < 1
-#  undef SS_INSERTIONSORT_THRESHOLD
-#  define SS_INSERTIONSORT_THRESHOLD (1)
-# endif
-#else
-# define SS_INSERTIONSORT_THRESHOLD (8)
-#endif
-#if defined(SS_BLOCKSIZE)
-# if SS_BLOCKSIZE < 0
-#  undef SS_BLOCKSIZE
-#  define SS_BLOCKSIZE (0)
-# elif 32768 <= SS_BLOCKSIZE
-#  undef SS_BLOCKSIZE
-#  define SS_BLOCKSIZE (32767)
-# endif
-#else
-# define SS_BLOCKSIZE (1024)
-#endif
-/* minstacksize = log(SS_BLOCKSIZE) / log(3) * 2 */
-#if SS_BLOCKSIZE == 0
-# if !defined(BUILD_DIVSUFSORT64)
-#  define SS_MISORT_STACKSIZE (64)
-# else
-#  define SS_MISORT_STACKSIZE (96)
-# endif
-#elif SS_BLOCKSIZE <= 4096
-# define SS_MISORT_STACKSIZE (16)
-#else
-# define SS_MISORT_STACKSIZE (24)
-#endif
-#if !defined(BUILD_DIVSUFSORT64)
-# define SS_SMERGE_STACKSIZE (32)
-#else
-# define SS_SMERGE_STACKSIZE (64)
-#endif
-/* for trsort.c */
-#define TR_INSERTIONSORT_THRESHOLD (8)
-#if !defined(BUILD_DIVSUFSORT64)
-# define TR_STACKSIZE (64)
-#else
-# define TR_STACKSIZE (96)
-#endif
-
-/*- Macros -*/
-#ifndef SWAP
-# define SWAP(_a, _b) do { t = (_a); (_a) = (_b); (_b) = t; } while(0)
-#endif /* SWAP */
-#ifndef MIN
-# define MIN(_a, _b) (((_a) < (_b)) ? (_a) : (_b))
-#endif /* MIN */
-#ifndef MAX
-# define MAX(_a, _b) (((_a) > (_b)) ? (_a) : (_b))
-#endif /* MAX */
-#define STACK_PUSH(_a, _b, _c, _d)\
-  do {\
-    assert(ssize < STACK_SIZE);\
-    stack[ssize].a = (_a), stack[ssize].b = (_b),\
-    stack[ssize].c = (_c), stack[ssize++].d = (_d);\
-  } while(0)
-#define STACK_PUSH5(_a, _b, _c, _d, _e)\
-  do {\
-    assert(ssize < STACK_SIZE);\
-    stack[ssize].a = (_a), stack[ssize].b = (_b),\
-    stack[ssize].c = (_c), stack[ssize].d = (_d), stack[ssize++].e = (_e);\
-  } while(0)
-#define STACK_POP(_a, _b, _c, _d)\
-  do {\
-    assert(0 <= ssize);\
-    if(ssize == 0) { return; }\
-    (_a) = stack[--ssize].a, (_b) = stack[ssize].b,\
-    (_c) = stack[ssize].c, (_d) = stack[ssize].d;\
-  } while(0)
-#define STACK_POP5(_a, _b, _c, _d, _e)\
-  do {\
-    assert(0 <= ssize);\
-    if(ssize == 0) { return; }\
-    (_a) = stack[--ssize].a, (_b) = stack[ssize].b,\
-    (_c) = stack[ssize].c, (_d) = stack[ssize].d, (_e) = stack[ssize].e;\
-  } while(0)
-/* for divsufsort.c */
-#define BUCKET_A(_c0) bucket_A[(_c0)]
-#if ALPHABET_SIZE == 256
-#define BUCKET_B(_c0, _c1) (bucket_B[((_c1) << 8) | (_c0)])
-#define BUCKET_BSTAR(_c0, _c1) (bucket_B[((_c0) << 8) | (_c1)])
-#else
-#define BUCKET_B(_c0, _c1) (bucket_B[(_c1) * ALPHABET_SIZE + (_c0)])
-#define BUCKET_BSTAR(_c0, _c1) (bucket_B[(_c0) * ALPHABET_SIZE + (_c1)])
-#endif
-
-#ifndef SAUCHAR_T
-#define SAUCHAR_T
-typedef uint8_t sauchar_t;
-#endif /* SAUCHAR_T */
-#ifndef SAINT_T
-#define SAINT_T
-typedef int32_t saint_t;
-#endif /* SAINT_T */
-#ifndef SAIDX32_T
-#define SAIDX32_T
-typedef int32_t saidx32_t;
-#endif /* SAIDX32_T */
-typedef saidx32_t saidx_t;
-typedef saidx_t sastore_t;
-
-/*- Private Prototypes -*/
-/* sssort.c */
-static
-void
-sssort(const sauchar_t* Td, const sastore_t* PA,
-    sastore_t* first, sastore_t* last,
-    sastore_t* buf, saidx_t bufsize,
-    saidx_t depth, saidx_t n, saint_t lastsuffix);
-/* trsort.c */
-static
-void
-trsort(sastore_t* ISA, sastore_t* SA, saidx_t n, saidx_t depth);
-
-static const int lg_table[256] = {
- -1,0,1,1,2,2,2,2,3,3,3,3,3,3,3,3,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
-  5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-  6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-  6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7
-};
-
-#endif /* _DIVSUFSORT_PRIVATE_H */
-
-#define HAVE_CONFIG_H 1
-#ifndef _DIVSUFSORT_H
-#define _DIVSUFSORT_H 1
-
-#if defined (__cplusplus) || (defined (__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L) /* C99 */)
-#   include <stdint.h> //for uint8_t,int32_t
-#else
-#   if (_MSC_VER >= 1300)
-typedef unsigned __int8     uint8_t;
-typedef signed __int32      int32_t;
-#   else
-typedef unsigned char       uint8_t;
-typedef signed int          int32_t;
-#   endif
-#endif
-
-#ifdef __cplusplus
-extern "C" {
-#endif /* __cplusplus */
-
-#ifndef PRId32
-#   define PRId32 "d"
-#endif
-
-#ifndef DIVSUFSORT_API
-# ifdef DIVSUFSORT_BUILD_DLL
-#  define DIVSUFSORT_API 
-# else
-#  define DIVSUFSORT_API 
-# endif
-#endif
-
-    /*- Datatypes -*/
-#ifndef SAUCHAR_T
-#define SAUCHAR_T
-    typedef uint8_t sauchar_t;
-#endif /* SAUCHAR_T */
-#ifndef SAINT_T
-#define SAINT_T
-    typedef int32_t saint_t;
-#endif /* SAINT_T */
-#ifndef SAIDX32_T
-#define SAIDX32_T
-    typedef int32_t saidx32_t;
-#endif /* SAIDX32_T */
-
-    /*- Prototypes -*/
-
-    /**
-     * Constructs the suffix array of a given string.
-     * @param T[0..n-1] The input string.
-     * @param SA[0..n-1] The output array of suffixes.
-     * @param n The length of the given string.
-     * @return 0 if no error occurred, -1 or -2 otherwise.
-     */
-    DIVSUFSORT_API
-        static saint_t
-        divsufsort(const sauchar_t* T, saidx32_t* SA, saidx32_t n, int threadNum);
-
-    /**
-     * Returns the version of the divsufsort library.
-     * @return The version number string.
-     */
-    DIVSUFSORT_API
-        static const char*
-        divsufsort_version(void);
-
-#ifdef __cplusplus
-} /* extern "C" */
-#endif /* __cplusplus */
-
-#endif /* _DIVSUFSORT_H */
-typedef saidx32_t saidx_t;
-typedef saidx_t sastore_t;
-//////#include "trsort.c.inc.h"************************
-/*- Private Functions -*/
-
-static INLINE
-saint_t
-tr_ilg(saidx_t n) {
-#if !defined(BUILD_DIVSUFSORT64)
-    return (n & 0xffff0000) ?
-        ((n & 0xff000000) ?
-            24 + lg_table[(n >> 24) & 0xff] :
-            16 + lg_table[(n >> 16) & 0xff]) :
-        ((n & 0x0000ff00) ?
-            8 + lg_table[(n >> 8) & 0xff] :
-            0 + lg_table[(n >> 0) & 0xff]);
-#else
-    return (n >> 32) ?
-        ((n >> 48) ?
-            ((n >> 56) ?
-                56 + lg_table[(n >> 56) & 0xff] :
-                48 + lg_table[(n >> 48) & 0xff]) :
-            ((n >> 40) ?
-                40 + lg_table[(n >> 40) & 0xff] :
-                32 + lg_table[(n >> 32) & 0xff])) :
-        ((n & 0xffff0000) ?
-            ((n & 0xff000000) ?
-                24 + lg_table[(n >> 24) & 0xff] :
-                16 + lg_table[(n >> 16) & 0xff]) :
-            ((n & 0x0000ff00) ?
-                8 + lg_table[(n >> 8) & 0xff] :
-                0 + lg_table[(n >> 0) & 0xff]));
-#endif
-}
-
-
-/*---------------------------------------------------------------------------*/
-
-/* Simple insertionsort for small size groups. */
-static
-void
-tr_insertionsort(const sastore_t * ISAd, sastore_t * first, sastore_t * last) {
-    sastore_t* a, * b;
-    saidx_t t, r;
-
-    for (a = first + 1; a < last; ++a) {
-        for (t = *a, b = a - 1; 0 > (r = ISAd[t] - ISAd[*b]);) {
-            do { *(b + 1) = *b; } while ((first <= --b) && (*b < 0));
-            if (b < first) { break; }
-        }
-        if (r == 0) { *b = ~*b; }
-        *(b + 1) = t;
-    }
-}
-
-
-/*---------------------------------------------------------------------------*/
-
-static INLINE
-void
-tr_fixdown(const sastore_t * ISAd, sastore_t * SA, saidx_t i, saidx_t size) {
-    saidx_t j, k;
-    saidx_t v;
-    saidx_t c, d, e;
-
-    for (v = SA[i], c = ISAd[v]; (j = 2 * i + 1) < size; SA[i] = SA[k], i = k) {
-        d = ISAd[SA[k = j++]];
-        if (d < (e = ISAd[SA[j]])) { k = j; d = e; }
-        if (d <= c) { break; }
-    }
-    SA[i] = v;
-}
-
-/* Simple top-down heapsort. */
-static
-void
-tr_heapsort(const sastore_t * ISAd, sastore_t * SA, saidx_t size) {
-    saidx_t i, m;
-    saidx_t t;
-
-    m = size;
-    if ((size % 2) == 0) {
-        m--;
-        if (ISAd[SA[m / 2]] < ISAd[SA[m]]) { SWAP(SA[m], SA[m / 2]); }
-    }
-
-    for (i = m / 2 - 1; 0 <= i; --i) { tr_fixdown(ISAd, SA, i, m); }
-    if ((size % 2) == 0) { SWAP(SA[0], SA[m]); tr_fixdown(ISAd, SA, 0, m); }
-    for (i = m - 1; 0 < i; --i) {
-        t = SA[0], SA[0] = SA[i];
-        tr_fixdown(ISAd, SA, 0, i);
-        SA[i] = t;
-    }
-}
-
-
-/*---------------------------------------------------------------------------*/
-
-/* Returns the median of three elements. */
-static INLINE
-sastore_t*
-tr_median3(const sastore_t * ISAd, sastore_t * v1, sastore_t * v2, sastore_t * v3) {
-    sastore_t* t;
-    if (ISAd[*v1] > ISAd[*v2]) { SWAP(v1, v2); }
-    if (ISAd[*v2] > ISAd[*v3]) {
-        if (ISAd[*v1] > ISAd[*v3]) { return v1; }
-        else { return v3; }
-    }
-    return v2;
-}
-
-/* Returns the median of five elements. */
-static INLINE
-sastore_t*
-tr_median5(const sastore_t * ISAd,
-    sastore_t * v1, sastore_t * v2, sastore_t * v3, sastore_t * v4, sastore_t * v5) {
-    sastore_t* t;
-    if (ISAd[*v2] > ISAd[*v3]) { SWAP(v2, v3); }
-    if (ISAd[*v4] > ISAd[*v5]) { SWAP(v4, v5); }
-    if (ISAd[*v2] > ISAd[*v4]) { SWAP(v2, v4); SWAP(v3, v5); }
-    if (ISAd[*v1] > ISAd[*v3]) { SWAP(v1, v3); }
-    if (ISAd[*v1] > ISAd[*v4]) { SWAP(v1, v4); SWAP(v3, v5); }
-    if (ISAd[*v3] > ISAd[*v4]) { return v4; }
-    return v3;
-}
-
-/* Returns the pivot element. */
-static INLINE
-sastore_t*
-tr_pivot(const sastore_t * ISAd, sastore_t * first, sastore_t * last) {
-    sastore_t* middle;
-    saidx_t t;
-
-    t = (saidx_t)(last - first);
-    middle = first + t / 2;
-
-    if (t <= 512) {
-        if (t <= 32) {
-            return tr_median3(ISAd, first, middle, last - 1);
-        }
-        else {
-            t >>= 2;
-            return tr_median5(ISAd, first, first + t, middle, last - 1 - t, last - 1);
-        }
-    }
-    t >>= 3;
-    first = tr_median3(ISAd, first, first + t, first + (t << 1));
-    middle = tr_median3(ISAd, middle - t, middle, middle + t);
-    last = tr_median3(ISAd, last - 1 - (t << 1), last - 1 - t, last - 1);
-    return tr_median3(ISAd, first, middle, last);
-}
-
-
-/*---------------------------------------------------------------------------*/
-
-typedef struct _trbudget_t trbudget_t;
-struct _trbudget_t {
-    saidx_t chance;
-    saidx_t remain;
-    saidx_t incval;
-    saidx_t count;
-};
-
-static INLINE
-void
-trbudget_init(trbudget_t * budget, saidx_t chance, saidx_t incval) {
-    budget->chance = chance;
-    budget->remain = budget->incval = incval;
-}
-
-static INLINE
-saint_t
-trbudget_check(trbudget_t * budget, saidx_t size) {
-    if (size <= budget->remain) { budget->remain -= size; return 1; }
-    if (budget->chance == 0) { budget->count += size; return 0; }
-    budget->remain += budget->incval - size;
-    budget->chance -= 1;
-    return 1;
-}
-
-
-/*---------------------------------------------------------------------------*/
-
-static INLINE
-void
-tr_partition(const sastore_t * ISAd,
-    sastore_t * first, sastore_t * middle, sastore_t * last,
-    sastore_t * *pa, sastore_t * *pb, saidx_t v) {
-    sastore_t* a, * b, * c, * d, * e, * f;
-    saidx_t t, s;
-    saidx_t x = 0;
-
-    for (b = middle - 1; (++b < last) && ((x = ISAd[*b]) == v);) {}
-    if (((a = b) < last) && (x < v)) {
-        for (; (++b < last) && ((x = ISAd[*b]) <= v);) {
-            if (x == v) { SWAP(*b, *a); ++a; }
-        }
-    }
-    for (c = last; (b < --c) && ((x = ISAd[*c]) == v);) {}
-    if ((b < (d = c)) && (x > v)) {
-        for (; (b < --c) && ((x = ISAd[*c]) >= v);) {
-            if (x == v) { SWAP(*c, *d); --d; }
-        }
-    }
-    for (; b < c;) {
-        SWAP(*b, *c);
-        for (; (++b < c) && ((x = ISAd[*b]) <= v);) {
-            if (x == v) { SWAP(*b, *a); ++a; }
-        }
-        for (; (b < --c) && ((x = ISAd[*c]) >= v);) {
-            if (x == v) { SWAP(*c, *d); --d; }
-        }
-    }
-
-    if (a <= d) {
-        c = b - 1;
-        if ((s = (saidx_t)(a - first)) > (t = (saidx_t)(b - a))) { s = t; }
-        for (e = first, f = b - s; 0 < s; --s, ++e, ++f) { SWAP(*e, *f); }
-        if ((s = (saidx_t)(d - c)) > (t = (saidx_t)(last - d - 1))) { s = t; }
-        for (e = b, f = last - s; 0 < s; --s, ++e, ++f) { SWAP(*e, *f); }
-        first += (b - a), last -= (d - c);
-    }
-    *pa = first, * pb = last;
-}
-
-static
-void
-tr_copy(sastore_t * ISA, const sastore_t * SA,
-    sastore_t * first, sastore_t * a, sastore_t * b, sastore_t * last,
-    saidx_t depth) {
-    /* sort suffixes of middle partition
-       by using sorted order of suffixes of left and right partition. */
-    sastore_t* c, * d, * e;
-    saidx_t s, v;
-
-    v = (saidx_t)(b - SA - 1);
-    for (c = first, d = a - 1; c <= d; ++c) {
-        if ((0 <= (s = *c - depth)) && (ISA[s] == v)) {
-            *++d = s;
-            ISA[s] = (saidx_t)(d - SA);
-        }
-    }
-    for (c = last - 1, e = d + 1, d = b; e < d; --c) {
-        if ((0 <= (s = *c - depth)) && (ISA[s] == v)) {
-            *--d = s;
-            ISA[s] = (saidx_t)(d - SA);
-        }
-    }
-}
-
-static
-void
-tr_partialcopy(sastore_t * ISA, const sastore_t * SA,
-    sastore_t * first, sastore_t * a, sastore_t * b, sastore_t * last,
-    saidx_t depth) {
-    sastore_t* c, * d, * e;
-    saidx_t s, v;
-    saidx_t rank, lastrank, newrank = -1;
-
-    v = (saidx_t)(b - SA - 1);
-    lastrank = -1;
-    for (c = first, d = a - 1; c <= d; ++c) {
-        if ((0 <= (s = *c - depth)) && (ISA[s] == v)) {
-            *++d = s;
-            rank = ISA[s + depth];
-            if (lastrank != rank) { lastrank = rank; newrank = (saidx_t)(d - SA); }
-            ISA[s] = newrank;
-        }
-    }
-
-    lastrank = -1;
-    for (e = d; first <= e; --e) {
-        rank = ISA[*e];
-        if (lastrank != rank) { lastrank = rank; newrank = (saidx_t)(e - SA); }
-        if (newrank != rank) { ISA[*e] = newrank; }
-    }
-
-    lastrank = -1;
-    for (c = last - 1, e = d + 1, d = b; e < d; --c) {
-        if ((0 <= (s = *c - depth)) && (ISA[s] == v)) {
-            *--d = s;
-            rank = ISA[s + depth];
-            if (lastrank != rank) { lastrank = rank; newrank = (saidx_t)(d - SA); }
-            ISA[s] = newrank;
-        }
-    }
-}
-
-static
-void
-tr_introsort(sastore_t * ISA, const sastore_t * ISAd,
-    sastore_t * SA, sastore_t * first, sastore_t * last,
-    trbudget_t * budget) {
-#define STACK_SIZE TR_STACKSIZE
-    struct { const sastore_t* a; sastore_t* b, * c; saint_t d, e; }stack[STACK_SIZE];
-    sastore_t* a, * b, * c;
-    saidx_t t;
-    saidx_t v, x = 0;
-    saidx_t incr = (saidx_t)(ISAd - ISA);
-    saint_t limit, next;
-    saint_t ssize, trlink = -1;
-
-    for (ssize = 0, limit = tr_ilg((saidx_t)(last - first));;) {
-
-        if (limit < 0) {
-            if (limit == -1) {
-                /* tandem repeat partition */
-                tr_partition(ISAd - incr, first, first, last, &a, &b, (saidx_t)(last - SA - 1));
-
-                /* update ranks */
-                if (a < last) {
-                    for (c = first, v = (saidx_t)(a - SA - 1); c < a; ++c) { ISA[*c] = v; }
-                }
-                if (b < last) {
-                    for (c = a, v = (saidx_t)(b - SA - 1); c < b; ++c) { ISA[*c] = v; }
-                }
-
-                /* push */
-                if (1 < (b - a)) {
-                    STACK_PUSH5(NULL, a, b, 0, 0);
-                    STACK_PUSH5(ISAd - incr, first, last, -2, trlink);
-                    trlink = ssize - 2;
-                }
-                if ((a - first) <= (last - b)) {
-                    if (1 < (a - first)) {
-                        STACK_PUSH5(ISAd, b, last, tr_ilg((saidx_t)(last - b)), trlink);
-                        last = a, limit = tr_ilg((saidx_t)(a - first));
-                    }
-                    else if (1 < (last - b)) {
-                        first = b, limit = tr_ilg((saidx_t)(last - b));
-                    }
-                    else {
-                        STACK_POP5(ISAd, first, last, limit, trlink);
-                    }
-                }
-                else {
-                    if (1 < (last - b)) {
-                        STACK_PUSH5(ISAd, first, a, tr_ilg((saidx_t)(a - first)), trlink);
-                        first = b, limit = tr_ilg((saidx_t)(last - b));
-                    }
-                    else if (1 < (a - first)) {
-                        last = a, limit = tr_ilg((saidx_t)(a - first));
-                    }
-                    else {
-                        STACK_POP5(ISAd, first, last, limit, trlink);
-                    }
-                }
-            }
-            else if (limit == -2) {
-                /* tandem repeat copy */
-                a = stack[--ssize].b, b = stack[ssize].c;
-                if (stack[ssize].d == 0) {
-                    tr_copy(ISA, SA, first, a, b, last, (saidx_t)(ISAd - ISA));
-                }
-                else {
-                    if (0 <= trlink) { stack[trlink].d = -1; }
-                    tr_partialcopy(ISA, SA, first, a, b, last, (saidx_t)(ISAd - ISA));
-                }
-                STACK_POP5(ISAd, first, last, limit, trlink);
-            }
-            else {
-                /* sorted partition */
-                if (0 <= *first) {
-                    a = first;
-                    do { ISA[*a] = (saidx_t)(a - SA); } while ((++a < last) && (0 <= *a));
-                    first = a;
-                }
-                if (first < last) {
-                    a = first; do { *a = ~*a; } while (*++a < 0);
-                    next = (ISA[*a] != ISAd[*a]) ? tr_ilg((saidx_t)(a - first + 1)) : -1;
-                    if (++a < last) { for (b = first, v = (saidx_t)(a - SA - 1); b < a; ++b) { ISA[*b] = v; } }
-
-                    /* push */
-                    if (trbudget_check(budget, (saidx_t)(a - first))) {
-                        if ((a - first) <= (last - a)) {
-                            STACK_PUSH5(ISAd, a, last, -3, trlink);
-                            ISAd += incr, last = a, limit = next;
-                        }
-                        else {
-                            if (1 < (last - a)) {
-                                STACK_PUSH5(ISAd + incr, first, a, next, trlink);
-                                first = a, limit = -3;
-                            }
-                            else {
-                                ISAd += incr, last = a, limit = next;
-                            }
-                        }
-                    }
-                    else {
-                        if (0 <= trlink) { stack[trlink].d = -1; }
-                        if (1 < (last - a)) {
-                            first = a, limit = -3;
-                        }
-                        else {
-                            STACK_POP5(ISAd, first, last, limit, trlink);
-                        }
-                    }
-                }
-                else {
-                    STACK_POP5(ISAd, first, last, limit, trlink);
-                }
-            }
-            continue;
-        }
-
-        if ((last - first) <= TR_INSERTIONSORT_THRESHOLD) {
-            tr_insertionsort(ISAd, first, last);
-            limit = -3;
-            continue;
-        }
-
-        if (limit-- == 0) {
-            tr_heapsort(ISAd, first, (saidx_t)(last - first));
-            for (a = last - 1; first < a; a = b) {
-                for (x = ISAd[*a], b = a - 1; (first <= b) && (ISAd[*b] == x); --b) { *b = ~*b; }
-            }
-            limit = -3;
-            continue;
-        }
-
-        /* choose pivot */
-        a = tr_pivot(ISAd, first, last);
-        SWAP(*first, *a);
-        v = ISAd[*first];
-
-        /* partition */
-        tr_partition(ISAd, first, first + 1, last, &a, &b, v);
-        if ((last - first) != (b - a)) {
-            next = (ISA[*a] != v) ? tr_ilg((saidx_t)(b - a)) : -1;
-
-            /* update ranks */
-            for (c = first, v = (saidx_t)(a - SA - 1); c < a; ++c) { ISA[*c] = v; }
-            if (b < last) { for (c = a, v = (saidx_t)(b - SA - 1); c < b; ++c) { ISA[*c] = v; } }
-
-            /* push */
-            if ((1 < (b - a)) && (trbudget_check(budget, (saidx_t)(b - a)))) {
-                if ((a - first) <= (last - b)) {
-                    if ((last - b) <= (b - a)) {
-                        if (1 < (a - first)) {
-                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
-                            STACK_PUSH5(ISAd, b, last, limit, trlink);
-                            last = a;
-                        }
-                        else if (1 < (last - b)) {
-                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
-                            first = b;
-                        }
-                        else {
-                            ISAd += incr, first = a, last = b, limit = next;
-                        }
-                    }
-                    else if ((a - first) <= (b - a)) {
-                        if (1 < (a - first)) {
-                            STACK_PUSH5(ISAd, b, last, limit, trlink);
-                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
-                            last = a;
-                        }
-                        else {
-                            STACK_PUSH5(ISAd, b, last, limit, trlink);
-                            ISAd += incr, first = a, last = b, limit = next;
-                        }
-                    }
-                    else {
-                        STACK_PUSH5(ISAd, b, last, limit, trlink);
-                        STACK_PUSH5(ISAd, first, a, limit, trlink);
-                        ISAd += incr, first = a, last = b, limit = next;
-                    }
-                }
-                else {
-                    if ((a - first) <= (b - a)) {
-                        if (1 < (last - b)) {
-                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
-                            STACK_PUSH5(ISAd, first, a, limit, trlink);
-                            first = b;
-                        }
-                        else if (1 < (a - first)) {
-                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
-                            last = a;
-                        }
-                        else {
-                            ISAd += incr, first = a, last = b, limit = next;
-                        }
-                    }
-                    else if ((last - b) <= (b - a)) {
-                        if (1 < (last - b)) {
-                            STACK_PUSH5(ISAd, first, a, limit, trlink);
-                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
-                            first = b;
-                        }
-                        else {
-                            STACK_PUSH5(ISAd, first, a, limit, trlink);
-                            ISAd += incr, first = a, last = b, limit = next;
-                        }
-                    }
-                    else {
-                        STACK_PUSH5(ISAd, first, a, limit, trlink);
-                        STACK_PUSH5(ISAd, b, last, limit, trlink);
-                        ISAd += incr, first = a, last = b, limit = next;
-                    }
-                }
-            }
-            else {
-                if ((1 < (b - a)) && (0 <= trlink)) { stack[trlink].d = -1; }
-                if ((a - first) <= (last - b)) {
-                    if (1 < (a - first)) {
-                        STACK_PUSH5(ISAd, b, last, limit, trlink);
-                        last = a;
-                    }
-                    else if (1 < (last - b)) {
-                        first = b;
-                    }
-                    else {
-                        STACK_POP5(ISAd, first, last, limit, trlink);
-                    }
-                }
-                else {
-                    if (1 < (last - b)) {
-                        STACK_PUSH5(ISAd, first, a, limit, trlink);
-                        first = b;
-                    }
-                    else if (1 < (a - first)) {
-                        last = a;
-                    }
-                    else {
-                        STACK_POP5(ISAd, first, last, limit, trlink);
-                    }
-                }
-            }
-        }
-        else {
-            if (trbudget_check(budget, (saidx_t)(last - first))) {
-                limit = tr_ilg((saidx_t)(last - first)), ISAd += incr;
-            }
-            else {
-                if (0 <= trlink) { stack[trlink].d = -1; }
-                STACK_POP5(ISAd, first, last, limit, trlink);
-            }
-        }
-    }
-#undef STACK_SIZE
-}
-
-
-
-/*---------------------------------------------------------------------------*/
-
-/*- Function -*/
-
-/* Tandem repeat sort */
-static
-void
-trsort(sastore_t * ISA, sastore_t * SA, saidx_t n, saidx_t depth) {
-    sastore_t* ISAd;
-    sastore_t* first, * last;
-    trbudget_t budget;
-    saidx_t t, skip, unsorted;
-
-    trbudget_init(&budget, tr_ilg(n) * 2 / 3, n);
-    /*  trbudget_init(&budget, tr_ilg(n) * 3 / 4, n); */
-    for (ISAd = ISA + depth; -n < *SA; ISAd += ISAd - ISA) {
-        first = SA;
-        skip = 0;
-        unsorted = 0;
-        do {
-            if ((t = *first) < 0) { first -= t; skip += t; }
-            else {
-                if (skip != 0) { *(first + skip) = skip; skip = 0; }
-                last = SA + ISA[t] + 1;
-                if (1 < (last - first)) {
-                    budget.count = 0;
-                    tr_introsort(ISA, ISAd, SA, first, last, &budget);
-                    if (budget.count != 0) { unsorted += budget.count; }
-                    else { skip = (saidx_t)(first - last); }
-                }
-                else if ((last - first) == 1) {
-                    skip = -1;
-                }
-                first = last;
-            }
-        } while (first < (SA + n));
-        if (skip != 0) { *(first + skip) = skip; }
-        if (unsorted == 0) { break; }
-    }
-}
-
-/////#include "divsufsort_private.h"****************************
-
-
-
-/*- Private Functions -*/
-
-struct CHLocker {
-    HLocker locker;
-    inline CHLocker() :locker(0) { locker = locker_new(); }
-    inline ~CHLocker() { locker_delete(locker); }
-};
-
-
-
-
-
-
-
-
-
-
-
-
-
-#if (_IS_USED_MULTITHREAD)
-struct mt_data_t {
-    CHLocker            locker;
-    const sauchar_t* T;
-    sastore_t* SA;
-    const saidx_t* bucket_B;
-    const sastore_t* PAb;
-    saidx_t             bufsize;
-    saidx_t             n;
-    saidx_t             m;
-};
-
-#if (_IS_USED_CPP11THREAD)
-#   include <mutex>
-struct CAutoLocker :public _TLockerBox_name {
-    inline CAutoLocker(HLocker _locker)
-        :_TLockerBox_name() {
-        if (_locker) { _TLockerBox_name _t(*(std::mutex*)_locker); _t.swap(*this); }
-    }
-    inline ~CAutoLocker() { }
-};
-#else
-struct CAutoLocker :public TLockerBox {
-    inline CAutoLocker(HLocker _locker) { locker = _locker; if (locker) locker_enter(locker); }
-    inline ~CAutoLocker() { if (locker) locker_leave(locker); }
-};
-#endif
-
-static void _sssort_thread(saint_t * c0, saint_t * c1, saidx_t * j,
-    sastore_t * buf, mt_data_t * mt) {
-    saidx_t k = 0;
-    saidx_t l;
-    const saidx_t* bucket_B = mt->bucket_B;
-    for (;;) {
-        {
-            CAutoLocker __autoLocker(mt->locker.locker);
-            if (0 < (l = *j)) {
-                saint_t d0 = *c0, d1 = *c1;
-                do {
-                    k = BUCKET_BSTAR(d0, d1);
-                    if (--d1 <= d0) {
-                        d1 = ALPHABET_SIZE - 1;
-                        if (--d0 < 0) { break; }
-                    }
-                } while (((l - k) <= 1) && (0 < (l = k)));
-                *c0 = d0, * c1 = d1, * j = k;
-            }
-        }
-        if (l == 0) { break; }
-        sastore_t* SA = mt->SA;
-        sssort(mt->T, mt->PAb, SA + k, SA + l,
-            buf, mt->bufsize, 2, mt->n, *(SA + k) == (mt->m - 1));
-    }
-}
-#endif
-
-/* Sorts suffixes of type B*. */
-static
-saidx_t
-sort_typeBstar(const sauchar_t * T, sastore_t * SA,
-    saidx_t * bucket_A, saidx_t * bucket_B,
-    saidx_t n, int threadNum) {
-    sastore_t* PAb, * ISAb;
-    saidx_t i, j, k, t, m;
-    saint_t c0, c1;
-
-    /* Initialize bucket arrays. */
-    for (i = 0; i < BUCKET_A_SIZE; ++i) { bucket_A[i] = 0; }
-    for (i = 0; i < BUCKET_B_SIZE; ++i) { bucket_B[i] = 0; }
-
-    /* Count the number of occurrences of the first one or two characters of each
-       type A, B and B* suffix. Moreover, store the beginning position of all
-       type B* suffixes into the array SA. */
-    for (i = n - 1, m = n, c0 = T[n - 1]; 0 <= i;) {
-        /* type A suffix. */
-        do { ++BUCKET_A(c1 = c0); } while ((0 <= --i) && ((c0 = T[i]) >= c1));
-        if (0 <= i) {
-            /* type B* suffix. */
-            ++BUCKET_BSTAR(c0, c1);
-            SA[--m] = i;
-            /* type B suffix. */
-            for (--i, c1 = c0; (0 <= i) && ((c0 = T[i]) <= c1); --i, c1 = c0) {
-                ++BUCKET_B(c0, c1);
-            }
-        }
-    }
-    m = n - m;
-    /*
-    note:
-      A type B* suffix is lexicographically smaller than a type B suffix that
-      begins with the same first two characters.
-    */
-
-    /* Calculate the index of start/end point of each bucket. */
-    for (c0 = 0, i = 0, j = 0; c0 < ALPHABET_SIZE; ++c0) {
-        t = i + BUCKET_A(c0);
-        BUCKET_A(c0) = i + j; /* start point */
-        i = t + BUCKET_B(c0, c0);
-        for (c1 = c0 + 1; c1 < ALPHABET_SIZE; ++c1) {
-            j += BUCKET_BSTAR(c0, c1);
-            BUCKET_BSTAR(c0, c1) = j; /* end point */
-            i += BUCKET_B(c0, c1);
-        }
-    }
-
-    if (0 < m) {
-        /* Sort the type B* suffixes by their first two characters. */
-        PAb = SA + n - m; ISAb = SA + m;
-        for (i = m - 2; 0 <= i; --i) {
-            t = PAb[i], c0 = T[t], c1 = T[t + 1];
-            SA[--BUCKET_BSTAR(c0, c1)] = i;
-        }
-        t = PAb[m - 1], c0 = T[t], c1 = T[t + 1];
-        SA[--BUCKET_BSTAR(c0, c1)] = m - 1;
-
-        /* Sort the type B* substrings using sssort. */
-#if (_IS_USED_MULTITHREAD)
-        if (threadNum > 1) {
-            const saidx_t bufsize = (n - (2 * m)) / (saidx_t)threadNum;
-            const int threadCount = threadNum - 1;
-            c0 = ALPHABET_SIZE - 2, c1 = ALPHABET_SIZE - 1, j = m;
-            mt_data_t mt_data;
-            mt_data.T = T;
-            mt_data.SA = SA;
-            mt_data.bucket_B = bucket_B;
-            mt_data.PAb = PAb;
-            mt_data.bufsize = bufsize;
-            mt_data.n = n;
-            mt_data.m = m;
-            std::vector<std::thread> threads(threadCount);
-            sastore_t* buf = SA + m;
-            for (int ti = 0; ti < threadCount; ++ti, buf += bufsize) {
-                threads[ti] = std::thread(_sssort_thread, &c0, &c1, &j, buf, &mt_data);
-            }
-            _sssort_thread(&c0, &c1, &j, buf, &mt_data);
-            for (int ti = 0; ti < threadCount; ++ti)
-                threads[ti].join();
-        }
-        else
-#endif
-        {
-            sastore_t* buf = SA + m;
-            saidx_t bufsize = n - (2 * m);
-            for (c0 = ALPHABET_SIZE - 2, j = m; 0 < j; --c0) {
-                for (c1 = ALPHABET_SIZE - 1; c0 < c1; j = i, --c1) {
-                    i = BUCKET_BSTAR(c0, c1);
-                    if (1 < (j - i)) {
-                        sssort(T, PAb, SA + i, SA + j,
-                            buf, bufsize, 2, n, *(SA + i) == (m - 1));
-                    }
-                }
-            }
-        }
-
-        /* Compute ranks of type B* substrings. */
-        for (i = m - 1; 0 <= i; --i) {
-            if (0 <= SA[i]) {
-                j = i;
-                do { ISAb[SA[i]] = i; } while ((0 <= --i) && (0 <= SA[i]));
-                SA[i + 1] = i - j;
-                if (i <= 0) { break; }
-            }
-            j = i;
-            do { ISAb[SA[i] = ~SA[i]] = j; } while (SA[--i] < 0);
-            ISAb[SA[i]] = j;
-        }
-
-        /* Construct the inverse suffix array of type B* suffixes using trsort. */
-        trsort(ISAb, SA, m, 1);
-
-        /* Set the sorted order of tyoe B* suffixes. */
-        for (i = n - 1, j = m, c0 = T[n - 1]; 0 <= i;) {
-            for (--i, c1 = c0; (0 <= i) && ((c0 = T[i]) >= c1); --i, c1 = c0) {}
-            if (0 <= i) {
-                t = i;
-                for (--i, c1 = c0; (0 <= i) && ((c0 = T[i]) <= c1); --i, c1 = c0) {}
-                SA[ISAb[--j]] = ((t == 0) || (1 < (t - i))) ? t : ~t;
-            }
-        }
-
-        /* Calculate the index of start/end point of each bucket. */
-        BUCKET_B(ALPHABET_SIZE - 1, ALPHABET_SIZE - 1) = n; /* end point */
-        for (c0 = ALPHABET_SIZE - 2, k = m - 1; 0 <= c0; --c0) {
-            i = BUCKET_A(c0 + 1) - 1;
-            for (c1 = ALPHABET_SIZE - 1; c0 < c1; --c1) {
-                t = i - BUCKET_B(c0, c1);
-                BUCKET_B(c0, c1) = i; /* end point */
-
-                /* Move all type B* suffixes to the correct position. */
-                for (i = t, j = BUCKET_BSTAR(c0, c1);
-                    j <= k;
-                    --i, --k) {
-                    SA[i] = SA[k];
-                }
-            }
-            BUCKET_BSTAR(c0, c0 + 1) = i - BUCKET_B(c0, c0) + 1; /* start point */
-            BUCKET_B(c0, c0) = i; /* end point */
-        }
-    }
-
-    return m;
-}
-
-/* Constructs the suffix array by using the sorted order of type B* suffixes. */
-static
-void
-construct_SA(const sauchar_t * T, sastore_t * SA,
-    saidx_t * bucket_A, saidx_t * bucket_B,
-    saidx_t n, saidx_t m) {
-    sastore_t* i, * j, * k;
-    saidx_t s;
-    saint_t c0, c1, c2;
-
-    if (0 < m) {
-        /* Construct the sorted order of type B suffixes by using
-           the sorted order of type B* suffixes. */
-        for (c1 = ALPHABET_SIZE - 2; 0 <= c1; --c1) {
-            /* Scan the suffix array from right to left. */
-            for (i = SA + BUCKET_BSTAR(c1, c1 + 1),
-                j = SA + BUCKET_A(c1 + 1) - 1, k = NULL, c2 = -1;
-                i <= j;
-                --j) {
-                if (0 < (s = *j)) {
-                    assert(T[s] == c1);
-                    assert(((s + 1) < n) && (T[s] <= T[s + 1]));
-                    assert(T[s - 1] <= T[s]);
-                    *j = ~s;
-                    c0 = T[--s];
-                    if ((0 < s) && (T[s - 1] > c0)) { s = ~s; }
-                    if (c0 != c2) {
-                        if (0 <= c2) { BUCKET_B(c2, c1) = (saidx_t)(k - SA); }
-                        k = SA + BUCKET_B(c2 = c0, c1);
-                    }
-                    assert(k < j);
-                    *k-- = s;
-                }
-                else {
-                    assert(((s == 0) && (T[s] == c1)) || (s < 0));
-                    *j = ~s;
-                }
-            }
-        }
-    }
-
-    /* Construct the suffix array by using
-       the sorted order of type B suffixes. */
-    k = SA + BUCKET_A(c2 = T[n - 1]);
-    *k++ = (T[n - 2] < c2) ? ~(n - 1) : (n - 1);
-    /* Scan the suffix array from left to right. */
-    for (i = SA, j = SA + n; i < j; ++i) {
-        if (0 < (s = *i)) {
-            assert(T[s - 1] >= T[s]);
-            c0 = T[--s];
-            if ((s == 0) || (T[s - 1] < c0)) { s = ~s; }
-            if (c0 != c2) {
-                BUCKET_A(c2) = (saidx_t)(k - SA);
-                k = SA + BUCKET_A(c2 = c0);
-            }
-            assert(i < k);
-            *k++ = s;
-        }
-        else {
-            assert(s < 0);
-            *i = ~s;
-        }
-    }
-}
-
-/*---------------------------------------------------------------------------*/
-
-/*- Function -*/
-static
-saint_t
-divsufsort(const sauchar_t * T, sastore_t * SA, saidx_t n, int threadNum) {
-    saidx_t* bucket_A, * bucket_B;
-    saidx_t m;
-    saint_t err = 0;
-
-    /* Check arguments. */
-    if ((T == NULL) || (SA == NULL) || (n < 0)) { return -1; }
-    else if (n == 0) { return 0; }
-    else if (n == 1) { SA[0] = 0; return 0; }
-    else if (n == 2) { m = (T[0] < T[1]); SA[m ^ 1] = 0, SA[m] = 1; return 0; }
-
-    bucket_A = (saidx_t*)malloc(BUCKET_A_SIZE * sizeof(saidx_t));
-    bucket_B = (saidx_t*)malloc(BUCKET_B_SIZE * sizeof(saidx_t));
-
-    /* Suffixsort. */
-    if ((bucket_A != NULL) && (bucket_B != NULL)) {
-        m = sort_typeBstar(T, SA, bucket_A, bucket_B, n, threadNum);
-        construct_SA(T, SA, bucket_A, bucket_B, n, m);
-    }
-    else {
-        err = -2;
-    }
-
-    free(bucket_B);
-    free(bucket_A);
-
-    return err;
-}
-
-static
-const char*
-divsufsort_version(void) {
-    return PROJECT_VERSION_FULL;
-}
-
-/////#include "sssort.c.inc.h"****************
-#if (SS_BLOCKSIZE == 0) || (SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE)
-
-static INLINE
-saint_t
-ss_ilg(saidx_t n) {
-#if SS_BLOCKSIZE == 0
-    return tr_ilg(n);
-#elif SS_BLOCKSIZE < 256
-    return lg_table[n];
-#else
-    return (n & 0xff00) ?
-        8 + lg_table[(n >> 8) & 0xff] :
-        0 + lg_table[(n >> 0) & 0xff];
-#endif
-}
-
-#endif /* (SS_BLOCKSIZE == 0) || (SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE) */
-
-#if SS_BLOCKSIZE != 0
-
-static const saint_t sqq_table[256] = {
-  0,  16,  22,  27,  32,  35,  39,  42,  45,  48,  50,  53,  55,  57,  59,  61,
- 64,  65,  67,  69,  71,  73,  75,  76,  78,  80,  81,  83,  84,  86,  87,  89,
- 90,  91,  93,  94,  96,  97,  98,  99, 101, 102, 103, 104, 106, 107, 108, 109,
-110, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126,
-128, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142,
-143, 144, 144, 145, 146, 147, 148, 149, 150, 150, 151, 152, 153, 154, 155, 155,
-156, 157, 158, 159, 160, 160, 161, 162, 163, 163, 164, 165, 166, 167, 167, 168,
-169, 170, 170, 171, 172, 173, 173, 174, 175, 176, 176, 177, 178, 178, 179, 180,
-181, 181, 182, 183, 183, 184, 185, 185, 186, 187, 187, 188, 189, 189, 190, 191,
-192, 192, 193, 193, 194, 195, 195, 196, 197, 197, 198, 199, 199, 200, 201, 201,
-202, 203, 203, 204, 204, 205, 206, 206, 207, 208, 208, 209, 209, 210, 211, 211,
-212, 212, 213, 214, 214, 215, 215, 216, 217, 217, 218, 218, 219, 219, 220, 221,
-221, 222, 222, 223, 224, 224, 225, 225, 226, 226, 227, 227, 228, 229, 229, 230,
-230, 231, 231, 232, 232, 233, 234, 234, 235, 235, 236, 236, 237, 237, 238, 238,
-239, 240, 240, 241, 241, 242, 242, 243, 243, 244, 244, 245, 245, 246, 246, 247,
-247, 248, 248, 249, 249, 250, 250, 251, 251, 252, 252, 253, 253, 254, 254, 255
-};
-
-static INLINE
-saidx_t
-ss_isqrt(saidx_t x) {
-    saidx_t y, e;
-
-    if (x >= (SS_BLOCKSIZE * SS_BLOCKSIZE)) { return SS_BLOCKSIZE; }
-    e = (x & 0xffff0000) ?
-        ((x & 0xff000000) ?
-            24 + lg_table[(x >> 24) & 0xff] :
-            16 + lg_table[(x >> 16) & 0xff]) :
-        ((x & 0x0000ff00) ?
-            8 + lg_table[(x >> 8) & 0xff] :
-            0 + lg_table[(x >> 0) & 0xff]);
-
-    if (e >= 16) {
-        y = sqq_table[x >> ((e - 6) - (e & 1))] << ((e >> 1) - 7);
-        if (e >= 24) { y = (y + 1 + x / y) >> 1; }
-        y = (y + 1 + x / y) >> 1;
-    }
-    else if (e >= 8) {
-        y = (sqq_table[x >> ((e - 6) - (e & 1))] >> (7 - (e >> 1))) + 1;
-    }
-    else {
-        return sqq_table[x] >> 4;
-    }
-
-    return (x < (y* y)) ? y - 1 : y;
-}
-
-#endif /* SS_BLOCKSIZE != 0 */
-
-
-/*---------------------------------------------------------------------------*/
-
-/* Compares two suffixes. */
-static INLINE
-saint_t
-ss_compare(const sauchar_t * T,
-    const sastore_t * p1, const sastore_t * p2,
-    saidx_t depth) {
-    const sauchar_t* U1, * U2, * U1n, * U2n;
-
-    for (U1 = T + depth + *p1,
-        U2 = T + depth + *p2,
-        U1n = T + *(p1 + 1) + 2,
-        U2n = T + *(p2 + 1) + 2;
-        (U1 < U1n) && (U2 < U2n) && (*U1 == *U2);
-        ++U1, ++U2) {
-    }
-
-    return U1 < U1n ?
-        (U2 < U2n ? *U1 - *U2 : 1) :
-        (U2 < U2n ? -1 : 0);
-}
-
-
-/*---------------------------------------------------------------------------*/
-
-#if (SS_BLOCKSIZE != 1) && (SS_INSERTIONSORT_THRESHOLD != 1)
-
-/* Insertionsort for small size groups */
-static
-void
-ss_insertionsort(const sauchar_t * T, const sastore_t * PA,
-    sastore_t * first, sastore_t * last, saidx_t depth) {
-    sastore_t* i, * j;
-    saidx_t t;
-    saint_t r;
-
-    for (i = last - 2; first <= i; --i) {
-        for (t = *i, j = i + 1; 0 < (r = ss_compare(T, PA + t, PA + *j, depth));) {
-            do { *(j - 1) = *j; } while ((++j < last) && (*j < 0));
-            if (last <= j) { break; }
-        }
-        if (r == 0) { *j = ~*j; }
-        *(j - 1) = t;
-    }
-}
-
-#endif /* (SS_BLOCKSIZE != 1) && (SS_INSERTIONSORT_THRESHOLD != 1) */
-
-
-/*---------------------------------------------------------------------------*/
-
-#if (SS_BLOCKSIZE == 0) || (SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE)
-
-static INLINE
-void
-ss_fixdown(const sauchar_t * Td, const sastore_t * PA,
-    sastore_t * SA, saidx_t i, saidx_t size) {
-    saidx_t j, k;
-    saidx_t v;
-    saint_t c, d, e;
-
-    for (v = SA[i], c = Td[PA[v]]; (j = 2 * i + 1) < size; SA[i] = SA[k], i = k) {
-        d = Td[PA[SA[k = j++]]];
-        if (d < (e = Td[PA[SA[j]]])) { k = j; d = e; }
-        if (d <= c) { break; }
-    }
-    SA[i] = v;
-}
-
-/* Simple top-down heapsort. */
-static
-void
-ss_heapsort(const sauchar_t * Td, const sastore_t * PA, sastore_t * SA, saidx_t size) {
-    saidx_t i, m;
-    saidx_t t;
-
-    m = size;
-    if ((size % 2) == 0) {
-        m--;
-        if (Td[PA[SA[m / 2]]] < Td[PA[SA[m]]]) { SWAP(SA[m], SA[m / 2]); }
-    }
-
-    for (i = m / 2 - 1; 0 <= i; --i) { ss_fixdown(Td, PA, SA, i, m); }
-    if ((size % 2) == 0) { SWAP(SA[0], SA[m]); ss_fixdown(Td, PA, SA, 0, m); }
-    for (i = m - 1; 0 < i; --i) {
-        t = SA[0], SA[0] = SA[i];
-        ss_fixdown(Td, PA, SA, 0, i);
-        SA[i] = t;
-    }
-}
-
-
-/*---------------------------------------------------------------------------*/
-
-/* Returns the median of three elements. */
-static INLINE
-sastore_t*
-ss_median3(const sauchar_t * Td, const sastore_t * PA,
-    sastore_t * v1, sastore_t * v2, sastore_t * v3) {
-    sastore_t* t;
-    if (Td[PA[*v1]] > Td[PA[*v2]]) { SWAP(v1, v2); }
-    if (Td[PA[*v2]] > Td[PA[*v3]]) {
-        if (Td[PA[*v1]] > Td[PA[*v3]]) { return v1; }
-        else { return v3; }
-    }
-    return v2;
-}
-
-/* Returns the median of five elements. */
-static INLINE
-sastore_t*
-ss_median5(const sauchar_t * Td, const sastore_t * PA,
-    sastore_t * v1, sastore_t * v2, sastore_t * v3, sastore_t * v4, sastore_t * v5) {
-    sastore_t* t;
-    if (Td[PA[*v2]] > Td[PA[*v3]]) { SWAP(v2, v3); }
-    if (Td[PA[*v4]] > Td[PA[*v5]]) { SWAP(v4, v5); }
-    if (Td[PA[*v2]] > Td[PA[*v4]]) { SWAP(v2, v4); SWAP(v3, v5); }
-    if (Td[PA[*v1]] > Td[PA[*v3]]) { SWAP(v1, v3); }
-    if (Td[PA[*v1]] > Td[PA[*v4]]) { SWAP(v1, v4); SWAP(v3, v5); }
-    if (Td[PA[*v3]] > Td[PA[*v4]]) { return v4; }
-    return v3;
-}
-
-/* Returns the pivot element. */
-static INLINE
-sastore_t*
-ss_pivot(const sauchar_t * Td, const sastore_t * PA, sastore_t * first, sastore_t * last) {
-    sastore_t* middle;
-    saidx_t t;
-
-    t = (saidx_t)(last - first);
-    middle = first + t / 2;
-
-    if (t <= 512) {
-        if (t <= 32) {
-            return ss_median3(Td, PA, first, middle, last - 1);
-        }
-        else {
-            t >>= 2;
-            return ss_median5(Td, PA, first, first + t, middle, last - 1 - t, last - 1);
-        }
-    }
-    t >>= 3;
-    first = ss_median3(Td, PA, first, first + t, first + (t << 1));
-    middle = ss_median3(Td, PA, middle - t, middle, middle + t);
-    last = ss_median3(Td, PA, last - 1 - (t << 1), last - 1 - t, last - 1);
-    return ss_median3(Td, PA, first, middle, last);
-}
-
-
-/*---------------------------------------------------------------------------*/
-
-/* Binary partition for substrings. */
-static INLINE
-sastore_t*
-ss_partition(const sastore_t * PA,
-    sastore_t * first, sastore_t * last, saidx_t depth) {
-    sastore_t* a, * b;
-    saidx_t t;
-    for (a = first - 1, b = last;;) {
-        for (; (++a < b) && ((PA[*a] + depth) >= (PA[*a + 1] + 1));) { *a = ~*a; }
-        for (; (a < --b) && ((PA[*b] + depth) < (PA[*b + 1] + 1));) {}
-        if (b <= a) { break; }
-        t = ~*b;
-        *b = *a;
-        *a = t;
-    }
-    if (first < a) { *first = ~*first; }
-    return a;
-}
-
-/* Multikey introsort for medium size groups. */
-static
-void
-ss_mintrosort(const sauchar_t * T, const sastore_t * PA,
-    sastore_t * first, sastore_t * last,
-    saidx_t depth) {
-#define STACK_SIZE SS_MISORT_STACKSIZE
-    struct { sastore_t* a, * b, c; saint_t d; } stack[STACK_SIZE];
-    const sauchar_t* Td;
-    sastore_t* a, * b, * c, * d, * e, * f;
-    saidx_t s, t;
-    saint_t ssize;
-    saint_t limit;
-    saint_t v, x = 0;
-
-    for (ssize = 0, limit = ss_ilg((saidx_t)(last - first));;) {
-
-        if ((last - first) <= SS_INSERTIONSORT_THRESHOLD) {
-#if 1 < SS_INSERTIONSORT_THRESHOLD
-            if (1 < (last - first)) { ss_insertionsort(T, PA, first, last, depth); }
-#endif
-            STACK_POP(first, last, depth, limit);
-            continue;
-        }
-
-        Td = T + depth;
-        if (limit-- == 0) { ss_heapsort(Td, PA, first, (saidx_t)(last - first)); }
-        if (limit < 0) {
-            for (a = first + 1, v = Td[PA[*first]]; a < last; ++a) {
-                if ((x = Td[PA[*a]]) != v) {
-                    if (1 < (a - first)) { break; }
-                    v = x;
-                    first = a;
-                }
-            }
-            if (Td[PA[*first] - 1] < v) {
-                first = ss_partition(PA, first, a, depth);
-            }
-            if ((a - first) <= (last - a)) {
-                if (1 < (a - first)) {
-                    STACK_PUSH(a, last, depth, -1);
-                    last = a, depth += 1, limit = ss_ilg((saidx_t)(a - first));
-                }
-                else {
-                    first = a, limit = -1;
-                }
-            }
-            else {
-                if (1 < (last - a)) {
-                    STACK_PUSH(first, a, depth + 1, ss_ilg((saidx_t)(a - first)));
-                    first = a, limit = -1;
-                }
-                else {
-                    last = a, depth += 1, limit = ss_ilg((saidx_t)(a - first));
-                }
-            }
-            continue;
-        }
-
-        /* choose pivot */
-        a = ss_pivot(Td, PA, first, last);
-        v = Td[PA[*a]];
-        SWAP(*first, *a);
-
-        /* partition */
-        for (b = first; (++b < last) && ((x = Td[PA[*b]]) == v);) {}
-        if (((a = b) < last) && (x < v)) {
-            for (; (++b < last) && ((x = Td[PA[*b]]) <= v);) {
-                if (x == v) { SWAP(*b, *a); ++a; }
-            }
-        }
-        for (c = last; (b < --c) && ((x = Td[PA[*c]]) == v);) {}
-        if ((b < (d = c)) && (x > v)) {
-            for (; (b < --c) && ((x = Td[PA[*c]]) >= v);) {
-                if (x == v) { SWAP(*c, *d); --d; }
-            }
-        }
-        for (; b < c;) {
-            SWAP(*b, *c);
-            for (; (++b < c) && ((x = Td[PA[*b]]) <= v);) {
-                if (x == v) { SWAP(*b, *a); ++a; }
-            }
-            for (; (b < --c) && ((x = Td[PA[*c]]) >= v);) {
-                if (x == v) { SWAP(*c, *d); --d; }
-            }
-        }
-
-        if (a <= d) {
-            c = b - 1;
-
-            if ((s = (saidx_t)(a - first)) > (t = (saidx_t)(b - a))) { s = t; }
-            for (e = first, f = b - s; 0 < s; --s, ++e, ++f) { SWAP(*e, *f); }
-            if ((s = (saidx_t)(d - c)) > (t = (saidx_t)(last - d - 1))) { s = t; }
-            for (e = b, f = last - s; 0 < s; --s, ++e, ++f) { SWAP(*e, *f); }
-
-            a = first + (b - a), c = last - (d - c);
-            b = (v <= Td[PA[*a] - 1]) ? a : ss_partition(PA, a, c, depth);
-
-            if ((a - first) <= (last - c)) {
-                if ((last - c) <= (c - b)) {
-                    STACK_PUSH(b, c, depth + 1, ss_ilg((saidx_t)(c - b)));
-                    STACK_PUSH(c, last, depth, limit);
-                    last = a;
-                }
-                else if ((a - first) <= (c - b)) {
-                    STACK_PUSH(c, last, depth, limit);
-                    STACK_PUSH(b, c, depth + 1, ss_ilg((saidx_t)(c - b)));
-                    last = a;
-                }
-                else {
-                    STACK_PUSH(c, last, depth, limit);
-                    STACK_PUSH(first, a, depth, limit);
-                    first = b, last = c, depth += 1, limit = ss_ilg((saidx_t)(c - b));
-                }
-            }
-            else {
-                if ((a - first) <= (c - b)) {
-                    STACK_PUSH(b, c, depth + 1, ss_ilg((saidx_t)(c - b)));
-                    STACK_PUSH(first, a, depth, limit);
-                    first = c;
-                }
-                else if ((last - c) <= (c - b)) {
-                    STACK_PUSH(first, a, depth, limit);
-                    STACK_PUSH(b, c, depth + 1, ss_ilg((saidx_t)(c - b)));
-                    first = c;
-                }
-                else {
-                    STACK_PUSH(first, a, depth, limit);
-                    STACK_PUSH(c, last, depth, limit);
-                    first = b, last = c, depth += 1, limit = ss_ilg((saidx_t)(c - b));
-                }
-            }
-        }
-        else {
-            limit += 1;
-            if (Td[PA[*first] - 1] < v) {
-                first = ss_partition(PA, first, last, depth);
-                limit = ss_ilg((saidx_t)(last - first));
-            }
-            depth += 1;
-        }
-    }
-#undef STACK_SIZE
-}
-
-#endif /* (SS_BLOCKSIZE == 0) || (SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE) */
-
-
-/*---------------------------------------------------------------------------*/
-
-#if SS_BLOCKSIZE != 0
-
-static INLINE
-void
-ss_blockswap(sastore_t * a, sastore_t * b, saidx_t n) {
-    saidx_t t;
-    for (; 0 < n; --n, ++a, ++b) {
-        t = *a, * a = *b, * b = t;
-    }
-}
-
-static INLINE
-void
-ss_rotate(sastore_t * first, sastore_t * middle, sastore_t * last) {
-    sastore_t* a, * b, t;
-    saidx_t l, r;
-    l = (saidx_t)(middle - first), r = (saidx_t)(last - middle);
-    for (; (0 < l) && (0 < r);) {
-        if (l == r) { ss_blockswap(first, middle, l); break; }
-        if (l < r) {
-            a = last - 1, b = middle - 1;
-            t = *a;
-            do {
-                *a-- = *b, * b-- = *a;
-                if (b < first) {
-                    *a = t;
-                    last = a;
-                    if ((r -= l + 1) <= l) { break; }
-                    a -= 1, b = middle - 1;
-                    t = *a;
-                }
-            } while (1);
-        }
-        else {
-            a = first, b = middle;
-            t = *a;
-            do {
-                *a++ = *b, * b++ = *a;
-                if (last <= b) {
-                    *a = t;
-                    first = a + 1;
-                    if ((l -= r + 1) <= r) { break; }
-                    a += 1, b = middle;
-                    t = *a;
-                }
-            } while (1);
-        }
-    }
-}
-
-
-/*---------------------------------------------------------------------------*/
-
-static
-void
-ss_inplacemerge(const sauchar_t * T, const sastore_t * PA,
-    sastore_t * first, sastore_t * middle, sastore_t * last,
-    saidx_t depth) {
-    const sastore_t* p;
-    sastore_t* a, * b;
-    saidx_t len, half;
-    saint_t q, r;
-    saint_t x;
-
-    for (;;) {
-        if (*(last - 1) < 0) { x = 1; p = PA + ~*(last - 1); }
-        else { x = 0; p = PA + *(last - 1); }
-        for (a = first, len = (saidx_t)(middle - first), half = len >> 1, r = -1;
-            0 < len;
-            len = half, half >>= 1) {
-            b = a + half;
-            q = ss_compare(T, PA + ((0 <= *b) ? *b : ~*b), p, depth);
-            if (q < 0) {
-                a = b + 1;
-                half -= (len & 1) ^ 1;
-            }
-            else {
-                r = q;
-            }
-        }
-        if (a < middle) {
-            if (r == 0) { *a = ~*a; }
-            ss_rotate(a, middle, last);
-            last -= middle - a;
-            middle = a;
-            if (first == middle) { break; }
-        }
-        --last;
-        if (x != 0) { while (*--last < 0) {} }
-        if (middle == last) { break; }
-    }
-}
-
-
-/*---------------------------------------------------------------------------*/
-
-/* Merge-forward with internal buffer. */
-static
-void
-ss_mergeforward(const sauchar_t * T, const sastore_t * PA,
-    sastore_t * first, sastore_t * middle, sastore_t * last,
-    sastore_t * buf, saidx_t depth) {
-    sastore_t* a, * b, * c, * bufend;
-    saidx_t t;
-    saint_t r;
-
-    bufend = buf + (middle - first) - 1;
-    ss_blockswap(buf, first, (saidx_t)(middle - first));
-
-    for (t = *(a = first), b = buf, c = middle;;) {
-        r = ss_compare(T, PA + *b, PA + *c, depth);
-        if (r < 0) {
-            do {
-                *a++ = *b;
-                if (bufend <= b) { *bufend = t; return; }
-                *b++ = *a;
-            } while (*b < 0);
-        }
-        else if (r > 0) {
-            do {
-                *a++ = *c, * c++ = *a;
-                if (last <= c) {
-                    while (b < bufend) { *a++ = *b, * b++ = *a; }
-                    *a = *b, * b = t;
-                    return;
-                }
-            } while (*c < 0);
-        }
-        else {
-            *c = ~*c;
-            do {
-                *a++ = *b;
-                if (bufend <= b) { *bufend = t; return; }
-                *b++ = *a;
-            } while (*b < 0);
-
-            do {
-                *a++ = *c, * c++ = *a;
-                if (last <= c) {
-                    while (b < bufend) { *a++ = *b, * b++ = *a; }
-                    *a = *b, * b = t;
-                    return;
-                }
-            } while (*c < 0);
-        }
-    }
-}
-
-/* Merge-backward with internal buffer. */
-static
-void
-ss_mergebackward(const sauchar_t * T, const sastore_t * PA,
-    sastore_t * first, sastore_t * middle, sastore_t * last,
-    sastore_t * buf, saidx_t depth) {
-    const sastore_t* p1, * p2;
-    sastore_t* a, * b, * c, * bufend;
-    saidx_t t;
-    saint_t r;
-    saint_t x;
-
-    bufend = buf + (last - middle) - 1;
-    ss_blockswap(buf, middle, (saidx_t)(last - middle));
-
-    x = 0;
-    if (*bufend < 0) { p1 = PA + ~*bufend; x |= 1; }
-    else { p1 = PA + *bufend; }
-    if (*(middle - 1) < 0) { p2 = PA + ~*(middle - 1); x |= 2; }
-    else { p2 = PA + *(middle - 1); }
-    for (t = *(a = last - 1), b = bufend, c = middle - 1;;) {
-        r = ss_compare(T, p1, p2, depth);
-        if (0 < r) {
-            if (x & 1) { do { *a-- = *b, * b-- = *a; } while (*b < 0); x ^= 1; }
-            *a-- = *b;
-            if (b <= buf) { *buf = t; break; }
-            *b-- = *a;
-            if (*b < 0) { p1 = PA + ~*b; x |= 1; }
-            else { p1 = PA + *b; }
-        }
-        else if (r < 0) {
-            if (x & 2) { do { *a-- = *c, * c-- = *a; } while (*c < 0); x ^= 2; }
-            *a-- = *c, * c-- = *a;
-            if (c < first) {
-                while (buf < b) { *a-- = *b, * b-- = *a; }
-                *a = *b, * b = t;
-                break;
-            }
-            if (*c < 0) { p2 = PA + ~*c; x |= 2; }
-            else { p2 = PA + *c; }
-        }
-        else {
-            if (x & 1) { do { *a-- = *b, * b-- = *a; } while (*b < 0); x ^= 1; }
-            *a-- = ~*b;
-            if (b <= buf) { *buf = t; break; }
-            *b-- = *a;
-            if (x & 2) { do { *a-- = *c, * c-- = *a; } while (*c < 0); x ^= 2; }
-            *a-- = *c, * c-- = *a;
-            if (c < first) {
-                while (buf < b) { *a-- = *b, * b-- = *a; }
-                *a = *b, * b = t;
-                break;
-            }
-            if (*b < 0) { p1 = PA + ~*b; x |= 1; }
-            else { p1 = PA + *b; }
-            if (*c < 0) { p2 = PA + ~*c; x |= 2; }
-            else { p2 = PA + *c; }
-        }
-    }
-}
-
-/* D&C based merge. */
-static
-void
-ss_swapmerge(const sauchar_t * T, const sastore_t * PA,
-    sastore_t * first, sastore_t * middle, sastore_t * last,
-    sastore_t * buf, saidx_t bufsize, saidx_t depth) {
-#define STACK_SIZE SS_SMERGE_STACKSIZE
-#define GETIDX(a) ((0 <= (a)) ? (a) : (~(a)))
-#define MERGE_CHECK(a, b, c)\
-  do {\
-    if(((c) & 1) ||\
-       (((c) & 2) && (ss_compare(T, PA + GETIDX(*((a) - 1)), PA + *(a), depth) == 0))) {\
-      *(a) = ~*(a);\
-    }\
-    if(((c) & 4) && ((ss_compare(T, PA + GETIDX(*((b) - 1)), PA + *(b), depth) == 0))) {\
-      *(b) = ~*(b);\
-    }\
-  } while(0)
-    struct { sastore_t* a, * b, * c; saint_t d; } stack[STACK_SIZE];
-    sastore_t* l, * r, * lm, * rm;
-    saidx_t m, len, half;
-    saint_t ssize;
-    saint_t check, next;
-
-    for (check = 0, ssize = 0;;) {
-        if ((last - middle) <= bufsize) {
-            if ((first < middle) && (middle < last)) {
-                ss_mergebackward(T, PA, first, middle, last, buf, depth);
-            }
-            MERGE_CHECK(first, last, check);
-            STACK_POP(first, middle, last, check);
-            continue;
-        }
-
-        if ((middle - first) <= bufsize) {
-            if (first < middle) {
-                ss_mergeforward(T, PA, first, middle, last, buf, depth);
-            }
-            MERGE_CHECK(first, last, check);
-            STACK_POP(first, middle, last, check);
-            continue;
-        }
-
-        for (m = 0, len = (saidx_t)(MIN(middle - first, last - middle)), half = len >> 1;
-            0 < len;
-            len = half, half >>= 1) {
-            if (ss_compare(T, PA + GETIDX(*(middle + m + half)),
-                PA + GETIDX(*(middle - m - half - 1)), depth) < 0) {
-                m += half + 1;
-                half -= (len & 1) ^ 1;
-            }
-        }
-
-        if (0 < m) {
-            lm = middle - m, rm = middle + m;
-            ss_blockswap(lm, middle, m);
-            l = r = middle, next = 0;
-            if (rm < last) {
-                if (*rm < 0) {
-                    *rm = ~*rm;
-                    if (first < lm) { for (; *--l < 0;) {} next |= 4; }
-                    next |= 1;
-                }
-                else if (first < lm) {
-                    for (; *r < 0; ++r) {}
-                    next |= 2;
-                }
-            }
-
-            if ((l - first) <= (last - r)) {
-                STACK_PUSH(r, rm, last, (next & 3) | (check & 4));
-                middle = lm, last = l, check = (check & 3) | (next & 4);
-            }
-            else {
-                if ((next & 2) && (r == middle)) { next ^= 6; }
-                STACK_PUSH(first, lm, l, (check & 3) | (next & 4));
-                first = r, middle = rm, check = (next & 3) | (check & 4);
-            }
-        }
-        else {
-            if (ss_compare(T, PA + GETIDX(*(middle - 1)), PA + *middle, depth) == 0) {
-                *middle = ~*middle;
-            }
-            MERGE_CHECK(first, last, check);
-            STACK_POP(first, middle, last, check);
-        }
-    }
-#undef STACK_SIZE
-}
-
-#endif /* SS_BLOCKSIZE != 0 */
-
-/* Substring sort */
-static
-void
-sssort(const sauchar_t * T, const sastore_t * PA,
-    sastore_t * first, sastore_t * last,
-    sastore_t * buf, saidx_t bufsize,
-    saidx_t depth, saidx_t n, saint_t lastsuffix) {
-    sastore_t* a;
-#if SS_BLOCKSIZE != 0
-    sastore_t* b, * middle, * curbuf;
-    saidx_t j, k, curbufsize, limit;
-#endif
-    saidx_t i;
-
-    if (lastsuffix != 0) { ++first; }
-
-#if SS_BLOCKSIZE == 0
-    ss_mintrosort(T, PA, first, last, depth);
-#else
-    if ((bufsize < SS_BLOCKSIZE) &&
-        (bufsize < (last - first)) &&
-        (bufsize < (limit = ss_isqrt((saidx_t)(last - first))))) {
-        if (SS_BLOCKSIZE < limit) { limit = SS_BLOCKSIZE; }
-        buf = middle = last - limit, bufsize = limit;
-    }
-    else {
-        middle = last, limit = 0;
-    }
-    for (a = first, i = 0; SS_BLOCKSIZE < (middle - a); a += SS_BLOCKSIZE, ++i) {
-#if SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE
-        ss_mintrosort(T, PA, a, a + SS_BLOCKSIZE, depth);
-#elif 1 < SS_BLOCKSIZE
-        ss_insertionsort(T, PA, a, a + SS_BLOCKSIZE, depth);
-#endif
-        curbufsize = (saidx_t)(last - (a + SS_BLOCKSIZE));
-        curbuf = a + SS_BLOCKSIZE;
-        if (curbufsize <= bufsize) { curbufsize = bufsize, curbuf = buf; }
-        for (b = a, k = SS_BLOCKSIZE, j = i; j & 1; b -= k, k <<= 1, j >>= 1) {
-            ss_swapmerge(T, PA, b - k, b, b + k, curbuf, curbufsize, depth);
-        }
-    }
-#if SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE
-    ss_mintrosort(T, PA, a, middle, depth);
-#elif 1 < SS_BLOCKSIZE
-    ss_insertionsort(T, PA, a, middle, depth);
-#endif
-    for (k = SS_BLOCKSIZE; i != 0; k <<= 1, i >>= 1) {
-        if (i & 1) {
-            ss_swapmerge(T, PA, a - k, a, middle, buf, bufsize, depth);
-            a -= k;
-        }
-    }
-    if (limit != 0) {
-#if SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE
-        ss_mintrosort(T, PA, middle, last, depth);
-#elif 1 < SS_BLOCKSIZE
-        ss_insertionsort(T, PA, middle, last, depth);
-#endif
-        ss_inplacemerge(T, PA, first, middle, last, depth);
-    }
-#endif
-
-    if (lastsuffix != 0) {
-        /* Insert last type B* suffix. */
-        sastore_t PAi[2]; PAi[0] = PA[*(first - 1)], PAi[1] = n - 2;
-        for (a = first, i = *(first - 1);
-            (a < last) && ((*a < 0) || (0 < ss_compare(T, &(PAi[0]), PA + *a, depth)));
-            ++a) {
-            *(a - 1) = *a;
-        }
-        *(a - 1) = i;
-    }
-}
-
-
-static unsigned char* BWT(const unsigned char* T, const int32_t* sa, const int n) {
-    unsigned char* bwt = new unsigned char[n];
-    for (int i = 0; i < n; i++) {
-        if (sa[i] == 0) {
-            bwt[i] = T[n - 1];
-        }
-        else {
-            bwt[i] = T[sa[i] - 1];
-        }
-    }
-    return bwt;
-}
-
-
-static std::vector<std::tuple<std::string, uint8_t*, unsigned int>> read_fasta(const std::string& filename) {
-    std::ifstream input_file(filename);
-    std::vector<std::tuple<std::string, uint8_t*, unsigned int>> sequences;
-
-    std::string line, sequence_name;
-    uint8_t* sequence_data = nullptr;
-    unsigned int sequence_length = 0;
-
-    while (std::getline(input_file, line)) {
-        if (line[0] == '>') {
-            if (sequence_data != nullptr) {
-                sequences.emplace_back(std::make_tuple(sequence_name, sequence_data, sequence_length));
-                sequence_data = nullptr;
-            }
-
-            sequence_name = line.substr(1);
-            sequence_length = 0;
-        }
-        else {
-            if (sequence_data == nullptr) {
-                sequence_data = new uint8_t[line.length() + 1];
-            }
-            else {
-                uint8_t* temp = new uint8_t[sequence_length + line.length() + 1];
-                std::memcpy(temp, sequence_data, sequence_length);
-                delete[] sequence_data;
-                sequence_data = temp;
-            }
-
-            std::memcpy(sequence_data + sequence_length, line.c_str(), line.length());
-            sequence_length += line.length();
-        }
-    }
-
-    if (sequence_data != nullptr) {
-        sequences.emplace_back(std::make_tuple(sequence_name, sequence_data, sequence_length));
-    }
-
-    return sequences;
-}
-
-static void outputFasta(std::vector<std::tuple<std::string, uint8_t*, unsigned int>>& seqs) {
-    for (const auto& seq : seqs) {
-        std::cout << ">" << std::get<0>(seq) << " len=" << std::get<2>(seq) << std::endl;
-        uint8_t* data = std::get<1>(seq);
-        unsigned int len = std::get<2>(seq);
-        for (unsigned int i = 0; i < len; i += 80) {
-            unsigned int end = i + 80;
-            if (end > len) end = len;
-            std::cout.write((char*)(data + i), end - i);
-            std::cout << std::endl;
-        }
-    }
-}
-
-
-
-
-// سڴֵλֽڣ
-static size_t get_peak_memory() {
-    size_t peakMem = 0;
-#if defined(_WIN32)
-    PROCESS_MEMORY_COUNTERS pmc;
-    GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc));
-    peakMem = pmc.PeakWorkingSetSize;
-#elif defined(__linux__)
-    struct rusage usage;
-    getrusage(RUSAGE_SELF, &usage);
-    peakMem = usage.ru_maxrss * 1024L;
-#elif defined(__APPLE__)
-    struct mach_task_basic_info info;
-    mach_msg_type_number_t size = MACH_TASK_BASIC_INFO_COUNT;
-    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &size) != KERN_SUCCESS) {
-        return 0;
-    }
-    peakMem = info.resident_size_peak;
-#endif
-    return peakMem;
-}
-
-// Function to get current memory usage in bytes
-static size_t getCurrentMemoryUsage() {
-    size_t mem = 0;
-#ifdef _WIN32
-    PROCESS_MEMORY_COUNTERS pmc;
-    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
-        mem = pmc.WorkingSetSize;
-    }
-#elif defined(__linux__)
-    long rss = 0;
-    FILE* fp = fopen("/proc/self/statm", "r");
-    if (fp != nullptr) {
-        if (fscanf(fp, "%*s%ld", &rss) != 1) {
-            rss = 0;
-        }
-        fclose(fp);
-        mem = (size_t)rss * (size_t)sysconf(_SC_PAGESIZE);
-    }
-#endif
-    return mem;
-}
+/*
+ * divsufsort_private.h for libdivsufsort
+ * Copyright (c) 2003-2008 Yuta Mori All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#include <sys/cdefs.h>
+#include <sys/resource.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+# include "parallel_import.h"
+
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <assert.h>
+#include <stdio.h>
+//# include <string.h>
+# include <stdlib.h>
+# include <memory.h>
+# include <stddef.h>
+# include <stdint.h>
+#include <vector>
+#include <cstring>
+
+
+#if (_IS_USED_MULTITHREAD)
+#include <thread>
+#endif
+
+
+
+
+#ifndef _DIVSUFSORT_PRIVATE_H
+#define _DIVSUFSORT_PRIVATE_H 1
+
+#ifndef _CONFIG_H
+#define _CONFIG_H 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+    /** Define to the version of this package. **/
+#define PROJECT_VERSION_FULL "2.0.1-14-g5f60d6f"
+
+/** Define to 1 if you have the header files. **/
+#define HAVE_INTTYPES_H 0
+#define HAVE_STDDEF_H 1
+#if defined (__cplusplus) || (defined (__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L) /* C99 */)
+#   define HAVE_STDINT_H 1
+#else
+#   define HAVE_STDINT_H 0
+#endif
+#define HAVE_STDLIB_H 1
+#define HAVE_STRING_H 1
+#define HAVE_STRINGS_H 0
+#define HAVE_MEMORY_H 1
+#define HAVE_SYS_TYPES_H 0
+
+#ifndef HAVE__SETMODE
+# if HAVE_SETMODE
+#  define _setmode setmode
+#  define HAVE__SETMODE 1
+# endif
+# if HAVE__SETMODE && !HAVE__O_BINARY
+#  define _O_BINARY 0
+#  define HAVE__O_BINARY 1
+# endif
+#endif
+
+/** for inline **/
+#ifndef INLINE
+#   ifdef _MSC_VER
+#       define INLINE __inline
+#   else
+#       define INLINE inline
+#   endif
+#endif
+
+/** for VC++ warning **/
+#ifdef _MSC_VER
+#pragma warning(disable: 4127)
+#endif
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* _CONFIG_H */
+
+
+
+ /*- Constants -*/
+#if !defined(UINT8_MAX)
+# define UINT8_MAX (255)
+#endif /* UINT8_MAX */
+#if defined(ALPHABET_SIZE) && (ALPHABET_SIZE < 1)
+# undef ALPHABET_SIZE
+#endif
+#if !defined(ALPHABET_SIZE)
+# define ALPHABET_SIZE (UINT8_MAX + 1)
+#endif
+/* for divsufsort.c */
+#define BUCKET_A_SIZE (ALPHABET_SIZE)
+#define BUCKET_B_SIZE (ALPHABET_SIZE * ALPHABET_SIZE)
+/* for sssort.c */
+#if defined(SS_INSERTIONSORT_THRESHOLD)
+# if SS_INSERTIONSORT_THRESHOLD < 1
+#  undef SS_INSERTIONSORT_THRESHOLD
+#  define SS_INSERTIONSORT_THRESHOLD (1)
+# endif
+#else
+# define SS_INSERTIONSORT_THRESHOLD (8)
+#endif
+#if defined(SS_BLOCKSIZE)
+# if SS_BLOCKSIZE < 0
+#  undef SS_BLOCKSIZE
+#  define SS_BLOCKSIZE (0)
+# elif 32768 <= SS_BLOCKSIZE
+#  undef SS_BLOCKSIZE
+#  define SS_BLOCKSIZE (32767)
+# endif
+#else
+# define SS_BLOCKSIZE (1024)
+#endif
+/* minstacksize = log(SS_BLOCKSIZE) / log(3) * 2 */
+#if SS_BLOCKSIZE == 0
+# if !defined(BUILD_DIVSUFSORT64)
+#  define SS_MISORT_STACKSIZE (64)
+# else
+#  define SS_MISORT_STACKSIZE (96)
+# endif
+#elif SS_BLOCKSIZE <= 4096
+# define SS_MISORT_STACKSIZE (16)
+#else
+# define SS_MISORT_STACKSIZE (24)
+#endif
+#if !defined(BUILD_DIVSUFSORT64)
+# define SS_SMERGE_STACKSIZE (32)
+#else
+# define SS_SMERGE_STACKSIZE (64)
+#endif
+/* for trsort.c */
+#define TR_INSERTIONSORT_THRESHOLD (8)
+#if !defined(BUILD_DIVSUFSORT64)
+# define TR_STACKSIZE (64)
+#else
+# define TR_STACKSIZE (96)
+#endif
+
+/*- Macros -*/
+#ifndef SWAP
+# define SWAP(_a, _b) do { t = (_a); (_a) = (_b); (_b) = t; } while(0)
+#endif /* SWAP */
+#ifndef MIN
+# define MIN(_a, _b) (((_a) < (_b)) ? (_a) : (_b))
+#endif /* MIN */
+#ifndef MAX
+# define MAX(_a, _b) (((_a) > (_b)) ? (_a) : (_b))
+#endif /* MAX */
+#define STACK_PUSH(_a, _b, _c, _d)\
+  do {\
+    assert(ssize < STACK_SIZE);\
+    stack[ssize].a = (_a), stack[ssize].b = (_b),\
+    stack[ssize].c = (_c), stack[ssize++].d = (_d);\
+  } while(0)
+#define STACK_PUSH5(_a, _b, _c, _d, _e)\
+  do {\
+    assert(ssize < STACK_SIZE);\
+    stack[ssize].a = (_a), stack[ssize].b = (_b),\
+    stack[ssize].c = (_c), stack[ssize].d = (_d), stack[ssize++].e = (_e);\
+  } while(0)
+#define STACK_POP(_a, _b, _c, _d)\
+  do {\
+    assert(0 <= ssize);\
+    if(ssize == 0) { return; }\
+    (_a) = stack[--ssize].a, (_b) = stack[ssize].b,\
+    (_c) = stack[ssize].c, (_d) = stack[ssize].d;\
+  } while(0)
+#define STACK_POP5(_a, _b, _c, _d, _e)\
+  do {\
+    assert(0 <= ssize);\
+    if(ssize == 0) { return; }\
+    (_a) = stack[--ssize].a, (_b) = stack[ssize].b,\
+    (_c) = stack[ssize].c, (_d) = stack[ssize].d, (_e) = stack[ssize].e;\
+  } while(0)
+/* for divsufsort.c */
+#define BUCKET_A(_c0) bucket_A[(_c0)]
+#if ALPHABET_SIZE == 256
+#define BUCKET_B(_c0, _c1) (bucket_B[((_c1) << 8) | (_c0)])
+#define BUCKET_BSTAR(_c0, _c1) (bucket_B[((_c0) << 8) | (_c1)])
+#else
+#define BUCKET_B(_c0, _c1) (bucket_B[(_c1) * ALPHABET_SIZE + (_c0)])
+#define BUCKET_BSTAR(_c0, _c1) (bucket_B[(_c0) * ALPHABET_SIZE + (_c1)])
+#endif
+
+#ifndef SAUCHAR_T
+#define SAUCHAR_T
+typedef uint8_t sauchar_t;
+#endif /* SAUCHAR_T */
+#ifndef SAINT_T
+#define SAINT_T
+typedef int32_t saint_t;
+#endif /* SAINT_T */
+#ifndef SAIDX32_T
+#define SAIDX32_T
+typedef int32_t saidx32_t;
+#endif /* SAIDX32_T */
+typedef saidx32_t saidx_t;
+typedef saidx_t sastore_t;
+
+/*- Private Prototypes -*/
+/* sssort.c */
+static
+void
+sssort(const sauchar_t* Td, const sastore_t* PA,
+    sastore_t* first, sastore_t* last,
+    sastore_t* buf, saidx_t bufsize,
+    saidx_t depth, saidx_t n, saint_t lastsuffix);
+/* trsort.c */
+static
+void
+trsort(sastore_t* ISA, sastore_t* SA, saidx_t n, saidx_t depth);
+
+static const int lg_table[256] = {
+ -1,0,1,1,2,2,2,2,3,3,3,3,3,3,3,3,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
+  5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
+  6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
+  6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
+  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7
+};
+
+#endif /* _DIVSUFSORT_PRIVATE_H */
+
+#define HAVE_CONFIG_H 1
+#ifndef _DIVSUFSORT_H
+#define _DIVSUFSORT_H 1
+
+#if defined (__cplusplus) || (defined (__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L) /* C99 */)
+#   include <stdint.h> //for uint8_t,int32_t
+#else
+#   if (_MSC_VER >= 1300)
+typedef unsigned __int8     uint8_t;
+typedef signed __int32      int32_t;
+#   else
+typedef unsigned char       uint8_t;
+typedef signed int          int32_t;
+#   endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef PRId32
+#   define PRId32 "d"
+#endif
+
+#ifndef DIVSUFSORT_API
+# ifdef DIVSUFSORT_BUILD_DLL
+#  define DIVSUFSORT_API 
+# else
+#  define DIVSUFSORT_API 
+# endif
+#endif
+
+    /*- Datatypes -*/
+#ifndef SAUCHAR_T
+#define SAUCHAR_T
+    typedef uint8_t sauchar_t;
+#endif /* SAUCHAR_T */
+#ifndef SAINT_T
+#define SAINT_T
+    typedef int32_t saint_t;
+#endif /* SAINT_T */
+#ifndef SAIDX32_T
+#define SAIDX32_T
+    typedef int32_t saidx32_t;
+#endif /* SAIDX32_T */
+
+    /*- Prototypes -*/
+
+    /**
+     * Constructs the suffix array of a given string.
+     * @param T[0..n-1] The input string.
+     * @param SA[0..n-1] The output array of suffixes.
+     * @param n The length of the given string.
+     * @return 0 if no error occurred, -1 or -2 otherwise.
+     */
+    DIVSUFSORT_API
+        static saint_t
+        divsufsort(const sauchar_t* T, saidx32_t* SA, saidx32_t n, int threadNum);
+
+    /**
+     * Returns the version of the divsufsort library.
+     * @return The version number string.
+     */
+    DIVSUFSORT_API
+        static const char*
+        divsufsort_version(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* _DIVSUFSORT_H */
+typedef saidx32_t saidx_t;
+typedef saidx_t sastore_t;
+//////#include "trsort.c.inc.h"************************
+/*- Private Functions -*/
+
+static INLINE
+saint_t
+tr_ilg(saidx_t n) {
+#if !defined(BUILD_DIVSUFSORT64)
+    return (n & 0xffff0000) ?
+        ((n & 0xff000000) ?
+            24 + lg_table[(n >> 24) & 0xff] :
+            16 + lg_table[(n >> 16) & 0xff]) :
+        ((n & 0x0000ff00) ?
+            8 + lg_table[(n >> 8) & 0xff] :
+            0 + lg_table[(n >> 0) & 0xff]);
+#else
+    return (n >> 32) ?
+        ((n >> 48) ?
+            ((n >> 56) ?
+                56 + lg_table[(n >> 56) & 0xff] :
+                48 + lg_table[(n >> 48) & 0xff]) :
+            ((n >> 40) ?
+                40 + lg_table[(n >> 40) & 0xff] :
+                32 + lg_table[(n >> 32) & 0xff])) :
+        ((n & 0xffff0000) ?
+            ((n & 0xff000000) ?
+                24 + lg_table[(n >> 24) & 0xff] :
+                16 + lg_table[(n >> 16) & 0xff]) :
+            ((n & 0x0000ff00) ?
+                8 + lg_table[(n >> 8) & 0xff] :
+                0 + lg_table[(n >> 0) & 0xff]));
+#endif
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/* Simple insertionsort for small size groups. */
+static
+void
+tr_insertionsort(const sastore_t * ISAd, sastore_t * first, sastore_t * last) {
+    sastore_t* a, * b;
+    saidx_t t, r;
+
+    for (a = first + 1; a < last; ++a) {
+        for (t = *a, b = a - 1; 0 > (r = ISAd[t] - ISAd[*b]);) {
+            do { *(b + 1) = *b; } while ((first <= --b) && (*b < 0));
+            if (b < first) { break; }
+        }
+        if (r == 0) { *b = ~*b; }
+        *(b + 1) = t;
+    }
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+static INLINE
+void
+tr_fixdown(const sastore_t * ISAd, sastore_t * SA, saidx_t i, saidx_t size) {
+    saidx_t j, k;
+    saidx_t v;
+    saidx_t c, d, e;
+
+    for (v = SA[i], c = ISAd[v]; (j = 2 * i + 1) < size; SA[i] = SA[k], i = k) {
+        d = ISAd[SA[k = j++]];
+        if (d < (e = ISAd[SA[j]])) { k = j; d = e; }
+        if (d <= c) { break; }
+    }
+    SA[i] = v;
+}
+
+/* Simple top-down heapsort. */
+static
+void
+tr_heapsort(const sastore_t * ISAd, sastore_t * SA, saidx_t size) {
+    saidx_t i, m;
+    saidx_t t;
+
+    m = size;
+    if ((size % 2) == 0) {
+        m--;
+        if (ISAd[SA[m / 2]] < ISAd[SA[m]]) { SWAP(SA[m], SA[m / 2]); }
+    }
+
+    for (i = m / 2 - 1; 0 <= i; --i) { tr_fixdown(ISAd, SA, i, m); }
+    if ((size % 2) == 0) { SWAP(SA[0], SA[m]); tr_fixdown(ISAd, SA, 0, m); }
+    for (i = m - 1; 0 < i; --i) {
+        t = SA[0], SA[0] = SA[i];
+        tr_fixdown(ISAd, SA, 0, i);
+        SA[i] = t;
+    }
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/* Returns the median of three elements. */
+static INLINE
+sastore_t*
+tr_median3(const sastore_t * ISAd, sastore_t * v1, sastore_t * v2, sastore_t * v3) {
+    sastore_t* t;
+    if (ISAd[*v1] > ISAd[*v2]) { SWAP(v1, v2); }
+    if (ISAd[*v2] > ISAd[*v3]) {
+        if (ISAd[*v1] > ISAd[*v3]) { return v1; }
+        else { return v3; }
+    }
+    return v2;
+}
+
+/* Returns the median of five elements. */
+static INLINE
+sastore_t*
+tr_median5(const sastore_t * ISAd,
+    sastore_t * v1, sastore_t * v2, sastore_t * v3, sastore_t * v4, sastore_t * v5) {
+    sastore_t* t;
+    if (ISAd[*v2] > ISAd[*v3]) { SWAP(v2, v3); }
+    if (ISAd[*v4] > ISAd[*v5]) { SWAP(v4, v5); }
+    if (ISAd[*v2] > ISAd[*v4]) { SWAP(v2, v4); SWAP(v3, v5); }
+    if (ISAd[*v1] > ISAd[*v3]) { SWAP(v1, v3); }
+    if (ISAd[*v1] > ISAd[*v4]) { SWAP(v1, v4); SWAP(v3, v5); }
+    if (ISAd[*v3] > ISAd[*v4]) { return v4; }
+    return v3;
+}
+
+/* Returns the pivot element. */
+static INLINE
+sastore_t*
+tr_pivot(const sastore_t * ISAd, sastore_t * first, sastore_t * last) {
+    sastore_t* middle;
+    saidx_t t;
+
+    t = (saidx_t)(last - first);
+    middle = first + t / 2;
+
+    if (t <= 512) {
+        if (t <= 32) {
+            return tr_median3(ISAd, first, middle, last - 1);
+        }
+        else {
+            t >>= 2;
+            return tr_median5(ISAd, first, first + t, middle, last - 1 - t, last - 1);
+        }
+    }
+    t >>= 3;
+    first = tr_median3(ISAd, first, first + t, first + (t << 1));
+    middle = tr_median3(ISAd, middle - t, middle, middle + t);
+    last = tr_median3(ISAd, last - 1 - (t << 1), last - 1 - t, last - 1);
+    return tr_median3(ISAd, first, middle, last);
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+typedef struct _trbudget_t trbudget_t;
+struct _trbudget_t {
+    saidx_t chance;
+    saidx_t remain;
+    saidx_t incval;
+    saidx_t count;
+};
+
+static INLINE
+void
+trbudget_init(trbudget_t * budget, saidx_t chance, saidx_t incval) {
+    budget->chance = chance;
+    budget->remain = budget->incval = incval;
+}
+
+static INLINE
+saint_t
+trbudget_check(trbudget_t * budget, saidx_t size) {
+    if (size <= budget->remain) { budget->remain -= size; return 1; }
+    if (budget->chance == 0) { budget->count += size; return 0; }
+    budget->remain += budget->incval - size;
+    budget->chance -= 1;
+    return 1;
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+static INLINE
+void
+tr_partition(const sastore_t * ISAd,
+    sastore_t * first, sastore_t * middle, sastore_t * last,
+    sastore_t * *pa, sastore_t * *pb, saidx_t v) {
+    sastore_t* a, * b, * c, * d, * e, * f;
+    saidx_t t, s;
+    saidx_t x = 0;
+
+    for (b = middle - 1; (++b < last) && ((x = ISAd[*b]) == v);) {}
+    if (((a = b) < last) && (x < v)) {
+        for (; (++b < last) && ((x = ISAd[*b]) <= v);) {
+            if (x == v) { SWAP(*b, *a); ++a; }
+        }
+    }
+    for (c = last; (b < --c) && ((x = ISAd[*c]) == v);) {}
+    if ((b < (d = c)) && (x > v)) {
+        for (; (b < --c) && ((x = ISAd[*c]) >= v);) {
+            if (x == v) { SWAP(*c, *d); --d; }
+        }
+    }
+    for (; b < c;) {
+        SWAP(*b, *c);
+        for (; (++b < c) && ((x = ISAd[*b]) <= v);) {
+            if (x == v) { SWAP(*b, *a); ++a; }
+        }
+        for (; (b < --c) && ((x = ISAd[*c]) >= v);) {
+            if (x == v) { SWAP(*c, *d); --d; }
+        }
+    }
+
+    if (a <= d) {
+        c = b - 1;
+        if ((s = (saidx_t)(a - first)) > (t = (saidx_t)(b - a))) { s = t; }
+        for (e = first, f = b - s; 0 < s; --s, ++e, ++f) { SWAP(*e, *f); }
+        if ((s = (saidx_t)(d - c)) > (t = (saidx_t)(last - d - 1))) { s = t; }
+        for (e = b, f = last - s; 0 < s; --s, ++e, ++f) { SWAP(*e, *f); }
+        first += (b - a), last -= (d - c);
+    }
+    *pa = first, * pb = last;
+}
+
+static
+void
+tr_copy(sastore_t * ISA, const sastore_t * SA,
+    sastore_t * first, sastore_t * a, sastore_t * b, sastore_t * last,
+    saidx_t depth) {
+    /* sort suffixes of middle partition
+       by using sorted order of suffixes of left and right partition. */
+    sastore_t* c, * d, * e;
+    saidx_t s, v;
+
+    v = (saidx_t)(b - SA - 1);
+    for (c = first, d = a - 1; c <= d; ++c) {
+        if ((0 <= (s = *c - depth)) && (ISA[s] == v)) {
+            *++d = s;
+            ISA[s] = (saidx_t)(d - SA);
+        }
+    }
+    for (c = last - 1, e = d + 1, d = b; e < d; --c) {
+        if ((0 <= (s = *c - depth)) && (ISA[s] == v)) {
+            *--d = s;
+            ISA[s] = (saidx_t)(d - SA);
+        }
+    }
+}
+
+static
+void
+tr_partialcopy(sastore_t * ISA, const sastore_t * SA,
+    sastore_t * first, sastore_t * a, sastore_t * b, sastore_t * last,
+    saidx_t depth) {
+    sastore_t* c, * d, * e;
+    saidx_t s, v;
+    saidx_t rank, lastrank, newrank = -1;
+
+    v = (saidx_t)(b - SA - 1);
+    lastrank = -1;
+    for (c = first, d = a - 1; c <= d; ++c) {
+        if ((0 <= (s = *c - depth)) && (ISA[s] == v)) {
+            *++d = s;
+            rank = ISA[s + depth];
+            if (lastrank != rank) { lastrank = rank; newrank = (saidx_t)(d - SA); }
+            ISA[s] = newrank;
+        }
+    }
+
+    lastrank = -1;
+    for (e = d; first <= e; --e) {
+        rank = ISA[*e];
+        if (lastrank != rank) { lastrank = rank; newrank = (saidx_t)(e - SA); }
+        if (newrank != rank) { ISA[*e] = newrank; }
+    }
+
+    lastrank = -1;
+    for (c = last - 1, e = d + 1, d = b; e < d; --c) {
+        if ((0 <= (s = *c - depth)) && (ISA[s] == v)) {
+            *--d = s;
+            rank = ISA[s + depth];
+            if (lastrank != rank) { lastrank = rank; newrank = (saidx_t)(d - SA); }
+            ISA[s] = newrank;
+        }
+    }
+}
+
+static
+void
+tr_introsort(sastore_t * ISA, const sastore_t * ISAd,
+    sastore_t * SA, sastore_t * first, sastore_t * last,
+    trbudget_t * budget) {
+#define STACK_SIZE TR_STACKSIZE
+    struct { const sastore_t* a; sastore_t* b, * c; saint_t d, e; }stack[STACK_SIZE];
+    sastore_t* a, * b, * c;
+    saidx_t t;
+    saidx_t v, x = 0;
+    saidx_t incr = (saidx_t)(ISAd - ISA);
+    saint_t limit, next;
+    saint_t ssize, trlink = -1;
+
+    for (ssize = 0, limit = tr_ilg((saidx_t)(last - first));;) {
+
+        if (limit < 0) {
+            if (limit == -1) {
+                /* tandem repeat partition */
+                tr_partition(ISAd - incr, first, first, last, &a, &b, (saidx_t)(last - SA - 1));
+
+                /* update ranks */
+                if (a < last) {
+                    for (c = first, v = (saidx_t)(a - SA - 1); c < a; ++c) { ISA[*c] = v; }
+                }
+                if (b < last) {
+                    for (c = a, v = (saidx_t)(b - SA - 1); c < b; ++c) { ISA[*c] = v; }
+                }
+
+                /* push */
+                if (1 < (b - a)) {
+                    STACK_PUSH5(NULL, a, b, 0, 0);
+                    STACK_PUSH5(ISAd - incr, first, last, -2, trlink);
+                    trlink = ssize - 2;
+                }
+                if ((a - first) <= (last - b)) {
+                    if (1 < (a - first)) {
+                        STACK_PUSH5(ISAd, b, last, tr_ilg((saidx_t)(last - b)), trlink);
+                        last = a, limit = tr_ilg((saidx_t)(a - first));
+                    }
+                    else if (1 < (last - b)) {
+                        first = b, limit = tr_ilg((saidx_t)(last - b));
+                    }
+                    else {
+                        STACK_POP5(ISAd, first, last, limit, trlink);
+                    }
+                }
+                else {
+                    if (1 < (last - b)) {
+                        STACK_PUSH5(ISAd, first, a, tr_ilg((saidx_t)(a - first)), trlink);
+                        first = b, limit = tr_ilg((saidx_t)(last - b));
+                    }
+                    else if (1 < (a - first)) {
+                        last = a, limit = tr_ilg((saidx_t)(a - first));
+                    }
+                    else {
+                        STACK_POP5(ISAd, first, last, limit, trlink);
+                    }
+                }
+            }
+            else if (limit == -2) {
+                /* tandem repeat copy */
+                a = stack[--ssize].b, b = stack[ssize].c;
+                if (stack[ssize].d == 0) {
+                    tr_copy(ISA, SA, first, a, b, last, (saidx_t)(ISAd - ISA));
+                }
+                else {
+                    if (0 <= trlink) { stack[trlink].d = -1; }
+                    tr_partialcopy(ISA, SA, first, a, b, last, (saidx_t)(ISAd - ISA));
+                }
+                STACK_POP5(ISAd, first, last, limit, trlink);
+            }
+            else {
+                /* sorted partition */
+                if (0 <= *first) {
+                    a = first;
+                    do { ISA[*a] = (saidx_t)(a - SA); } while ((++a < last) && (0 <= *a));
+                    first = a;
+                }
+                if (first < last) {
+                    a = first; do { *a = ~*a; } while (*++a < 0);
+                    next = (ISA[*a] != ISAd[*a]) ? tr_ilg((saidx_t)(a - first + 1)) : -1;
+                    if (++a < last) { for (b = first, v = (saidx_t)(a - SA - 1); b < a; ++b) { ISA[*b] = v; } }
+
+                    /* push */
+                    if (trbudget_check(budget, (saidx_t)(a - first))) {
+                        if ((a - first) <= (last - a)) {
+                            STACK_PUSH5(ISAd, a, last, -3, trlink);
+                            ISAd += incr, last = a, limit = next;
+                        }
+                        else {
+                            if (1 < (last - a)) {
+                                STACK_PUSH5(ISAd + incr, first, a, next, trlink);
+                                first = a, limit = -3;
+                            }
+                            else {
+                                ISAd += incr, last = a, limit = next;
+                            }
+                        }
+                    }
+                    else {
+                        if (0 <= trlink) { stack[trlink].d = -1; }
+                        if (1 < (last - a)) {
+                            first = a, limit = -3;
+                        }
+                        else {
+                            STACK_POP5(ISAd, first, last, limit, trlink);
+                        }
+                    }
+                }
+                else {
+                    STACK_POP5(ISAd, first, last, limit, trlink);
+                }
+            }
+            continue;
+        }
+
+        if ((last - first) <= TR_INSERTIONSORT_THRESHOLD) {
+            tr_insertionsort(ISAd, first, last);
+            limit = -3;
+            continue;
+        }
+
+        if (limit-- == 0) {
+            tr_heapsort(ISAd, first, (saidx_t)(last - first));
+            for (a = last - 1; first < a; a = b) {
+                for (x = ISAd[*a], b = a - 1; (first <= b) && (ISAd[*b] == x); --b) { *b = ~*b; }
+            }
+            limit = -3;
+            continue;
+        }
+
+        /* choose pivot */
+        a = tr_pivot(ISAd, first, last);
+        SWAP(*first, *a);
+        v = ISAd[*first];
+
+        /* partition */
+        tr_partition(ISAd, first, first + 1, last, &a, &b, v);
+        if ((last - first) != (b - a)) {
+            next = (ISA[*a] != v) ? tr_ilg((saidx_t)(b - a)) : -1;
+
+            /* update ranks */
+            for (c = first, v = (saidx_t)(a - SA - 1); c < a; ++c) { ISA[*c] = v; }
+            if (b < last) { for (c = a, v = (saidx_t)(b - SA - 1); c < b; ++c) { ISA[*c] = v; } }
+
+            /* push */
+            if ((1 < (b - a)) && (trbudget_check(budget, (saidx_t)(b - a)))) {
+                if ((a - first) <= (last - b)) {
+                    if ((last - b) <= (b - a)) {
+                        if (1 < (a - first)) {
+                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
+                            STACK_PUSH5(ISAd, b, last, limit, trlink);
+                            last = a;
+                        }
+                        else if (1 < (last - b)) {
+                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
+                            first = b;
+                        }
+                        else {
+                            ISAd += incr, first = a, last = b, limit = next;
+                        }
+                    }
+                    else if ((a - first) <= (b - a)) {
+                        if (1 < (a - first)) {
+                            STACK_PUSH5(ISAd, b, last, limit, trlink);
+                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
+                            last = a;
+                        }
+                        else {
+                            STACK_PUSH5(ISAd, b, last, limit, trlink);
+                            ISAd += incr, first = a, last = b, limit = next;
+                        }
+                    }
+                    else {
+                        STACK_PUSH5(ISAd, b, last, limit, trlink);
+                        STACK_PUSH5(ISAd, first, a, limit, trlink);
+                        ISAd += incr, first = a, last = b, limit = next;
+                    }
+                }
+                else {
+                    if ((a - first) <= (b - a)) {
+                        if (1 < (last - b)) {
+                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
+                            STACK_PUSH5(ISAd, first, a, limit, trlink);
+                            first = b;
+                        }
+                        else if (1 < (a - first)) {
+                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
+                            last = a;
+                        }
+                        else {
+                            ISAd += incr, first = a, last = b, limit = next;
+                        }
+                    }
+                    else if ((last - b) <= (b - a)) {
+                        if (1 < (last - b)) {
+                            STACK_PUSH5(ISAd, first, a, limit, trlink);
+                            STACK_PUSH5(ISAd + incr, a, b, next, trlink);
+                            first = b;
+                        }
+                        else {
+                            STACK_PUSH5(ISAd, first, a, limit, trlink);
+                            ISAd += incr, first = a, last = b, limit = next;
+                        }
+                    }
+                    else {
+                        STACK_PUSH5(ISAd, first, a, limit, trlink);
+                        STACK_PUSH5(ISAd, b, last, limit, trlink);
+                        ISAd += incr, first = a, last = b, limit = next;
+                    }
+                }
+            }
+            else {
+                if ((1 < (b - a)) && (0 <= trlink)) { stack[trlink].d = -1; }
+                if ((a - first) <= (last - b)) {
+                    if (1 < (a - first)) {
+                        STACK_PUSH5(ISAd, b, last, limit, trlink);
+                        last = a;
+                    }
+                    else if (1 < (last - b)) {
+                        first = b;
+                    }
+                    else {
+                        STACK_POP5(ISAd, first, last, limit, trlink);
+                    }
+                }
+                else {
+                    if (1 < (last - b)) {
+                        STACK_PUSH5(ISAd, first, a, limit, trlink);
+                        first = b;
+                    }
+                    else if (1 < (a - first)) {
+                        last = a;
+                    }
+                    else {
+                        STACK_POP5(ISAd, first, last, limit, trlink);
+                    }
+                }
+            }
+        }
+        else {
+            if (trbudget_check(budget, (saidx_t)(last - first))) {
+                limit = tr_ilg((saidx_t)(last - first)), ISAd += incr;
+            }
+            else {
+                if (0 <= trlink) { stack[trlink].d = -1; }
+                STACK_POP5(ISAd, first, last, limit, trlink);
+            }
+        }
+    }
+#undef STACK_SIZE
+}
+
+
+
+/*---------------------------------------------------------------------------*/
+
+/*- Function -*/
+
+/* Tandem repeat sort */
+static
+void
+trsort(sastore_t * ISA, sastore_t * SA, saidx_t n, saidx_t depth) {
+    sastore_t* ISAd;
+    sastore_t* first, * last;
+    trbudget_t budget;
+    saidx_t t, skip, unsorted;
+
+    trbudget_init(&budget, tr_ilg(n) * 2 / 3, n);
+    /*  trbudget_init(&budget, tr_ilg(n) * 3 / 4, n); */
+    for (ISAd = ISA + depth; -n < *SA; ISAd += ISAd - ISA) {
+        first = SA;
+        skip = 0;
+        unsorted = 0;
+        do {
+            if ((t = *first) < 0) { first -= t; skip += t; }
+            else {
+                if (skip != 0) { *(first + skip) = skip; skip = 0; }
+                last = SA + ISA[t] + 1;
+                if (1 < (last - first)) {
+                    budget.count = 0;
+                    tr_introsort(ISA, ISAd, SA, first, last, &budget);
+                    if (budget.count != 0) { unsorted += budget.count; }
+                    else { skip = (saidx_t)(first - last); }
+                }
+                else if ((last - first) == 1) {
+                    skip = -1;
+                }
+                first = last;
+            }
+        } while (first < (SA + n));
+        if (skip != 0) { *(first + skip) = skip; }
+        if (unsorted == 0) { break; }
+    }
+}
+
+/////#include "divsufsort_private.h"****************************
+
+
+
+/*- Private Functions -*/
+
+struct CHLocker {
+    HLocker locker;
+    inline CHLocker() :locker(0) { locker = locker_new(); }
+    inline ~CHLocker() { locker_delete(locker); }
+};
+
+
+
+
+
+
+
+
+
+
+
+
+
+#if (_IS_USED_MULTITHREAD)
+struct mt_data_t {
+    CHLocker            locker;
+    const sauchar_t* T;
+    sastore_t* SA;
+    const saidx_t* bucket_B;
+    const sastore_t* PAb;
+    saidx_t             bufsize;
+    saidx_t             n;
+    saidx_t             m;
+};
+
+#if (_IS_USED_CPP11THREAD)
+#   include <mutex>
+struct CAutoLocker :public _TLockerBox_name {
+    inline CAutoLocker(HLocker _locker)
+        :_TLockerBox_name() {
+        if (_locker) { _TLockerBox_name _t(*(std::mutex*)_locker); _t.swap(*this); }
+    }
+    inline ~CAutoLocker() { }
+};
+#else
+struct CAutoLocker :public TLockerBox {
+    inline CAutoLocker(HLocker _locker) { locker = _locker; if (locker) locker_enter(locker); }
+    inline ~CAutoLocker() { if (locker) locker_leave(locker); }
+};
+#endif
+
+static void _sssort_thread(saint_t * c0, saint_t * c1, saidx_t * j,
+    sastore_t * buf, mt_data_t * mt) {
+    saidx_t k = 0;
+    saidx_t l;
+    const saidx_t* bucket_B = mt->bucket_B;
+    for (;;) {
+        {
+            CAutoLocker __autoLocker(mt->locker.locker);
+            if (0 < (l = *j)) {
+                saint_t d0 = *c0, d1 = *c1;
+                do {
+                    k = BUCKET_BSTAR(d0, d1);
+                    if (--d1 <= d0) {
+                        d1 = ALPHABET_SIZE - 1;
+                        if (--d0 < 0) { break; }
+                    }
+                } while (((l - k) <= 1) && (0 < (l = k)));
+                *c0 = d0, * c1 = d1, * j = k;
+            }
+        }
+        if (l == 0) { break; }
+        sastore_t* SA = mt->SA;
+        sssort(mt->T, mt->PAb, SA + k, SA + l,
+            buf, mt->bufsize, 2, mt->n, *(SA + k) == (mt->m - 1));
+    }
+}
+#endif
+
+/* Sorts suffixes of type B*. */
+static
+saidx_t
+sort_typeBstar(const sauchar_t * T, sastore_t * SA,
+    saidx_t * bucket_A, saidx_t * bucket_B,
+    saidx_t n, int threadNum) {
+    sastore_t* PAb, * ISAb;
+    saidx_t i, j, k, t, m;
+    saint_t c0, c1;
+
+    /* Initialize bucket arrays. */
+    for (i = 0; i < BUCKET_A_SIZE; ++i) { bucket_A[i] = 0; }
+    for (i = 0; i < BUCKET_B_SIZE; ++i) { bucket_B[i] = 0; }
+
+    /* Count the number of occurrences of the first one or two characters of each
+       type A, B and B* suffix. Moreover, store the beginning position of all
+       type B* suffixes into the array SA. */
+    for (i = n - 1, m = n, c0 = T[n - 1]; 0 <= i;) {
+        /* type A suffix. */
+        do { ++BUCKET_A(c1 = c0); } while ((0 <= --i) && ((c0 = T[i]) >= c1));
+        if (0 <= i) {
+            /* type B* suffix. */
+            ++BUCKET_BSTAR(c0, c1);
+            SA[--m] = i;
+            /* type B suffix. */
+            for (--i, c1 = c0; (0 <= i) && ((c0 = T[i]) <= c1); --i, c1 = c0) {
+                ++BUCKET_B(c0, c1);
+            }
+        }
+    }
+    m = n - m;
+    /*
+    note:
+      A type B* suffix is lexicographically smaller than a type B suffix that
+      begins with the same first two characters.
+    */
+
+    /* Calculate the index of start/end point of each bucket. */
+    for (c0 = 0, i = 0, j = 0; c0 < ALPHABET_SIZE; ++c0) {
+        t = i + BUCKET_A(c0);
+        BUCKET_A(c0) = i + j; /* start point */
+        i = t + BUCKET_B(c0, c0);
+        for (c1 = c0 + 1; c1 < ALPHABET_SIZE; ++c1) {
+            j += BUCKET_BSTAR(c0, c1);
+            BUCKET_BSTAR(c0, c1) = j; /* end point */
+            i += BUCKET_B(c0, c1);
+        }
+    }
+
+    if (0 < m) {
+        /* Sort the type B* suffixes by their first two characters. */
+        PAb = SA + n - m; ISAb = SA + m;
+        for (i = m - 2; 0 <= i; --i) {
+            t = PAb[i], c0 = T[t], c1 = T[t + 1];
+            SA[--BUCKET_BSTAR(c0, c1)] = i;
+        }
+        t = PAb[m - 1], c0 = T[t], c1 = T[t + 1];
+        SA[--BUCKET_BSTAR(c0, c1)] = m - 1;
+
+        /* Sort the type B* substrings using sssort. */
+#if (_IS_USED_MULTITHREAD)
+        if (threadNum > 1) {
+            const saidx_t bufsize = (n - (2 * m)) / (saidx_t)threadNum;
+            const int threadCount = threadNum - 1;
+            c0 = ALPHABET_SIZE - 2, c1 = ALPHABET_SIZE - 1, j = m;
+            mt_data_t mt_data;
+            mt_data.T = T;
+            mt_data.SA = SA;
+            mt_data.bucket_B = bucket_B;
+            mt_data.PAb = PAb;
+            mt_data.bufsize = bufsize;
+            mt_data.n = n;
+            mt_data.m = m;
+            std::vector<std::thread> threads(threadCount);
+            sastore_t* buf = SA + m;
+            for (int ti = 0; ti < threadCount; ++ti, buf += bufsize) {
+                threads[ti] = std::thread(_sssort_thread, &c0, &c1, &j, buf, &mt_data);
+            }
+            _sssort_thread(&c0, &c1, &j, buf, &mt_data);
+            for (int ti = 0; ti < threadCount; ++ti)
+                threads[ti].join();
+        }
+        else
+#endif
+        {
+            sastore_t* buf = SA + m;
+            saidx_t bufsize = n - (2 * m);
+            for (c0 = ALPHABET_SIZE - 2, j = m; 0 < j; --c0) {
+                for (c1 = ALPHABET_SIZE - 1; c0 < c1; j = i, --c1) {
+                    i = BUCKET_BSTAR(c0, c1);
+                    if (1 < (j - i)) {
+                        sssort(T, PAb, SA + i, SA + j,
+                            buf, bufsize, 2, n, *(SA + i) == (m - 1));
+                    }
+                }
+            }
+        }
+
+        /* Compute ranks of type B* substrings. */
+        for (i = m - 1; 0 <= i; --i) {
+            if (0 <= SA[i]) {
+                j = i;
+                do { ISAb[SA[i]] = i; } while ((0 <= --i) && (0 <= SA[i]));
+                SA[i + 1] = i - j;
+                if (i <= 0) { break; }
+            }
+            j = i;
+            do { ISAb[SA[i] = ~SA[i]] = j; } while (SA[--i] < 0);
+            ISAb[SA[i]] = j;
+        }
+
+        /* Construct the inverse suffix array of type B* suffixes using trsort. */
+        trsort(ISAb, SA, m, 1);
+
+        /* Set the sorted order of tyoe B* suffixes. */
+        for (i = n - 1, j = m, c0 = T[n - 1]; 0 <= i;) {
+            for (--i, c1 = c0; (0 <= i) && ((c0 = T[i]) >= c1); --i, c1 = c0) {}
+            if (0 <= i) {
+                t = i;
+                for (--i, c1 = c0; (0 <= i) && ((c0 = T[i]) <= c1); --i, c1 = c0) {}
+                SA[ISAb[--j]] = ((t == 0) || (1 < (t - i))) ? t : ~t;
+            }
+        }
+
+        /* Calculate the index of start/end point of each bucket. */
+        BUCKET_B(ALPHABET_SIZE - 1, ALPHABET_SIZE - 1) = n; /* end point */
+        for (c0 = ALPHABET_SIZE - 2, k = m - 1; 0 <= c0; --c0) {
+            i = BUCKET_A(c0 + 1) - 1;
+            for (c1 = ALPHABET_SIZE - 1; c0 < c1; --c1) {
+                t = i - BUCKET_B(c0, c1);
+                BUCKET_B(c0, c1) = i; /* end point */
+
+                /* Move all type B* suffixes to the correct position. */
+                for (i = t, j = BUCKET_BSTAR(c0, c1);
+                    j <= k;
+                    --i, --k) {
+                    SA[i] = SA[k];
+                }
+            }
+            BUCKET_BSTAR(c0, c0 + 1) = i - BUCKET_B(c0, c0) + 1; /* start point */
+            BUCKET_B(c0, c0) = i; /* end point */
+        }
+    }
+
+    return m;
+}
+
+/* Constructs the suffix array by using the sorted order of type B* suffixes. */
+static
+void
+construct_SA(const sauchar_t * T, sastore_t * SA,
+    saidx_t * bucket_A, saidx_t * bucket_B,
+    saidx_t n, saidx_t m) {
+    sastore_t* i, * j, * k;
+    saidx_t s;
+    saint_t c0, c1, c2;
+
+    if (0 < m) {
+        /* Construct the sorted order of type B suffixes by using
+           the sorted order of type B* suffixes. */
+        for (c1 = ALPHABET_SIZE - 2; 0 <= c1; --c1) {
+            /* Scan the suffix array from right to left. */
+            for (i = SA + BUCKET_BSTAR(c1, c1 + 1),
+                j = SA + BUCKET_A(c1 + 1) - 1, k = NULL, c2 = -1;
+                i <= j;
+                --j) {
+                if (0 < (s = *j)) {
+                    assert(T[s] == c1);
+                    assert(((s + 1) < n) && (T[s] <= T[s + 1]));
+                    assert(T[s - 1] <= T[s]);
+                    *j = ~s;
+                    c0 = T[--s];
+                    if ((0 < s) && (T[s - 1] > c0)) { s = ~s; }
+                    if (c0 != c2) {
+                        if (0 <= c2) { BUCKET_B(c2, c1) = (saidx_t)(k - SA); }
+                        k = SA + BUCKET_B(c2 = c0, c1);
+                    }
+                    assert(k < j);
+                    *k-- = s;
+                }
+                else {
+                    assert(((s == 0) && (T[s] == c1)) || (s < 0));
+                    *j = ~s;
+                }
+            }
+        }
+    }
+
+    /* Construct the suffix array by using
+       the sorted order of type B suffixes. */
+    k = SA + BUCKET_A(c2 = T[n - 1]);
+    *k++ = (T[n - 2] < c2) ? ~(n - 1) : (n - 1);
+    /* Scan the suffix array from left to right. */
+    for (i = SA, j = SA + n; i < j; ++i) {
+        if (0 < (s = *i)) {
+            assert(T[s - 1] >= T[s]);
+            c0 = T[--s];
+            if ((s == 0) || (T[s - 1] < c0)) { s = ~s; }
+            if (c0 != c2) {
+                BUCKET_A(c2) = (saidx_t)(k - SA);
+                k = SA + BUCKET_A(c2 = c0);
+            }
+            assert(i < k);
+            *k++ = s;
+        }
+        else {
+            assert(s < 0);
+            *i = ~s;
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*- Function -*/
+static
+saint_t
+divsufsort(const sauchar_t * T, sastore_t * SA, saidx_t n, int threadNum) {
+    saidx_t* bucket_A, * bucket_B;
+    saidx_t m;
+    saint_t err = 0;
+
+    /* Check arguments. */
+    if ((T == NULL) || (SA == NULL) || (n < 0)) { return -1; }
+    else if (n == 0) { return 0; }
+    else if (n == 1) { SA[0] = 0; return 0; }
+    else if (n == 2) { m = (T[0] < T[1]); SA[m ^ 1] = 0, SA[m] = 1; return 0; }
+
+    bucket_A = (saidx_t*)malloc(BUCKET_A_SIZE * sizeof(saidx_t));
+    bucket_B = (saidx_t*)malloc(BUCKET_B_SIZE * sizeof(saidx_t));
+
+    /* Suffixsort. */
+    if ((bucket_A != NULL) && (bucket_B != NULL)) {
+        m = sort_typeBstar(T, SA, bucket_A, bucket_B, n, threadNum);
+        construct_SA(T, SA, bucket_A, bucket_B, n, m);
+    }
+    else {
+        err = -2;
+    }
+
+    free(bucket_B);
+    free(bucket_A);
+
+    return err;
+}
+
+static
+const char*
+divsufsort_version(void) {
+    return PROJECT_VERSION_FULL;
+}
+
+/////#include "sssort.c.inc.h"****************
+#if (SS_BLOCKSIZE == 0) || (SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE)
+
+static INLINE
+saint_t
+ss_ilg(saidx_t n) {
+#if SS_BLOCKSIZE == 0
+    return tr_ilg(n);
+#elif SS_BLOCKSIZE < 256
+    return lg_table[n];
+#else
+    return (n & 0xff00) ?
+        8 + lg_table[(n >> 8) & 0xff] :
+        0 + lg_table[(n >> 0) & 0xff];
+#endif
+}
+
+#endif /* (SS_BLOCKSIZE == 0) || (SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE) */
+
+#if SS_BLOCKSIZE != 0
+
+static const saint_t sqq_table[256] = {
+  0,  16,  22,  27,  32,  35,  39,  42,  45,  48,  50,  53,  55,  57,  59,  61,
+ 64,  65,  67,  69,  71,  73,  75,  76,  78,  80,  81,  83,  84,  86,  87,  89,
+ 90,  91,  93,  94,  96,  97,  98,  99, 101, 102, 103, 104, 106, 107, 108, 109,
+110, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126,
+128, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142,
+143, 144, 144, 145, 146, 147, 148, 149, 150, 150, 151, 152, 153, 154, 155, 155,
+156, 157, 158, 159, 160, 160, 161, 162, 163, 163, 164, 165, 166, 167, 167, 168,
+169, 170, 170, 171, 172, 173, 173, 174, 175, 176, 176, 177, 178, 178, 179, 180,
+181, 181, 182, 183, 183, 184, 185, 185, 186, 187, 187, 188, 189, 189, 190, 191,
+192, 192, 193, 193, 194, 195, 195, 196, 197, 197, 198, 199, 199, 200, 201, 201,
+202, 203, 203, 204, 204, 205, 206, 206, 207, 208, 208, 209, 209, 210, 211, 211,
+212, 212, 213, 214, 214, 215, 215, 216, 217, 217, 218, 218, 219, 219, 220, 221,
+221, 222, 222, 223, 224, 224, 225, 225, 226, 226, 227, 227, 228, 229, 229, 230,
+230, 231, 231, 232, 232, 233, 234, 234, 235, 235, 236, 236, 237, 237, 238, 238,
+239, 240, 240, 241, 241, 242, 242, 243, 243, 244, 244, 245, 245, 246, 246, 247,
+247, 248, 248, 249, 249, 250, 250, 251, 251, 252, 252, 253, 253, 254, 254, 255
+};
+
+static INLINE
+saidx_t
+ss_isqrt(saidx_t x) {
+    saidx_t y, e;
+
+    if (x >= (SS_BLOCKSIZE * SS_BLOCKSIZE)) { return SS_BLOCKSIZE; }
+    e = (x & 0xffff0000) ?
+        ((x & 0xff000000) ?
+            24 + lg_table[(x >> 24) & 0xff] :
+            16 + lg_table[(x >> 16) & 0xff]) :
+        ((x & 0x0000ff00) ?
+            8 + lg_table[(x >> 8) & 0xff] :
+            0 + lg_table[(x >> 0) & 0xff]);
+
+    if (e >= 16) {
+        y = sqq_table[x >> ((e - 6) - (e & 1))] << ((e >> 1) - 7);
+        if (e >= 24) { y = (y + 1 + x / y) >> 1; }
+        y = (y + 1 + x / y) >> 1;
+    }
+    else if (e >= 8) {
+        y = (sqq_table[x >> ((e - 6) - (e & 1))] >> (7 - (e >> 1))) + 1;
+    }
+    else {
+        return sqq_table[x] >> 4;
+    }
+
+    return (x < (y* y)) ? y - 1 : y;
+}
+
+#endif /* SS_BLOCKSIZE != 0 */
+
+
+/*---------------------------------------------------------------------------*/
+
+/* Compares two suffixes. */
+static INLINE
+saint_t
+ss_compare(const sauchar_t * T,
+    const sastore_t * p1, const sastore_t * p2,
+    saidx_t depth) {
+    const sauchar_t* U1, * U2, * U1n, * U2n;
+
+    for (U1 = T + depth + *p1,
+        U2 = T + depth + *p2,
+        U1n = T + *(p1 + 1) + 2,
+        U2n = T + *(p2 + 1) + 2;
+        (U1 < U1n) && (U2 < U2n) && (*U1 == *U2);
+        ++U1, ++U2) {
+    }
+
+    return U1 < U1n ?
+        (U2 < U2n ? *U1 - *U2 : 1) :
+        (U2 < U2n ? -1 : 0);
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+#if (SS_BLOCKSIZE != 1) && (SS_INSERTIONSORT_THRESHOLD != 1)
+
+/* Insertionsort for small size groups */
+static
+void
+ss_insertionsort(const sauchar_t * T, const sastore_t * PA,
+    sastore_t * first, sastore_t * last, saidx_t depth) {
+    sastore_t* i, * j;
+    saidx_t t;
+    saint_t r;
+
+    for (i = last - 2; first <= i; --i) {
+        for (t = *i, j = i + 1; 0 < (r = ss_compare(T, PA + t, PA + *j, depth));) {
+            do { *(j - 1) = *j; } while ((++j < last) && (*j < 0));
+            if (last <= j) { break; }
+        }
+        if (r == 0) { *j = ~*j; }
+        *(j - 1) = t;
+    }
+}
+
+#endif /* (SS_BLOCKSIZE != 1) && (SS_INSERTIONSORT_THRESHOLD != 1) */
+
+
+/*---------------------------------------------------------------------------*/
+
+#if (SS_BLOCKSIZE == 0) || (SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE)
+
+static INLINE
+void
+ss_fixdown(const sauchar_t * Td, const sastore_t * PA,
+    sastore_t * SA, saidx_t i, saidx_t size) {
+    saidx_t j, k;
+    saidx_t v;
+    saint_t c, d, e;
+
+    for (v = SA[i], c = Td[PA[v]]; (j = 2 * i + 1) < size; SA[i] = SA[k], i = k) {
+        d = Td[PA[SA[k = j++]]];
+        if (d < (e = Td[PA[SA[j]]])) { k = j; d = e; }
+        if (d <= c) { break; }
+    }
+    SA[i] = v;
+}
+
+/* Simple top-down heapsort. */
+static
+void
+ss_heapsort(const sauchar_t * Td, const sastore_t * PA, sastore_t * SA, saidx_t size) {
+    saidx_t i, m;
+    saidx_t t;
+
+    m = size;
+    if ((size % 2) == 0) {
+        m--;
+        if (Td[PA[SA[m / 2]]] < Td[PA[SA[m]]]) { SWAP(SA[m], SA[m / 2]); }
+    }
+
+    for (i = m / 2 - 1; 0 <= i; --i) { ss_fixdown(Td, PA, SA, i, m); }
+    if ((size % 2) == 0) { SWAP(SA[0], SA[m]); ss_fixdown(Td, PA, SA, 0, m); }
+    for (i = m - 1; 0 < i; --i) {
+        t = SA[0], SA[0] = SA[i];
+        ss_fixdown(Td, PA, SA, 0, i);
+        SA[i] = t;
+    }
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/* Returns the median of three elements. */
+static INLINE
+sastore_t*
+ss_median3(const sauchar_t * Td, const sastore_t * PA,
+    sastore_t * v1, sastore_t * v2, sastore_t * v3) {
+    sastore_t* t;
+    if (Td[PA[*v1]] > Td[PA[*v2]]) { SWAP(v1, v2); }
+    if (Td[PA[*v2]] > Td[PA[*v3]]) {
+        if (Td[PA[*v1]] > Td[PA[*v3]]) { return v1; }
+        else { return v3; }
+    }
+    return v2;
+}
+
+/* Returns the median of five elements. */
+static INLINE
+sastore_t*
+ss_median5(const sauchar_t * Td, const sastore_t * PA,
+    sastore_t * v1, sastore_t * v2, sastore_t * v3, sastore_t * v4, sastore_t * v5) {
+    sastore_t* t;
+    if (Td[PA[*v2]] > Td[PA[*v3]]) { SWAP(v2, v3); }
+    if (Td[PA[*v4]] > Td[PA[*v5]]) { SWAP(v4, v5); }
+    if (Td[PA[*v2]] > Td[PA[*v4]]) { SWAP(v2, v4); SWAP(v3, v5); }
+    if (Td[PA[*v1]] > Td[PA[*v3]]) { SWAP(v1, v3); }
+    if (Td[PA[*v1]] > Td[PA[*v4]]) { SWAP(v1, v4); SWAP(v3, v5); }
+    if (Td[PA[*v3]] > Td[PA[*v4]]) { return v4; }
+    return v3;
+}
+
+/* Returns the pivot element. */
+static INLINE
+sastore_t*
+ss_pivot(const sauchar_t * Td, const sastore_t * PA, sastore_t * first, sastore_t * last) {
+    sastore_t* middle;
+    saidx_t t;
+
+    t = (saidx_t)(last - first);
+    middle = first + t / 2;
+
+    if (t <= 512) {
+        if (t <= 32) {
+            return ss_median3(Td, PA, first, middle, last - 1);
+        }
+        else {
+            t >>= 2;
+            return ss_median5(Td, PA, first, first + t, middle, last - 1 - t, last - 1);
+        }
+    }
+    t >>= 3;
+    first = ss_median3(Td, PA, first, first + t, first + (t << 1));
+    middle = ss_median3(Td, PA, middle - t, middle, middle + t);
+    last = ss_median3(Td, PA, last - 1 - (t << 1), last - 1 - t, last - 1);
+    return ss_median3(Td, PA, first, middle, last);
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/* Binary partition for substrings. */
+static INLINE
+sastore_t*
+ss_partition(const sastore_t * PA,
+    sastore_t * first, sastore_t * last, saidx_t depth) {
+    sastore_t* a, * b;
+    saidx_t t;
+    for (a = first - 1, b = last;;) {
+        for (; (++a < b) && ((PA[*a] + depth) >= (PA[*a + 1] + 1));) { *a = ~*a; }
+        for (; (a < --b) && ((PA[*b] + depth) < (PA[*b + 1] + 1));) {}
+        if (b <= a) { break; }
+        t = ~*b;
+        *b = *a;
+        *a = t;
+    }
+    if (first < a) { *first = ~*first; }
+    return a;
+}
+
+/* Multikey introsort for medium size groups. */
+static
+void
+ss_mintrosort(const sauchar_t * T, const sastore_t * PA,
+    sastore_t * first, sastore_t * last,
+    saidx_t depth) {
+#define STACK_SIZE SS_MISORT_STACKSIZE
+    struct { sastore_t* a, * b, c; saint_t d; } stack[STACK_SIZE];
+    const sauchar_t* Td;
+    sastore_t* a, * b, * c, * d, * e, * f;
+    saidx_t s, t;
+    saint_t ssize;
+    saint_t limit;
+    saint_t v, x = 0;
+
+    for (ssize = 0, limit = ss_ilg((saidx_t)(last - first));;) {
+
+        if ((last - first) <= SS_INSERTIONSORT_THRESHOLD) {
+#if 1 < SS_INSERTIONSORT_THRESHOLD
+            if (1 < (last - first)) { ss_insertionsort(T, PA, first, last, depth); }
+#endif
+            STACK_POP(first, last, depth, limit);
+            continue;
+        }
+
+        Td = T + depth;
+        if (limit-- == 0) { ss_heapsort(Td, PA, first, (saidx_t)(last - first)); }
+        if (limit < 0) {
+            for (a = first + 1, v = Td[PA[*first]]; a < last; ++a) {
+                if ((x = Td[PA[*a]]) != v) {
+                    if (1 < (a - first)) { break; }
+                    v = x;
+                    first = a;
+                }
+            }
+            if (Td[PA[*first] - 1] < v) {
+                first = ss_partition(PA, first, a, depth);
+            }
+            if ((a - first) <= (last - a)) {
+                if (1 < (a - first)) {
+                    STACK_PUSH(a, last, depth, -1);
+                    last = a, depth += 1, limit = ss_ilg((saidx_t)(a - first));
+                }
+                else {
+                    first = a, limit = -1;
+                }
+            }
+            else {
+                if (1 < (last - a)) {
+                    STACK_PUSH(first, a, depth + 1, ss_ilg((saidx_t)(a - first)));
+                    first = a, limit = -1;
+                }
+                else {
+                    last = a, depth += 1, limit = ss_ilg((saidx_t)(a - first));
+                }
+            }
+            continue;
+        }
+
+        /* choose pivot */
+        a = ss_pivot(Td, PA, first, last);
+        v = Td[PA[*a]];
+        SWAP(*first, *a);
+
+        /* partition */
+        for (b = first; (++b < last) && ((x = Td[PA[*b]]) == v);) {}
+        if (((a = b) < last) && (x < v)) {
+            for (; (++b < last) && ((x = Td[PA[*b]]) <= v);) {
+                if (x == v) { SWAP(*b, *a); ++a; }
+            }
+        }
+        for (c = last; (b < --c) && ((x = Td[PA[*c]]) == v);) {}
+        if ((b < (d = c)) && (x > v)) {
+            for (; (b < --c) && ((x = Td[PA[*c]]) >= v);) {
+                if (x == v) { SWAP(*c, *d); --d; }
+            }
+        }
+        for (; b < c;) {
+            SWAP(*b, *c);
+            for (; (++b < c) && ((x = Td[PA[*b]]) <= v);) {
+                if (x == v) { SWAP(*b, *a); ++a; }
+            }
+            for (; (b < --c) && ((x = Td[PA[*c]]) >= v);) {
+                if (x == v) { SWAP(*c, *d); --d; }
+            }
+        }
+
+        if (a <= d) {
+            c = b - 1;
+
+            if ((s = (saidx_t)(a - first)) > (t = (saidx_t)(b - a))) { s = t; }
+            for (e = first, f = b - s; 0 < s; --s, ++e, ++f) { SWAP(*e, *f); }
+            if ((s = (saidx_t)(d - c)) > (t = (saidx_t)(last - d - 1))) { s = t; }
+            for (e = b, f = last - s; 0 < s; --s, ++e, ++f) { SWAP(*e, *f); }
+
+            a = first + (b - a), c = last - (d - c);
+            b = (v <= Td[PA[*a] - 1]) ? a : ss_partition(PA, a, c, depth);
+
+            if ((a - first) <= (last - c)) {
+                if ((last - c) <= (c - b)) {
+                    STACK_PUSH(b, c, depth + 1, ss_ilg((saidx_t)(c - b)));
+                    STACK_PUSH(c, last, depth, limit);
+                    last = a;
+                }
+                else if ((a - first) <= (c - b)) {
+                    STACK_PUSH(c, last, depth, limit);
+                    STACK_PUSH(b, c, depth + 1, ss_ilg((saidx_t)(c - b)));
+                    last = a;
+                }
+                else {
+                    STACK_PUSH(c, last, depth, limit);
+                    STACK_PUSH(first, a, depth, limit);
+                    first = b, last = c, depth += 1, limit = ss_ilg((saidx_t)(c - b));
+                }
+            }
+            else {
+                if ((a - first) <= (c - b)) {
+                    STACK_PUSH(b, c, depth + 1, ss_ilg((saidx_t)(c - b)));
+                    STACK_PUSH(first, a, depth, limit);
+                    first = c;
+                }
+                else if ((last - c) <= (c - b)) {
+                    STACK_PUSH(first, a, depth, limit);
+                    STACK_PUSH(b, c, depth + 1, ss_ilg((saidx_t)(c - b)));
+                    first = c;
+                }
+                else {
+                    STACK_PUSH(first, a, depth, limit);
+                    STACK_PUSH(c, last, depth, limit);
+                    first = b, last = c, depth += 1, limit = ss_ilg((saidx_t)(c - b));
+                }
+            }
+        }
+        else {
+            limit += 1;
+            if (Td[PA[*first] - 1] < v) {
+                first = ss_partition(PA, first, last, depth);
+                limit = ss_ilg((saidx_t)(last - first));
+            }
+            depth += 1;
+        }
+    }
+#undef STACK_SIZE
+}
+
+#endif /* (SS_BLOCKSIZE == 0) || (SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE) */
+
+
+/*---------------------------------------------------------------------------*/
+
+#if SS_BLOCKSIZE != 0
+
+static INLINE
+void
+ss_blockswap(sastore_t * a, sastore_t * b, saidx_t n) {
+    saidx_t t;
+    for (; 0 < n; --n, ++a, ++b) {
+        t = *a, * a = *b, * b = t;
+    }
+}
+
+static INLINE
+void
+ss_rotate(sastore_t * first, sastore_t * middle, sastore_t * last) {
+    sastore_t* a, * b, t;
+    saidx_t l, r;
+    l = (saidx_t)(middle - first), r = (saidx_t)(last - middle);
+    for (; (0 < l) && (0 < r);) {
+        if (l == r) { ss_blockswap(first, middle, l); break; }
+        if (l < r) {
+            a = last - 1, b = middle - 1;
+            t = *a;
+            do {
+                *a-- = *b, * b-- = *a;
+                if (b < first) {
+                    *a = t;
+                    last = a;
+                    if ((r -= l + 1) <= l) { break; }
+                    a -= 1, b = middle - 1;
+                    t = *a;
+                }
+            } while (1);
+        }
+        else {
+            a = first, b = middle;
+            t = *a;
+            do {
+                *a++ = *b, * b++ = *a;
+                if (last <= b) {
+                    *a = t;
+                    first = a + 1;
+                    if ((l -= r + 1) <= r) { break; }
+                    a += 1, b = middle;
+                    t = *a;
+                }
+            } while (1);
+        }
+    }
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+static
+void
+ss_inplacemerge(const sauchar_t * T, const sastore_t * PA,
+    sastore_t * first, sastore_t * middle, sastore_t * last,
+    saidx_t depth) {
+    const sastore_t* p;
+    sastore_t* a, * b;
+    saidx_t len, half;
+    saint_t q, r;
+    saint_t x;
+
+    for (;;) {
+        if (*(last - 1) < 0) { x = 1; p = PA + ~*(last - 1); }
+        else { x = 0; p = PA + *(last - 1); }
+        for (a = first, len = (saidx_t)(middle - first), half = len >> 1, r = -1;
+            0 < len;
+            len = half, half >>= 1) {
+            b = a + half;
+            q = ss_compare(T, PA + ((0 <= *b) ? *b : ~*b), p, depth);
+            if (q < 0) {
+                a = b + 1;
+                half -= (len & 1) ^ 1;
+            }
+            else {
+                r = q;
+            }
+        }
+        if (a < middle) {
+            if (r == 0) { *a = ~*a; }
+            ss_rotate(a, middle, last);
+            last -= middle - a;
+            middle = a;
+            if (first == middle) { break; }
+        }
+        --last;
+        if (x != 0) { while (*--last < 0) {} }
+        if (middle == last) { break; }
+    }
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/* Merge-forward with internal buffer. */
+static
+void
+ss_mergeforward(const sauchar_t * T, const sastore_t * PA,
+    sastore_t * first, sastore_t * middle, sastore_t * last,
+    sastore_t * buf, saidx_t depth) {
+    sastore_t* a, * b, * c, * bufend;
+    saidx_t t;
+    saint_t r;
+
+    bufend = buf + (middle - first) - 1;
+    ss_blockswap(buf, first, (saidx_t)(middle - first));
+
+    for (t = *(a = first), b = buf, c = middle;;) {
+        r = ss_compare(T, PA + *b, PA + *c, depth);
+        if (r < 0) {
+            do {
+                *a++ = *b;
+                if (bufend <= b) { *bufend = t; return; }
+                *b++ = *a;
+            } while (*b < 0);
+        }
+        else if (r > 0) {
+            do {
+                *a++ = *c, * c++ = *a;
+                if (last <= c) {
+                    while (b < bufend) { *a++ = *b, * b++ = *a; }
+                    *a = *b, * b = t;
+                    return;
+                }
+            } while (*c < 0);
+        }
+        else {
+            *c = ~*c;
+            do {
+                *a++ = *b;
+                if (bufend <= b) { *bufend = t; return; }
+                *b++ = *a;
+            } while (*b < 0);
+
+            do {
+                *a++ = *c, * c++ = *a;
+                if (last <= c) {
+                    while (b < bufend) { *a++ = *b, * b++ = *a; }
+                    *a = *b, * b = t;
+                    return;
+                }
+            } while (*c < 0);
+        }
+    }
+}
+
+/* Merge-backward with internal buffer. */
+static
+void
+ss_mergebackward(const sauchar_t * T, const sastore_t * PA,
+    sastore_t * first, sastore_t * middle, sastore_t * last,
+    sastore_t * buf, saidx_t depth) {
+    const sastore_t* p1, * p2;
+    sastore_t* a, * b, * c, * bufend;
+    saidx_t t;
+    saint_t r;
+    saint_t x;
+
+    bufend = buf + (last - middle) - 1;
+    ss_blockswap(buf, middle, (saidx_t)(last - middle));
+
+    x = 0;
+    if (*bufend < 0) { p1 = PA + ~*bufend; x |= 1; }
+    else { p1 = PA + *bufend; }
+    if (*(middle - 1) < 0) { p2 = PA + ~*(middle - 1); x |= 2; }
+    else { p2 = PA + *(middle - 1); }
+    for (t = *(a = last - 1), b = bufend, c = middle - 1;;) {
+        r = ss_compare(T, p1, p2, depth);
+        if (0 < r) {
+            if (x & 1) { do { *a-- = *b, * b-- = *a; } while (*b < 0); x ^= 1; }
+            *a-- = *b;
+            if (b <= buf) { *buf = t; break; }
+            *b-- = *a;
+            if (*b < 0) { p1 = PA + ~*b; x |= 1; }
+            else { p1 = PA + *b; }
+        }
+        else if (r < 0) {
+            if (x & 2) { do { *a-- = *c, * c-- = *a; } while (*c < 0); x ^= 2; }
+            *a-- = *c, * c-- = *a;
+            if (c < first) {
+                while (buf < b) { *a-- = *b, * b-- = *a; }
+                *a = *b, * b = t;
+                break;
+            }
+            if (*c < 0) { p2 = PA + ~*c; x |= 2; }
+            else { p2 = PA + *c; }
+        }
+        else {
+            if (x & 1) { do { *a-- = *b, * b-- = *a; } while (*b < 0); x ^= 1; }
+            *a-- = ~*b;
+            if (b <= buf) { *buf = t; break; }
+            *b-- = *a;
+            if (x & 2) { do { *a-- = *c, * c-- = *a; } while (*c < 0); x ^= 2; }
+            *a-- = *c, * c-- = *a;
+            if (c < first) {
+                while (buf < b) { *a-- = *b, * b-- = *a; }
+                *a = *b, * b = t;
+                break;
+            }
+            if (*b < 0) { p1 = PA + ~*b; x |= 1; }
+            else { p1 = PA + *b; }
+            if (*c < 0) { p2 = PA + ~*c; x |= 2; }
+            else { p2 = PA + *c; }
+        }
+    }
+}
+
+/* D&C based merge. */
+static
+void
+ss_swapmerge(const sauchar_t * T, const sastore_t * PA,
+    sastore_t * first, sastore_t * middle, sastore_t * last,
+    sastore_t * buf, saidx_t bufsize, saidx_t depth) {
+#define STACK_SIZE SS_SMERGE_STACKSIZE
+#define GETIDX(a) ((0 <= (a)) ? (a) : (~(a)))
+#define MERGE_CHECK(a, b, c)\
+  do {\
+    if(((c) & 1) ||\
+       (((c) & 2) && (ss_compare(T, PA + GETIDX(*((a) - 1)), PA + *(a), depth) == 0))) {\
+      *(a) = ~*(a);\
+    }\
+    if(((c) & 4) && ((ss_compare(T, PA + GETIDX(*((b) - 1)), PA + *(b), depth) == 0))) {\
+      *(b) = ~*(b);\
+    }\
+  } while(0)
+    struct { sastore_t* a, * b, * c; saint_t d; } stack[STACK_SIZE];
+    sastore_t* l, * r, * lm, * rm;
+    saidx_t m, len, half;
+    saint_t ssize;
+    saint_t check, next;
+
+    for (check = 0, ssize = 0;;) {
+        if ((last - middle) <= bufsize) {
+            if ((first < middle) && (middle < last)) {
+                ss_mergebackward(T, PA, first, middle, last, buf, depth);
+            }
+            MERGE_CHECK(first, last, check);
+            STACK_POP(first, middle, last, check);
+            continue;
+        }
+
+        if ((middle - first) <= bufsize) {
+            if (first < middle) {
+                ss_mergeforward(T, PA, first, middle, last, buf, depth);
+            }
+            MERGE_CHECK(first, last, check);
+            STACK_POP(first, middle, last, check);
+            continue;
+        }
+
+        for (m = 0, len = (saidx_t)(MIN(middle - first, last - middle)), half = len >> 1;
+            0 < len;
+            len = half, half >>= 1) {
+            if (ss_compare(T, PA + GETIDX(*(middle + m + half)),
+                PA + GETIDX(*(middle - m - half - 1)), depth) < 0) {
+                m += half + 1;
+                half -= (len & 1) ^ 1;
+            }
+        }
+
+        if (0 < m) {
+            lm = middle - m, rm = middle + m;
+            ss_blockswap(lm, middle, m);
+            l = r = middle, next = 0;
+            if (rm < last) {
+                if (*rm < 0) {
+                    *rm = ~*rm;
+                    if (first < lm) { for (; *--l < 0;) {} next |= 4; }
+                    next |= 1;
+                }
+                else if (first < lm) {
+                    for (; *r < 0; ++r) {}
+                    next |= 2;
+                }
+            }
+
+            if ((l - first) <= (last - r)) {
+                STACK_PUSH(r, rm, last, (next & 3) | (check & 4));
+                middle = lm, last = l, check = (check & 3) | (next & 4);
+            }
+            else {
+                if ((next & 2) && (r == middle)) { next ^= 6; }
+                STACK_PUSH(first, lm, l, (check & 3) | (next & 4));
+                first = r, middle = rm, check = (next & 3) | (check & 4);
+            }
+        }
+        else {
+            if (ss_compare(T, PA + GETIDX(*(middle - 1)), PA + *middle, depth) == 0) {
+                *middle = ~*middle;
+            }
+            MERGE_CHECK(first, last, check);
+            STACK_POP(first, middle, last, check);
+        }
+    }
+#undef STACK_SIZE
+}
+
+#endif /* SS_BLOCKSIZE != 0 */
+
+/* Substring sort */
+static
+void
+sssort(const sauchar_t * T, const sastore_t * PA,
+    sastore_t * first, sastore_t * last,
+    sastore_t * buf, saidx_t bufsize,
+    saidx_t depth, saidx_t n, saint_t lastsuffix) {
+    sastore_t* a;
+#if SS_BLOCKSIZE != 0
+    sastore_t* b, * middle, * curbuf;
+    saidx_t j, k, curbufsize, limit;
+#endif
+    saidx_t i;
+
+    if (lastsuffix != 0) { ++first; }
+
+#if SS_BLOCKSIZE == 0
+    ss_mintrosort(T, PA, first, last, depth);
+#else
+    if ((bufsize < SS_BLOCKSIZE) &&
+        (bufsize < (last - first)) &&
+        (bufsize < (limit = ss_isqrt((saidx_t)(last - first))))) {
+        if (SS_BLOCKSIZE < limit) { limit = SS_BLOCKSIZE; }
+        buf = middle = last - limit, bufsize = limit;
+    }
+    else {
+        middle = last, limit = 0;
+    }
+    for (a = first, i = 0; SS_BLOCKSIZE < (middle - a); a += SS_BLOCKSIZE, ++i) {
+#if SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE
+        ss_mintrosort(T, PA, a, a + SS_BLOCKSIZE, depth);
+#elif 1 < SS_BLOCKSIZE
+        ss_insertionsort(T, PA, a, a + SS_BLOCKSIZE, depth);
+#endif
+        curbufsize = (saidx_t)(last - (a + SS_BLOCKSIZE));
+        curbuf = a + SS_BLOCKSIZE;
+        if (curbufsize <= bufsize) { curbufsize = bufsize, curbuf = buf; }
+        for (b = a, k = SS_BLOCKSIZE, j = i; j & 1; b -= k, k <<= 1, j >>= 1) {
+            ss_swapmerge(T, PA, b - k, b, b + k, curbuf, curbufsize, depth);
+        }
+    }
+#if SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE
+    ss_mintrosort(T, PA, a, middle, depth);
+#elif 1 < SS_BLOCKSIZE
+    ss_insertionsort(T, PA, a, middle, depth);
+#endif
+    for (k = SS_BLOCKSIZE; i != 0; k <<= 1, i >>= 1) {
+        if (i & 1) {
+            ss_swapmerge(T, PA, a - k, a, middle, buf, bufsize, depth);
+            a -= k;
+        }
+    }
+    if (limit != 0) {
+#if SS_INSERTIONSORT_THRESHOLD < SS_BLOCKSIZE
+        ss_mintrosort(T, PA, middle, last, depth);
+#elif 1 < SS_BLOCKSIZE
+        ss_insertionsort(T, PA, middle, last, depth);
+#endif
+        ss_inplacemerge(T, PA, first, middle, last, depth);
+    }
+#endif
+
+    if (lastsuffix != 0) {
+        /* Insert last type B* suffix. */
+        sastore_t PAi[2]; PAi[0] = PA[*(first - 1)], PAi[1] = n - 2;
+        for (a = first, i = *(first - 1);
+            (a < last) && ((*a < 0) || (0 < ss_compare(T, &(PAi[0]), PA + *a, depth)));
+            ++a) {
+            *(a - 1) = *a;
+        }
+        *(a - 1) = i;
+    }
+}
+
+
+static unsigned char* BWT(const unsigned char* T, const int32_t* sa, const int n) {
+    unsigned char* bwt = new unsigned char[n];
+    for (int i = 0; i < n; i++) {
+        if (sa[i] == 0) {
+            bwt[i] = T[n - 1];
+        }
+        else {
+            bwt[i] = T[sa[i] - 1];
+        }
+    }
+    return bwt;
+}
+
+
+static std::vector<std::tuple<std::string, uint8_t*, unsigned int>> read_fasta(const std::string& filename) {
+    std::ifstream input_file(filename);
+    std::vector<std::tuple<std::string, uint8_t*, unsigned int>> sequences;
+
+    std::string line, sequence_name;
+    uint8_t* sequence_data = nullptr;
+    unsigned int sequence_length = 0;
+
+    while (std::getline(input_file, line)) {
+        if (line[0] == '>') {
+            if (sequence_data != nullptr) {
+                sequences.emplace_back(std::make_tuple(sequence_name, sequence_data, sequence_length));
+                sequence_data = nullptr;
+            }
+
+            sequence_name = line.substr(1);
+            sequence_length = 0;
+        }
+        else {
+            if (sequence_data == nullptr) {
+                sequence_data = new uint8_t[line.length() + 1];
+            }
+            else {
+                uint8_t* temp = new uint8_t[sequence_length + line.length() + 1];
+                std::memcpy(temp, sequence_data, sequence_length);
+                delete[] sequence_data;
+                sequence_data = temp;
+            }
+
+            std::memcpy(sequence_data + sequence_length, line.c_str(), line.length());
+            sequence_length += line.length();
+        }
+    }
+
+    if (sequence_data != nullptr) {
+        sequences.emplace_back(std::make_tuple(sequence_name, sequence_data, sequence_length));
+    }
+
+    return sequences;
+}
+
+static void outputFasta(std::vector<std::tuple<std::string, uint8_t*, unsigned int>>& seqs) {
+    for (const auto& seq : seqs) {
+        std::cout << ">" << std::get<0>(seq) << " len=" << std::get<2>(seq) << std::endl;
+        uint8_t* data = std::get<1>(seq);
+        unsigned int len = std::get<2>(seq);
+        for (unsigned int i = 0; i < len; i += 80) {
+            unsigned int end = i + 80;
+            if (end > len) end = len;
+            std::cout.write((char*)(data + i), end - i);
+            std::cout << std::endl;
+        }
+    }
+}
+
+
+
+
+// سڴֵλֽڣ
+static size_t get_peak_memory() {
+    size_t peakMem = 0;
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc));
+    peakMem = pmc.PeakWorkingSetSize;
+#elif defined(__linux__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    peakMem = usage.ru_maxrss * 1024L;
+#elif defined(__APPLE__)
+    struct mach_task_basic_info info;
+    mach_msg_type_number_t size = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &size) != KERN_SUCCESS) {
+        return 0;
+    }
+    peakMem = info.resident_size_peak;
+#endif
+    return peakMem;
+}
+
+// Function to get current memory usage in bytes
+static size_t getCurrentMemoryUsage() {
+    size_t mem = 0;
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        mem = pmc.WorkingSetSize;
+    }
+#elif defined(__linux__)
+    long rss = 0;
+    FILE* fp = fopen("/proc/self/statm", "r");
+    if (fp != nullptr) {
+        if (fscanf(fp, "%*s%ld", &rss) != 1) {
+            rss = 0;
+        }
+        fclose(fp);
+        mem = (size_t)rss * (size_t)sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return mem;
+}
@@ -0,0 +1,112 @@
+#pragma once
+// Suffix array construction by induced sorting (SA-IS, Nong, Zhang & Chan 2009) for any signed index type;
+// divsufsort only covers 32-bit indexes
+#include <algorithm>
+#include <vector>
+
+namespace suffix_array
+{
+    // Function to build the suffix array SA of T[0, n) over the alphabet [0, K). T[n - 1] must be the
+    // only occurrence of the smallest symbol (the end mark), which also holds for the reduced strings.
+    template<typename index_type, typename char_type>
+    void sais(const char_type* T, index_type* SA, index_type n, index_type K)
+    {
+        if (n == 1)
+        {
+            SA[0] = 0;
+            return;
+        }
+
+        // S-type (true) or L-type (false) of every suffix
+        std::vector<bool> stype(n);
+        stype[n - 1] = true;
+        for (index_type i = n - 2; i >= 0; --i)
+            stype[i] = T[i] < T[i + 1] || (T[i] == T[i + 1] && stype[i + 1]);
+        auto is_lms = [&stype](index_type i) { return i > 0 && stype[i] && !stype[i - 1]; };
+
+        std::vector<index_type> bucket(K);
+        auto get_buckets = [&](bool ends) {
+            std::fill(bucket.begin(), bucket.end(), 0);
+            for (index_type i = 0; i != n; ++i)
+                ++bucket[T[i]];
+            for (index_type c = 0, sum = 0; c != K; ++c)
+            {
+                sum += bucket[c];
+                bucket[c] = ends ? sum : sum - bucket[c];
+            }
+        };
+        // Sort L-type suffixes from the left, then S-type suffixes from the right
+        auto induce = [&]() {
+            get_buckets(false);
+            for (index_type i = 0; i != n; ++i)
+                if (SA[i] > 0 && !stype[SA[i] - 1])
+                    SA[bucket[T[SA[i] - 1]]++] = SA[i] - 1;
+            get_buckets(true);
+            for (index_type i = n - 1; i >= 0; --i)
+                if (SA[i] > 0 && stype[SA[i] - 1])
+                    SA[--bucket[T[SA[i] - 1]]] = SA[i] - 1;
+        };
+
+        // Sort the LMS substrings
+        std::fill(SA, SA + n, index_type(-1));
+        get_buckets(true);
+        for (index_type i = 1; i != n; ++i)
+            if (is_lms(i))
+                SA[--bucket[T[i]]] = i;
+        induce();
+
+        // Name them in sorted order; names go to the upper half, indexed by position / 2
+        index_type n1 = 0;
+        for (index_type i = 0; i != n; ++i)
+            if (is_lms(SA[i]))
+                SA[n1++] = SA[i];
+        std::fill(SA + n1, SA + n, index_type(-1));
+        index_type name = 0, prev = -1;
+        for (index_type i = 0; i != n1; ++i)
+        {
+            const index_type pos = SA[i];
+            bool diff = false;
+            for (index_type d = 0; d != n; ++d)
+                if (prev == -1 || T[pos + d] != T[prev + d] || stype[pos + d] != stype[prev + d])
+                {
+                    diff = true;
+                    break;
+                }
+                else if (d > 0 && (is_lms(pos + d) || is_lms(prev + d)))
+                    break;
+            if (diff)
+            {
+                ++name;
+                prev = pos;
+            }
+            SA[n1 + pos / 2] = name - 1;
+        }
+        for (index_type i = n - 1, j = n - 1; i >= n1; --i)
+            if (SA[i] >= 0)
+                SA[j--] = SA[i];
+
+        // Sort the reduced string, recursing while names repeat
+        index_type* s1 = SA + n - n1;
+        if (name < n1)
+            sais<index_type, index_type>(s1, SA, n1, name);
+        else
+            for (index_type i = 0; i != n1; ++i)
+                SA[s1[i]] = i;
+
+        // Place the sorted LMS suffixes and induce the rest
+        get_buckets(true);
+        for (index_type i = 1, j = 0; i != n; ++i)
+            if (is_lms(i))
+                s1[j++] = i;
+        for (index_type i = 0; i != n1; ++i)
+            SA[i] = s1[SA[i]];
+        std::fill(SA + n1, SA + n, index_type(-1));
+        for (index_type i = n1 - 1; i >= 0; --i)
+        {
+            const index_type j = SA[i];
+            SA[i] = -1;
+            SA[--bucket[T[j]]] = j;
+        }
+        induce();
+    }
+}
@@ -1,10 +1,19 @@
-#include "Arguments.hpp"
-//std::string arguments::in_file_name = "/home/zqzhoutong/stmsa-BWT/data/people13.fasta";
-//std::string arguments::out_file_name = "/home/zqzhoutong/stmsa-BWT/data/test/people13ed.fasta";
-std::string arguments::in_file_name;
-std::string arguments::out_file_name;
-std::string arguments::tmp_file_name;
-std::string arguments::score_file;
-std::string arguments::snp_file_name;
-size_t arguments::ALL_LEN = 0;
-bool arguments::output_matrix;
+#include "Arguments.hpp"
+//std::string arguments::in_file_name = "/home/zqzhoutong/stmsa-BWT/data/people13.fasta";
+//std::string arguments::out_file_name = "/home/zqzhoutong/stmsa-BWT/data/test/people13ed.fasta";
+std::string arguments::in_file_name;
+std::string arguments::out_file_name;
+std::string arguments::tmp_file_name;
+std::string arguments::score_file;
+std::string arguments::snp_file_name;
+std::string arguments::index_file_name;
+std::string arguments::seed_mode = "fm";
+size_t arguments::max_occurrences = 0;
+bool arguments::reextend_repeats = false;
+size_t arguments::sa_sampling = 1;
+int arguments::minimizer_k = 15;
+int arguments::minimizer_w = 10;
+std::string arguments::spill_directory;
+size_t arguments::spill_memory = (size_t)1024 << 20;
+size_t arguments::ALL_LEN = 0;
+bool arguments::output_matrix;
@@ -1,13 +1,22 @@
-#pragma once
-#include <string>
-
-namespace arguments
-{
-    extern std::string in_file_name;
-    extern std::string out_file_name;
-    extern std::string tmp_file_name;
-    extern std::string score_file;
-    extern std::string snp_file_name;
-    extern bool output_matrix;
-    extern size_t ALL_LEN;
+#pragma once
+#include <string>
+
+namespace arguments
+{
+    extern std::string in_file_name;
+    extern std::string out_file_name;
+    extern std::string tmp_file_name;
+    extern std::string score_file;
+    extern std::string snp_file_name;
+    extern std::string index_file_name;
+    extern std::string seed_mode;
+    extern size_t max_occurrences;
+    extern bool reextend_repeats;
+    extern size_t sa_sampling;
+    extern int minimizer_k;
+    extern int minimizer_w;
+    extern std::string spill_directory;
+    extern size_t spill_memory;
+    extern bool output_matrix;
+    extern size_t ALL_LEN;
 }
\ No newline at end of file
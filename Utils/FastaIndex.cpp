@@ -0,0 +1,43 @@
+#include "FastaIndex.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+// Function to get the header line of a record
+std::string utils::FastaIndex::get_header(size_t i) const
+{
+    const FastaRecord& record = records[i];
+    return std::string(files[record.file].begin() + record.header_begin, record.header_length);
+}
+
+// Function to copy the raw bases of a record into sequence without parsing the text again
+void utils::FastaIndex::get_sequence(size_t i, std::string& sequence) const
+{
+    const FastaRecord& record = records[i];
+    const char* base = files[record.file].begin();
+    sequence.clear();
+
+    if (record.line_width != 0)
+    {
+        // Regular layout: lines start line_stride bytes apart, every line but the last holds line_width bases and the
+        // last one at most line_width (records breaking this are marked irregular when they are parsed)
+        sequence.reserve((record.sequence_end - record.sequence_begin) / record.line_stride * record.line_width + record.line_width);
+        for (uint64_t p = record.sequence_begin; p < record.sequence_end; p += record.line_stride)
+            sequence.append(base + p, std::min<uint64_t>(record.line_width, record.sequence_end - p));
+        return;
+    }
+
+    // Irregular layout: walk the lines, skipping blank lines and carriage returns
+    const char* first = base + record.sequence_begin;
+    const char* last = base + record.sequence_end;
+    sequence.reserve(last - first);
+    for (const char* next; first < last; first = next)
+    {
+        const char* line_end = static_cast<const char*>(memchr(first, '\n', last - first));
+        if (line_end == NULL) line_end = last;
+        next = line_end + 1;
+        if (line_end != first && *(line_end - 1) == '\r')
+            --line_end;
+        sequence.append(first, line_end);
+    }
+}
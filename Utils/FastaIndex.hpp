@@ -0,0 +1,36 @@
+#pragma once
+// Index of the records parsed from the (memory-mapped) input files
+#include "MappedFile.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace utils
+{
+    // Struct for locating one fasta record inside its input file
+    struct FastaRecord
+    {
+        uint32_t file; // Index of the input file
+        uint32_t header_length; // Length of the header line (with '>', without line break)
+        uint32_t line_width; // Bases per full sequence line, 0 if the line layout is irregular
+        uint32_t line_stride; // Bytes from one sequence line to the next (width + line break)
+        uint64_t header_begin; // Offset of the '>' of the header line
+        uint64_t sequence_begin; // Offset of the first sequence byte
+        uint64_t sequence_end; // Offset just past the last sequence byte
+    };
+
+    // Class keeping the input files mapped together with the location of every record
+    class FastaIndex
+    {
+    public:
+        std::vector<MappedFile> files; // Mapped input files, in input order
+        std::vector<FastaRecord> records; // One entry per sequence, in input order
+
+        // Function to get the header line of a record
+        std::string get_header(size_t i) const;
+
+        // Function to copy the raw bases of a record (line breaks removed) into sequence
+        void get_sequence(size_t i, std::string& sequence) const;
+    };
+}
@@ -0,0 +1,129 @@
+#include "GapStore.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+// Constructor for GapStore class
+utils::GapStore::GapStore(const std::string& spill_directory, size_t memory_limit)
+    : _directory(spill_directory)
+    , _memory_limit(memory_limit)
+    , _size(0)
+    , _spilled(false)
+    , _first_row(0)
+    , _memory(0)
+{
+}
+
+// Destructor, removing the spill file
+utils::GapStore::~GapStore()
+{
+    if (_writer.is_open()) _writer.close();
+    if (_cursor.reader.is_open()) _cursor.reader.close();
+    if (!_path.empty()) std::remove(_path.c_str());
+}
+
+// Function to add the gaps of the next row, spilling the rows in memory once they pass the limit
+void utils::GapStore::push_back(std::vector<Insertion>&& gaps)
+{
+    _memory += gaps.capacity() * sizeof(Insertion) + sizeof(std::vector<Insertion>);
+    _rows.emplace_back(std::move(gaps));
+    ++_size;
+    if (!_directory.empty() && _memory > _memory_limit)
+        _spill();
+}
+
+// Function to write the rows still in memory once the store is spilled
+void utils::GapStore::finish()
+{
+    if (_spilled && !_rows.empty())
+        _spill();
+    if (_writer.is_open())
+        _writer.close();
+}
+
+// Helper function to append the rows in memory to the spill file, each row as an encoded insertion list
+void utils::GapStore::_spill()
+{
+    if (!_spilled)
+    {
+        std::string directory = _directory;
+        if (directory.back() != '/' && directory.back() != '\\') directory += '/';
+        _path = directory + "halign4_gaps_" + std::to_string(getpid()) + ".bin";
+        _writer.open(_path, std::ios::binary | std::ios::out | std::ios::trunc);
+        if (!_writer)
+            _fail();
+        _offsets.assign(1, 0);
+        _spilled = true;
+    }
+
+    for (auto& row : _rows)
+    {
+        const InsertionList list(row.cbegin(), row.cend());
+        _writer.write(reinterpret_cast<const char*>(list.data()), list.byte_size());
+        _offsets.push_back(_offsets.back() + list.byte_size());
+    }
+    if (!_writer)
+        _fail();
+    _first_row += _rows.size();
+    std::vector<std::vector<Insertion>>().swap(_rows);
+    _memory = 0;
+}
+
+// Helper function to remove a spill file that could not be written and report the error
+void utils::GapStore::_fail()
+{
+    _writer.close();
+    std::remove(_path.c_str());
+    const std::string path = _path;
+    _path.clear();
+    throw std::runtime_error("cannot write spill file " + path);
+}
+
+// Function to get the gaps of a row; rows read in order are read sequentially from the spill file. A spill file
+// that cannot be opened or ends early throws std::runtime_error rather than decoding stale bytes.
+const std::vector<utils::Insertion>& utils::GapStore::get(size_t row, std::vector<Insertion>& buffer, Cursor& cursor) const
+{
+    if (row >= _first_row)
+        return _rows[row - _first_row];
+
+    if (!cursor.reader.is_open())
+    {
+        cursor.reader.open(_path, std::ios::binary | std::ios::in);
+        cursor.position = 0;
+        if (!cursor.reader.is_open())
+            throw std::runtime_error("cannot read spill file " + _path);
+    }
+    if (cursor.position != _offsets[row])
+    {
+        cursor.reader.clear();
+        cursor.reader.seekg(_offsets[row]);
+    }
+    cursor.bytes.resize(_offsets[row + 1] - _offsets[row]);
+    cursor.reader.read(reinterpret_cast<char*>(cursor.bytes.data()), cursor.bytes.size());
+    if ((size_t)cursor.reader.gcount() != cursor.bytes.size())
+    {
+        cursor.position = ~uint64_t(0); // Seek again on the next read
+        throw std::runtime_error("cannot read row " + std::to_string(row) + " from spill file " + _path);
+    }
+    cursor.position = _offsets[row + 1];
+
+    const unsigned char* first = cursor.bytes.data();
+    const unsigned char* last = first + cursor.bytes.size();
+    buffer.clear();
+    for (InsertionList::const_iterator it(first, last), end(last, last); it != end; ++it)
+        buffer.push_back(*it);
+    return buffer;
+}
+
+// Function to get the number of bytes held in memory
+size_t utils::GapStore::memory_usage() const noexcept
+{
+    return _memory + _offsets.capacity() * sizeof(uint64_t);
+}
@@ -0,0 +1,74 @@
+#pragma once
+// Gap lists of the final alignment, kept in memory or spilled to a file
+#include "Insertion.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace utils
+{
+    // Class holding the gap list of every row of the final alignment. Rows are added in order; while their lists
+    // take less than memory_limit bytes they stay in memory. Past the limit (with a spill directory set) the rows
+    // held so far and every later batch of memory_limit bytes are appended, delta-encoded, to one sequential spill
+    // file, and only an offset per row stays in memory. Once finish is called, rows are read back in any order.
+    class GapStore
+    {
+    public:
+        // Constructor; without a spill directory every list stays in memory
+        explicit GapStore(const std::string& spill_directory = "", size_t memory_limit = 0);
+        ~GapStore();
+
+        GapStore(const GapStore&) = delete;
+        GapStore& operator=(const GapStore&) = delete;
+
+        // Function to add the gaps of the next row; throws std::runtime_error if the spill file cannot be written
+        void push_back(std::vector<Insertion>&& gaps);
+
+        // Function to write the rows still in memory once they are spilled, called after the last push_back; throws
+        // std::runtime_error if the spill file cannot be written
+        void finish();
+
+        // Read position in the spill file; threads reading at the same time each use their own
+        struct Cursor
+        {
+            std::ifstream reader;
+            uint64_t position = 0; // Offset the reader is at
+            std::vector<unsigned char> bytes; // Encoded row read back
+        };
+
+        // Function to get the gaps of a row: the list in memory, or buffer filled from the spill file through cursor;
+        // throws std::runtime_error if the spill file cannot be read
+        const std::vector<Insertion>& get(size_t row, std::vector<Insertion>& buffer, Cursor& cursor) const;
+        const std::vector<Insertion>& get(size_t row, std::vector<Insertion>& buffer) { return get(row, buffer, _cursor); }
+
+        size_t size() const noexcept { return _size; }
+        bool spilled() const noexcept { return _spilled; }
+        size_t spilled_bytes() const noexcept { return _offsets.empty() ? 0 : (size_t)_offsets.back(); }
+
+        // Function to get the number of bytes held in memory (lists and offsets)
+        size_t memory_usage() const noexcept;
+
+    private:
+        // Helper function to append the rows in memory to the spill file and release them
+        void _spill();
+
+        // Helper function to close and remove the spill file, then throw std::runtime_error
+        void _fail();
+
+        std::string _directory; // Directory of the spill file, empty to stay in memory
+        std::string _path; // Spill file
+        size_t _memory_limit; // Bytes of lists kept in memory before they are spilled
+        size_t _size; // Number of rows
+        bool _spilled; // Whether the rows are in the spill file
+
+        std::vector<std::vector<Insertion>> _rows; // Rows in memory, from _first_row on
+        size_t _first_row; // First row held in _rows
+        size_t _memory; // Bytes of the lists in _rows
+
+        std::vector<uint64_t> _offsets; // Spill file offset of every spilled row, plus the end
+        std::ofstream _writer;
+        Cursor _cursor; // Reader of get without a cursor
+    };
+}
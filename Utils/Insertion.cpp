@@ -1,6 +1,6 @@
-#include "Insertion.hpp"
-
-bool utils::Insertion::operator==(const Insertion &rhs) const noexcept
-{
-    return index == rhs.index && number == rhs.number;
-}
+#include "Insertion.hpp"
+
+bool utils::Insertion::operator==(const Insertion &rhs) const noexcept
+{
+    return index == rhs.index && number == rhs.number;
+}
@@ -1,96 +1,210 @@
-#pragma once
-// Utilities for handling insertions (gaps) in sequences
-#include <cstddef>
-#include <iterator>
-
-namespace utils
-{
-    // Struct for representing an insertion with nucleotide and gap counts
-    struct Insertion2
-    {
-        size_t index; // The position where insertion starts
-        size_t n_num; // Number of nucleotides inserted at the given position
-        size_t gap_num; // Number of gaps inserted at the given position
-    };
-
-    // Struct for representing an insertion (gap)
-    struct Insertion
-    {
-        size_t index; // The position where insertion starts
-        size_t number; // Number of gaps inserted at the given position
-
-        // Comparison operator to check equality between insertions
-        bool operator==(const Insertion &rhs) const noexcept;
-
-        // Static function to merge two sorted sequences of insertions (with addition of gap counts)
-        template<typename InIt1, typename InIt2, typename OutIt>
-        static void plus(InIt1 lhs_first, InIt1 lhs_last, InIt2 rhs_first, InIt2 rhs_last, OutIt dest)
-        {
-            // Iterate through both sequences and merge them
-            for (; lhs_first != lhs_last && rhs_first != rhs_last;)
-                if (lhs_first->index < rhs_first->index)
-                {
-                    *dest++ = *lhs_first++;
-                }
-                else if (lhs_first->index > rhs_first->index)
-                {
-                    *dest++ = *rhs_first++;
-                }
-                else // If indices are equal, add the gap numbers
-                {
-                    *dest++ = utils::Insertion({ lhs_first->index, lhs_first->number + rhs_first->number });
-                    ++lhs_first;
-                    ++rhs_first;
-                }
-
-            // Copy remaining elements from either sequence
-            std::copy(lhs_first, lhs_last, dest);
-            std::copy(rhs_first, rhs_last, dest);
-        }
-
-        // Static function to subtract gaps from one sequence from another (lhs >= rhs)
-        template<typename InIt1, typename InIt2, typename OutIt>
-        static void minus(InIt1 lhs_first, InIt1 lhs_last, InIt2 rhs_first, InIt2 rhs_last, OutIt dest)
-        {
-            // Iterate through both sequences and subtract gaps in rhs from lhs
-            for (; rhs_first != rhs_last; ++lhs_first, ++rhs_first)
-            {
-                while (lhs_first->index != rhs_first->index)
-                    *dest++ = *lhs_first++;
-
-                const size_t difference = lhs_first->number - rhs_first->number;
-                if (difference) *dest++ = utils::Insertion({ lhs_first->index, difference });
-            }
-
-            // Copy remaining elements from lhs
-            std::copy(lhs_first, lhs_last, dest);
-        }
-
-        // Static function to insert gaps into a sequence
-        template<typename InIt1, typename InIt2, typename OutIt>
-        static void insert_gaps(InIt1 sequence_first, InIt1 sequence_last,
-                                InIt2 insertion_first, InIt2 insertion_last, OutIt dest,
-                                typename std::iterator_traits<InIt1>::value_type gap_symbol)
-        {
-            // Insert gaps at specified positions into the sequence
-            for (unsigned last_index = 0; insertion_first != insertion_last; ++insertion_first)
-            {
-                auto sequence_stop = sequence_first;
-                std::advance(sequence_stop, insertion_first->index - last_index);
-
-                // Copy the sequence up to the point where gaps need to be inserted
-                dest = std::copy(sequence_first, sequence_stop, dest);
-                // Fill with the specified number of gap symbols
-                dest = std::fill_n(dest, insertion_first->number, gap_symbol);
-
-                sequence_first = sequence_stop;
-                last_index = insertion_first->index;
-            }
-
-            // Copy the remainder of the sequence
-            std::copy(sequence_first, sequence_last, dest);
-        }
-
-    };
-
-}
+#pragma once
+// Utilities for handling insertions (gaps) in sequences
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace utils
+{
+    // Struct for representing an insertion with nucleotide and gap counts
+    struct Insertion2
+    {
+        size_t index; // The position where insertion starts
+        size_t n_num; // Number of nucleotides inserted at the given position
+        size_t gap_num; // Number of gaps inserted at the given position
+    };
+
+    // Struct for representing an insertion (gap)
+    struct Insertion
+    {
+        size_t index; // The position where insertion starts
+        size_t number; // Number of gaps inserted at the given position
+
+        // Comparison operator to check equality between insertions
+        bool operator==(const Insertion &rhs) const noexcept;
+
+        // Static function to merge two sorted sequences of insertions (with addition of gap counts)
+        template<typename InIt1, typename InIt2, typename OutIt>
+        static void plus(InIt1 lhs_first, InIt1 lhs_last, InIt2 rhs_first, InIt2 rhs_last, OutIt dest)
+        {
+            // Iterate through both sequences and merge them
+            for (; lhs_first != lhs_last && rhs_first != rhs_last;)
+                if (lhs_first->index < rhs_first->index)
+                {
+                    *dest++ = *lhs_first++;
+                }
+                else if (lhs_first->index > rhs_first->index)
+                {
+                    *dest++ = *rhs_first++;
+                }
+                else // If indices are equal, add the gap numbers
+                {
+                    *dest++ = utils::Insertion({ lhs_first->index, lhs_first->number + rhs_first->number });
+                    ++lhs_first;
+                    ++rhs_first;
+                }
+
+            // Copy remaining elements from either sequence
+            std::copy(lhs_first, lhs_last, dest);
+            std::copy(rhs_first, rhs_last, dest);
+        }
+
+        // Static function to subtract gaps from one sequence from another (lhs >= rhs)
+        template<typename InIt1, typename InIt2, typename OutIt>
+        static void minus(InIt1 lhs_first, InIt1 lhs_last, InIt2 rhs_first, InIt2 rhs_last, OutIt dest)
+        {
+            // Iterate through both sequences and subtract gaps in rhs from lhs
+            for (; rhs_first != rhs_last; ++lhs_first, ++rhs_first)
+            {
+                while (lhs_first->index != rhs_first->index)
+                    *dest++ = *lhs_first++;
+
+                const size_t difference = lhs_first->number - rhs_first->number;
+                if (difference) *dest++ = utils::Insertion({ lhs_first->index, difference });
+            }
+
+            // Copy remaining elements from lhs
+            std::copy(lhs_first, lhs_last, dest);
+        }
+
+        // Static function to insert gaps into a sequence
+        template<typename InIt1, typename InIt2, typename OutIt>
+        static void insert_gaps(InIt1 sequence_first, InIt1 sequence_last,
+                                InIt2 insertion_first, InIt2 insertion_last, OutIt dest,
+                                typename std::iterator_traits<InIt1>::value_type gap_symbol)
+        {
+            // Insert gaps at specified positions into the sequence
+            for (unsigned last_index = 0; insertion_first != insertion_last; ++insertion_first)
+            {
+                auto sequence_stop = sequence_first;
+                std::advance(sequence_stop, insertion_first->index - last_index);
+
+                // Copy the sequence up to the point where gaps need to be inserted
+                dest = std::copy(sequence_first, sequence_stop, dest);
+                // Fill with the specified number of gap symbols
+                dest = std::fill_n(dest, insertion_first->number, gap_symbol);
+
+                sequence_first = sequence_stop;
+                last_index = insertion_first->index;
+            }
+
+            // Copy the remainder of the sequence
+            std::copy(sequence_first, sequence_last, dest);
+        }
+
+    };
+
+    // Container of insertions sorted by index, delta-encoded as varints: each run takes the bytes of the gap from the
+    // previous index and of its number, 2 or 3 bytes for typical runs instead of the 16 bytes of an Insertion.
+    // Iterators decode on the fly and can be passed to Insertion::plus, minus and insert_gaps; std::back_inserter
+    // appends to it.
+    class InsertionList
+    {
+    public:
+        using value_type = Insertion;
+
+        // Input iterator over the decoded insertions
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Insertion;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Insertion*;
+            using reference = const Insertion&;
+
+            const_iterator() : _position(nullptr), _next(nullptr), _end(nullptr), _current({ 0, 0 }) {}
+            const_iterator(const unsigned char* position, const unsigned char* end) : _position(position), _next(position), _end(end), _current({ 0, 0 }) { _decode(); }
+
+            reference operator*() const noexcept { return _current; }
+            pointer operator->() const noexcept { return &_current; }
+            const_iterator& operator++() { _position = _next; _decode(); return *this; }
+            const_iterator operator++(int) { const_iterator previous = *this; ++*this; return previous; }
+            bool operator==(const const_iterator& rhs) const noexcept { return _position == rhs._position; }
+            bool operator!=(const const_iterator& rhs) const noexcept { return _position != rhs._position; }
+
+        private:
+            // Read the run starting at _position, if any
+            void _decode()
+            {
+                if (_position == _end) return;
+                _current.index += _read(_next);
+                _current.number = _read(_next);
+            }
+
+            static size_t _read(const unsigned char*& p)
+            {
+                size_t value = 0;
+                for (int shift = 0; ; shift += 7)
+                {
+                    const unsigned char byte = *p++;
+                    value |= (size_t)(byte & 0x7f) << shift;
+                    if (!(byte & 0x80)) return value;
+                }
+            }
+
+            const unsigned char* _position; // Encoding of the current run
+            const unsigned char* _next; // Encoding of the next run
+            const unsigned char* _end;
+            Insertion _current; // Decoded current run
+        };
+
+        InsertionList() : _size(0), _last_index(0) {}
+
+        // Constructor from a range of insertions sorted by index
+        template<typename InIt>
+        InsertionList(InIt first, InIt last) : _size(0), _last_index(0)
+        {
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+
+        // Function to append an insertion; its index must not be below the last one
+        void push_back(const Insertion& insertion)
+        {
+            const size_t delta = insertion.index - _last_index;
+            if (delta < 0x80 && insertion.number < 0x80)
+            {
+                // Most runs are close to the previous one and short: one byte each
+                const unsigned char bytes[2] = { (unsigned char)delta, (unsigned char)insertion.number };
+                _bytes.insert(_bytes.end(), bytes, bytes + 2);
+            }
+            else
+            {
+                _write(delta);
+                _write(insertion.number);
+            }
+            _last_index = insertion.index;
+            ++_size;
+        }
+
+        const_iterator begin() const noexcept { return const_iterator(_bytes.data(), _bytes.data() + _bytes.size()); }
+        const_iterator end() const noexcept { return const_iterator(_bytes.data() + _bytes.size(), _bytes.data() + _bytes.size()); }
+        size_t size() const noexcept { return _size; }
+        bool empty() const noexcept { return _size == 0; }
+        void clear() noexcept { _bytes.clear(); _size = 0; _last_index = 0; }
+        void reserve(size_t runs) { _bytes.reserve(2 * runs); } // Room for runs of one-byte deltas and numbers
+        void shrink_to_fit() { _bytes.shrink_to_fit(); }
+
+        // Encoded runs, e.g. to store them; const_iterator(data(), data() + byte_size()) decodes them again
+        const unsigned char* data() const noexcept { return _bytes.data(); }
+        size_t byte_size() const noexcept { return _bytes.size(); }
+
+        // Function to get the number of bytes held by the list
+        size_t memory_usage() const noexcept { return _bytes.capacity(); }
+
+    private:
+        void _write(size_t value)
+        {
+            for (; value >= 0x80; value >>= 7)
+                _bytes.push_back((unsigned char)(value | 0x80));
+            _bytes.push_back((unsigned char)value);
+        }
+
+        std::vector<unsigned char> _bytes; // Per run: varint of the index minus the previous index, varint of the number
+        size_t _size; // Number of runs
+        size_t _last_index; // Index of the last run
+    };
+
+}
@@ -0,0 +1,102 @@
+#include "MappedFile.hpp"
+
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__unix) || defined(unix) || (defined(__APPLE__) && defined(__MACH__))
+#define MAPPED_FILE_USE_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Constructor: maps the file read-only, falls back to reading it into a buffer
+utils::MappedFile::MappedFile(const std::string& file_name)
+    : _data(nullptr)
+    , _size(0)
+    , _open(false)
+    , _mapped(false)
+{
+#if defined(MAPPED_FILE_USE_MMAP)
+    const int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd == -1) return;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0)
+    {
+        _open = true;
+        _size = (size_t)st.st_size;
+        if (_size != 0)
+        {
+            void* addr = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+                madvise(addr, _size, MADV_SEQUENTIAL); // Input is scanned front to back
+                _data = static_cast<const char*>(addr);
+                _mapped = true;
+            }
+        }
+    }
+    close(fd);
+    if (_mapped || !_open || _size == 0) return;
+#endif
+
+    // Fallback: read the whole file into memory
+    std::ifstream ifs(file_name, std::ios::binary | std::ios::in);
+    if (!ifs) return;
+    ifs.seekg(0, std::ios::end);
+    _buffer.resize((size_t)ifs.tellg());
+    ifs.seekg(0, std::ios::beg);
+    ifs.read(_buffer.data(), _buffer.size());
+    _data = _buffer.data();
+    _size = _buffer.size();
+    _open = true;
+}
+
+utils::MappedFile::~MappedFile()
+{
+    _release();
+}
+
+utils::MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    : _data(rhs._data)
+    , _size(rhs._size)
+    , _open(rhs._open)
+    , _mapped(rhs._mapped)
+    , _buffer(std::move(rhs._buffer))
+{
+    if (!_mapped) _data = _buffer.data();
+    rhs._data = nullptr;
+    rhs._size = 0;
+    rhs._open = rhs._mapped = false;
+}
+
+utils::MappedFile& utils::MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        _release();
+        _size = rhs._size;
+        _open = rhs._open;
+        _mapped = rhs._mapped;
+        _buffer = std::move(rhs._buffer);
+        _data = _mapped ? rhs._data : _buffer.data();
+        rhs._data = nullptr;
+        rhs._size = 0;
+        rhs._open = rhs._mapped = false;
+    }
+    return *this;
+}
+
+// Function to unmap the file or free the fallback buffer
+void utils::MappedFile::_release() noexcept
+{
+#if defined(MAPPED_FILE_USE_MMAP)
+    if (_mapped) munmap(const_cast<char*>(_data), _size);
+#endif
+    std::vector<char>().swap(_buffer);
+    _data = nullptr;
+    _size = 0;
+    _mapped = false;
+}
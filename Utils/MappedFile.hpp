@@ -0,0 +1,38 @@
+#pragma once
+// Read-only, zero-copy access to a whole input file
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace utils
+{
+    // Class mapping a file into memory (mmap on unix, buffered read elsewhere)
+    class MappedFile
+    {
+    public:
+        // Constructor: maps the whole file, check is_open() for success
+        explicit MappedFile(const std::string& file_name);
+
+        // Destructor: unmaps the file
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& rhs) noexcept;
+        MappedFile& operator=(MappedFile&& rhs) noexcept;
+
+        bool is_open() const noexcept { return _open; }
+        const char* begin() const noexcept { return _data; }
+        const char* end() const noexcept { return _data + _size; }
+        size_t size() const noexcept { return _size; }
+
+    private:
+        void _release() noexcept;
+
+        const char* _data; // First byte of the file
+        size_t _size; // Length of the file in bytes
+        bool _open; // Whether the file could be accessed
+        bool _mapped; // Whether _data points into an mmap region
+        std::vector<char> _buffer; // Fallback storage when mmap is unavailable
+    };
+}
@@ -0,0 +1,155 @@
+#include "PackedSequences.hpp"
+
+#include <algorithm>
+
+// Constructor: an empty store
+utils::PackedSequences::PackedSequences()
+    : _offsets(1, 0)
+    , _exception_offsets(1, 0)
+{}
+
+// Function to start a new (empty) sequence
+void utils::PackedSequences::push_back()
+{
+    _offsets.push_back(_offsets.back());
+    _exception_offsets.push_back(_exception_offsets.back());
+}
+
+// Function to append pseudo bases to the last sequence
+void utils::PackedSequences::append(const unsigned char* first, const unsigned char* last)
+{
+    uint64_t pos = _offsets.back();
+    const uint64_t begin = _offsets[_offsets.size() - 2];
+    const uint64_t exception_begin = _exception_offsets[_exception_offsets.size() - 2];
+    const uint64_t total = pos + (last - first);
+    if (_words.size() < (total + 31) / 32)
+    {
+        if (_words.capacity() < (total + 31) / 32)
+            _words.reserve(std::max<size_t>((total + 31) / 32, _words.capacity() * 2));
+        _words.resize((total + 31) / 32, 0);
+    }
+
+    uint64_t* words = _words.data();
+    for (unsigned char c; first != last; ++first, ++pos)
+    {
+        c = *first;
+        if (c == nucleic_acid_pseudo::N)
+        {
+            // Fake the base exactly like to_pseudo does and remember the position
+            const uint64_t index = pos - begin;
+            c = (unsigned char)((index & 3) + 1);
+            if (_exceptions.size() != exception_begin && _exceptions.back().index + _exceptions.back().number == index)
+                ++_exceptions.back().number;
+            else
+                _exceptions.push_back(Exception({ index, 1 }));
+        }
+        words[pos >> 5] |= (uint64_t)(c - 1) << ((pos & 31) << 1);
+    }
+    _offsets.back() = total;
+    _exception_offsets.back() = _exceptions.size();
+}
+
+// Function to append every sequence of another store, shifting its words into place
+void utils::PackedSequences::append(const PackedSequences& other)
+{
+    const uint64_t base = _offsets.back();
+    const uint64_t total = base + other._offsets.back();
+    _words.resize((total + 31) / 32, 0);
+
+    const unsigned shift = (unsigned)(base & 31) << 1;
+    uint64_t* des = _words.data() + (base >> 5);
+    const size_t other_words = (other._offsets.back() + 31) / 32;
+    for (size_t i = 0; i != other_words; ++i)
+    {
+        des[i] |= other._words[i] << shift;
+        if (shift != 0 && (base >> 5) + i + 1 < _words.size())
+            des[i + 1] |= other._words[i] >> (64 - shift);
+    }
+
+    const uint64_t exception_base = _exceptions.size();
+    _exceptions.insert(_exceptions.end(), other._exceptions.begin(), other._exceptions.end());
+    for (size_t i = 1; i != other._offsets.size(); ++i)
+    {
+        _offsets.push_back(base + other._offsets[i]);
+        _exception_offsets.push_back(exception_base + other._exception_offsets[i]);
+    }
+}
+
+// Function to release all storage
+void utils::PackedSequences::clear()
+{
+    std::vector<uint64_t>().swap(_words);
+    std::vector<uint64_t>(1, 0).swap(_offsets);
+    std::vector<Exception>().swap(_exceptions);
+    std::vector<uint64_t>(1, 0).swap(_exception_offsets);
+}
+
+// Function to decode sequence i into one byte per base
+void utils::PackedSequences::unpack(size_t i, std::vector<unsigned char>& sequence) const
+{
+    const view packed = (*this)[i];
+    sequence.resize(packed.size());
+    std::copy(packed.cbegin(), packed.cend(), sequence.begin());
+}
+
+// Function to check whether a base was unknown (N/IUPAC) in the input
+bool utils::PackedSequences::is_exception(size_t i, size_t pos) const noexcept
+{
+    const Exception* first = exceptions_begin(i);
+    const Exception* last = exceptions_end(i);
+    const Exception* it = std::upper_bound(first, last, (uint64_t)pos,
+        [](uint64_t lhs, const Exception& rhs) { return lhs < rhs.index; });
+    return it != first && pos < (it - 1)->index + (it - 1)->number;
+}
+
+// Function to get the 32 bases starting at any position as one word
+uint64_t utils::PackedSequences::_get_word(uint64_t pos) const noexcept
+{
+    const size_t index = pos >> 5;
+    const unsigned shift = (unsigned)(pos & 31) << 1;
+    uint64_t word = _words[index] >> shift;
+    if (shift != 0 && index + 1 < _words.size())
+        word |= _words[index + 1] << (64 - shift);
+    return word;
+}
+
+// Function to hash the bases of sequence i a word at a time
+uint64_t utils::PackedSequences::hash(size_t i) const noexcept
+{
+    const uint64_t begin = _offsets[i], end = _offsets[i + 1];
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ (end - begin);
+    for (uint64_t pos = begin; pos < end; pos += 32)
+    {
+        uint64_t word = _get_word(pos);
+        if (end - pos < 32)
+            word &= (uint64_t(1) << ((end - pos) << 1)) - 1;
+        h ^= word + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        h ^= h >> 31;
+        h *= 0xBF58476D1CE4E5B9ULL;
+    }
+    return h ^ (h >> 29);
+}
+
+// Function to check whether sequences i and j hold the same bases
+bool utils::PackedSequences::equal(size_t i, size_t j) const noexcept
+{
+    const uint64_t length = _offsets[i + 1] - _offsets[i];
+    if (length != _offsets[j + 1] - _offsets[j])
+        return false;
+    for (uint64_t k = 0; k < length; k += 32)
+    {
+        uint64_t diff = _get_word(_offsets[i] + k) ^ _get_word(_offsets[j] + k);
+        if (length - k < 32)
+            diff &= (uint64_t(1) << ((length - k) << 1)) - 1;
+        if (diff != 0)
+            return false;
+    }
+    return true;
+}
+
+// Function to get the number of bytes held by the store
+size_t utils::PackedSequences::memory_usage() const noexcept
+{
+    return _words.capacity() * sizeof(uint64_t) + _offsets.capacity() * sizeof(uint64_t)
+        + _exceptions.capacity() * sizeof(Exception) + _exception_offsets.capacity() * sizeof(uint64_t);
+}
@@ -0,0 +1,131 @@
+#pragma once
+// Contiguous 2-bit store for pseudo sequences
+#include "Pseudo.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace utils
+{
+    // Class storing all pseudo sequences back to back with 2 bits per base.
+    // Unknown bases (N/IUPAC) are stored as the same A/C/G/T to_pseudo fakes for them,
+    // and their positions are kept in a sparse list of exception runs.
+    class PackedSequences
+    {
+    public:
+        // Struct for a run of unknown bases inside one sequence
+        struct Exception
+        {
+            uint64_t index; // Position of the first unknown base in its sequence
+            uint64_t number; // Number of consecutive unknown bases
+        };
+
+        // Random access iterator yielding pseudo bases (A..T) of a packed sequence
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = unsigned char;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = unsigned char;
+
+            const_iterator() noexcept : _words(nullptr), _pos(0) {}
+            const_iterator(const uint64_t* words, uint64_t pos) noexcept : _words(words), _pos(pos) {}
+
+            unsigned char operator*() const noexcept { return (unsigned char)(((_words[_pos >> 5] >> ((_pos & 31) << 1)) & 3) + 1); }
+            unsigned char operator[](difference_type n) const noexcept { return *(*this + n); }
+
+            const_iterator& operator++() noexcept { ++_pos; return *this; }
+            const_iterator operator++(int) noexcept { const_iterator tmp(*this); ++_pos; return tmp; }
+            const_iterator& operator--() noexcept { --_pos; return *this; }
+            const_iterator operator--(int) noexcept { const_iterator tmp(*this); --_pos; return tmp; }
+            const_iterator& operator+=(difference_type n) noexcept { _pos += n; return *this; }
+            const_iterator& operator-=(difference_type n) noexcept { _pos -= n; return *this; }
+            const_iterator operator+(difference_type n) const noexcept { return const_iterator(_words, _pos + n); }
+            const_iterator operator-(difference_type n) const noexcept { return const_iterator(_words, _pos - n); }
+            friend const_iterator operator+(difference_type n, const const_iterator& it) noexcept { return it + n; }
+            difference_type operator-(const const_iterator& rhs) const noexcept { return (difference_type)_pos - (difference_type)rhs._pos; }
+
+            bool operator==(const const_iterator& rhs) const noexcept { return _pos == rhs._pos; }
+            bool operator!=(const const_iterator& rhs) const noexcept { return _pos != rhs._pos; }
+            bool operator<(const const_iterator& rhs) const noexcept { return _pos < rhs._pos; }
+            bool operator>(const const_iterator& rhs) const noexcept { return _pos > rhs._pos; }
+            bool operator<=(const const_iterator& rhs) const noexcept { return _pos <= rhs._pos; }
+            bool operator>=(const const_iterator& rhs) const noexcept { return _pos >= rhs._pos; }
+
+        private:
+            const uint64_t* _words;
+            uint64_t _pos; // Position in the whole store
+        };
+
+        // Lightweight view of one packed sequence
+        class view
+        {
+        public:
+            view(const uint64_t* words, uint64_t begin, uint64_t length) noexcept : _words(words), _begin(begin), _length(length) {}
+
+            const_iterator begin() const noexcept { return const_iterator(_words, _begin); }
+            const_iterator end() const noexcept { return const_iterator(_words, _begin + _length); }
+            const_iterator cbegin() const noexcept { return begin(); }
+            const_iterator cend() const noexcept { return end(); }
+            size_t size() const noexcept { return _length; }
+            bool empty() const noexcept { return _length == 0; }
+            unsigned char operator[](size_t i) const noexcept { return begin()[i]; }
+
+        private:
+            const uint64_t* _words;
+            uint64_t _begin;
+            uint64_t _length;
+        };
+
+        PackedSequences();
+
+        // Function to start a new (empty) sequence
+        void push_back();
+
+        // Function to append pseudo bases to the last sequence; N is recorded as an exception and faked
+        void append(const unsigned char* first, const unsigned char* last);
+
+        // Function to append every sequence of another store
+        void append(const PackedSequences& other);
+
+        // Function to release all storage
+        void clear();
+
+        size_t size() const noexcept { return _offsets.size() - 1; }
+        bool empty() const noexcept { return size() == 0; }
+        size_t length(size_t i) const noexcept { return (size_t)(_offsets[i + 1] - _offsets[i]); }
+        view operator[](size_t i) const noexcept { return view(_words.data(), _offsets[i], _offsets[i + 1] - _offsets[i]); }
+
+        // Function to decode sequence i into one byte per base
+        void unpack(size_t i, std::vector<unsigned char>& sequence) const;
+
+        // Function to check whether a base was unknown (N/IUPAC) in the input
+        bool is_exception(size_t i, size_t pos) const noexcept;
+
+        // Function to get the exception runs of sequence i
+        const Exception* exceptions_begin(size_t i) const noexcept { return _exceptions.data() + _exception_offsets[i]; }
+        const Exception* exceptions_end(size_t i) const noexcept { return _exceptions.data() + _exception_offsets[i + 1]; }
+
+        // Function to hash the bases of sequence i (exceptions are not part of the hash)
+        uint64_t hash(size_t i) const noexcept;
+
+        // Function to check whether sequences i and j hold the same bases
+        bool equal(size_t i, size_t j) const noexcept;
+
+        // Function to get the number of bytes held by the store
+        size_t memory_usage() const noexcept;
+
+    private:
+        // Function to get the 32 bases starting at any position as one word
+        uint64_t _get_word(uint64_t pos) const noexcept;
+
+        std::vector<uint64_t> _words; // 2-bit codes (pseudo base - 1), 32 bases per word
+        std::vector<uint64_t> _offsets; // Start of every sequence in bases, plus the total length
+        std::vector<Exception> _exceptions; // Unknown-base runs of all sequences
+        std::vector<uint64_t> _exception_offsets; // Start of every sequence in _exceptions
+    };
+}
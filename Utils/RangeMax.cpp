@@ -0,0 +1,171 @@
+#include "RangeMax.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+// Constructor: places every point (u[i], v[i]) in the tree, all values start empty
+utils::RangeMaxTree::RangeMaxTree(const std::vector<int64_t>& u, const std::vector<int64_t>& v)
+    : _size(1)
+    , _leaf(u.size())
+    , _v(v)
+{
+    const size_t n = u.size();
+    while (_size < n) _size <<= 1;
+
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&u](size_t lhs, size_t rhs) { return u[lhs] != u[rhs] ? u[lhs] < u[rhs] : lhs < rhs; });
+    _u_sorted.resize(n);
+    for (size_t i = 0; i != n; ++i)
+    {
+        _u_sorted[i] = u[order[i]];
+        _leaf[order[i]] = i;
+    }
+
+    // Node sizes follow from the leaf range they cover, so all nodes share one array
+    _offset.resize(_size * 2 + 1);
+    _offset[0] = _offset[1] = 0;
+    for (size_t node = 1, width = _size; width != 0; width >>= 1)
+        for (size_t end = node * 2; node != end; ++node)
+        {
+            const size_t first = (node - (end >> 1)) * width;
+            _offset[node + 1] = _offset[node] + (first < n ? std::min(width, n - first) : 0);
+        }
+    _keys.resize(_offset.back());
+    for (size_t i = 0; i != n; ++i)
+        _keys[_offset[_size + i]] = key_type(v[order[i]], (uint32_t)order[i]);
+
+    // Every node keeps the merged keys of its children
+    for (size_t node = _size - 1; node != 0; --node)
+        std::merge(_keys.begin() + _offset[node * 2], _keys.begin() + _offset[node * 2 + 1],
+            _keys.begin() + _offset[node * 2 + 1], _keys.begin() + _offset[node * 2 + 2], _keys.begin() + _offset[node]);
+
+    _fenwick.assign(_keys.size() + _size * 2, Entry({ std::numeric_limits<int64_t>::min(), -1 }));
+}
+
+// Function to raise the value of a point in every node above its leaf
+void utils::RangeMaxTree::update(size_t point, int64_t value)
+{
+    const Entry entry({ value, (int64_t)point });
+    const key_type key(_v[point], (uint32_t)point);
+    for (size_t node = _size + _leaf[point]; node != 0; node >>= 1)
+    {
+        const auto first = _keys.begin() + _offset[node], last = _keys.begin() + _offset[node + 1];
+        Entry* fenwick = _fenwick.data() + _offset[node] + node;
+        const size_t count = last - first;
+        for (size_t i = std::lower_bound(first, last, key) - first + 1; i <= count; i += i & (~i + 1))
+            if (_better(entry, fenwick[i]))
+                fenwick[i] = entry;
+    }
+}
+
+// Function to get the best point with u in [u_low, u_high] and v <= v_high
+utils::RangeMaxTree::Entry utils::RangeMaxTree::query(int64_t u_low, int64_t u_high, int64_t v_high) const
+{
+    Entry best({ std::numeric_limits<int64_t>::min(), -1 });
+    if (u_low > u_high) return best;
+
+    size_t l = std::lower_bound(_u_sorted.begin(), _u_sorted.end(), u_low) - _u_sorted.begin() + _size;
+    size_t r = std::upper_bound(_u_sorted.begin(), _u_sorted.end(), u_high) - _u_sorted.begin() + _size;
+    for (; l < r; l >>= 1, r >>= 1)
+    {
+        if (l & 1) _take(l++, v_high, best);
+        if (r & 1) _take(--r, v_high, best);
+    }
+    return best;
+}
+
+// Support function comparing two results: higher value first, then lower index
+bool utils::RangeMaxTree::_better(const Entry& lhs, const Entry& rhs) noexcept
+{
+    if (lhs.index == -1) return false;
+    if (rhs.index == -1) return true;
+    return lhs.value != rhs.value ? lhs.value > rhs.value : lhs.index < rhs.index;
+}
+
+// Support function merging the prefix max of one node (keys with v <= v_high) into best
+void utils::RangeMaxTree::_take(size_t node, int64_t v_high, Entry& best) const
+{
+    const auto first = _keys.begin() + _offset[node], last = _keys.begin() + _offset[node + 1];
+    const Entry* fenwick = _fenwick.data() + _offset[node] + node;
+    for (size_t i = std::upper_bound(first, last, key_type(v_high, std::numeric_limits<uint32_t>::max())) - first; i != 0; i &= i - 1)
+        if (_better(fenwick[i], best))
+            best = fenwick[i];
+}
+
+// Function to chain anchors with the weights of the anchor graph without building the graph: anchors are visited by
+// their end on the center and the best predecessor is looked up in three range-max trees, one per case of the overlap
+std::vector<size_t> utils::chain_anchors(const std::vector<std::array<size_t, 3>>& anchors, int64_t* score)
+{
+    std::vector<size_t> chain;
+    if (anchors.empty())
+    {
+        if (score != nullptr) *score = 0;
+        return chain;
+    }
+
+    const size_t pair_num = anchors.size();
+    std::vector<int64_t> end_x(pair_num), end_y(pair_num), diagonal(pair_num), negative_diagonal(pair_num);
+    for (size_t i = 0; i != pair_num; ++i)
+    {
+        end_x[i] = (int64_t)(anchors[i][0] + anchors[i][2]);
+        end_y[i] = (int64_t)(anchors[i][1] + anchors[i][2]);
+        diagonal[i] = (int64_t)anchors[i][0] - (int64_t)anchors[i][1];
+        negative_diagonal[i] = -diagonal[i];
+    }
+
+    // Predecessors i of j (end_i < end_j on both sequences) fall in one of three cases:
+    // no overlap (end_i <= start_j on both): score_i
+    // overlap decided by the center (diagonal_i >= diagonal_j, end_i.x > start_j.x): score_i - end_i.x + start_j.x
+    // overlap decided by the row (diagonal_i < diagonal_j, end_i.y > start_j.y): score_i - end_i.y + start_j.y
+    RangeMaxTree disjoint(end_x, end_y);
+    RangeMaxTree centre_overlap(end_x, negative_diagonal);
+    RangeMaxTree row_overlap(end_y, diagonal);
+
+    std::vector<size_t> order(pair_num);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&end_x](size_t lhs, size_t rhs) { return end_x[lhs] != end_x[rhs] ? end_x[lhs] < end_x[rhs] : lhs < rhs; });
+
+    const size_t none = pair_num;
+    std::vector<int64_t> scores(pair_num);
+    std::vector<size_t> previous(pair_num, none);
+    for (size_t first = 0, last = 0; first != pair_num; first = last)
+    {
+        // Anchors with the same end on the center cannot chain with each other, query them all before inserting
+        while (last != pair_num && end_x[order[last]] == end_x[order[first]]) ++last;
+        for (size_t k = first; k != last; ++k)
+        {
+            const size_t j = order[k];
+            const int64_t start_x = (int64_t)anchors[j][0];
+            const int64_t start_y = (int64_t)anchors[j][1];
+            int64_t best = 0;
+
+            const auto a = disjoint.query(std::numeric_limits<int64_t>::min(), start_x, start_y);
+            if (a.index != -1 && a.value > best) { best = a.value; previous[j] = (size_t)a.index; }
+            const auto b = centre_overlap.query(start_x + 1, std::numeric_limits<int64_t>::max(), negative_diagonal[j]);
+            if (b.index != -1 && b.value + start_x > best) { best = b.value + start_x; previous[j] = (size_t)b.index; }
+            const auto c = row_overlap.query(start_y + 1, end_y[j] - 1, diagonal[j] - 1);
+            if (c.index != -1 && c.value + start_y > best) { best = c.value + start_y; previous[j] = (size_t)c.index; }
+
+            scores[j] = best + (int64_t)anchors[j][2];
+        }
+        for (size_t k = first; k != last; ++k)
+        {
+            const size_t i = order[k];
+            disjoint.update(i, scores[i]);
+            centre_overlap.update(i, scores[i] - end_x[i]);
+            row_overlap.update(i, scores[i] - end_y[i]);
+        }
+    }
+
+    // Trace back from the best scoring anchor
+    size_t tail = 0;
+    for (size_t i = 1; i != pair_num; ++i)
+        if (scores[i] > scores[tail]) tail = i;
+    for (size_t i = tail; i != none; i = previous[i])
+        chain.push_back(i);
+    std::reverse(chain.begin(), chain.end());
+    if (score != nullptr) *score = scores[tail];
+    return chain;
+}
@@ -0,0 +1,52 @@
+#pragma once
+// Two-dimensional range-max structure for chaining anchors
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace utils
+{
+    // Class answering "max value over the points with u in [u_low, u_high] and v <= v_high" while values
+    // are raised one point at a time. All points are given up front: a segment tree over u whose nodes
+    // hold the v keys of their points in order, each with a max Fenwick tree over those keys.
+    // Updates and queries take O(log^2 n).
+    class RangeMaxTree
+    {
+    public:
+        // Struct for a query result; index is -1 when no point in the range has a value yet
+        struct Entry
+        {
+            int64_t value;
+            int64_t index;
+        };
+
+        RangeMaxTree(const std::vector<int64_t>& u, const std::vector<int64_t>& v);
+
+        // Function to raise the value of a point
+        void update(size_t point, int64_t value);
+
+        // Function to get the best point with u in [u_low, u_high] and v <= v_high (ties: lowest index)
+        Entry query(int64_t u_low, int64_t u_high, int64_t v_high) const;
+
+    private:
+        using key_type = std::pair<int64_t, uint32_t>; // (v, point)
+
+        static bool _better(const Entry& lhs, const Entry& rhs) noexcept;
+        void _take(size_t node, int64_t v_high, Entry& best) const;
+
+        size_t _size; // Number of leaves (a power of two)
+        std::vector<int64_t> _u_sorted; // u of the points in leaf order
+        std::vector<size_t> _leaf; // Leaf of every point
+        std::vector<int64_t> _v; // v of every point
+        std::vector<size_t> _offset; // Start of every node in _keys (node i holds _offset[i] .. _offset[i + 1])
+        std::vector<key_type> _keys; // Sorted keys below every node, node after node
+        std::vector<Entry> _fenwick; // Prefix max over the keys of every node, one slot ahead of _keys (1-based trees)
+    };
+
+    // Function to chain anchors (center position, row position, length): anchor j may follow i when it ends
+    // later on both sequences and counts its length minus its overlap with i. Returns the anchors of the best
+    // scoring chain in order, and its score in score if given. Runs in O(n log^2 n) with three RangeMaxTrees.
+    std::vector<size_t> chain_anchors(const std::vector<std::array<size_t, 3>>& anchors, int64_t* score = nullptr);
+}
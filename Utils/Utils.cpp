@@ -1,1122 +1,1607 @@
-﻿#include "Utils.hpp"
-#include "Pseudo.hpp"
-#include "Fasta.hpp"
-#include "Arguments.hpp"
-
-#include <stdio.h>
-#include <regex>
-#include <iostream>
-#include <limits>
-#include <iomanip>
-#include <list>
-#include <fstream>
-
-#if defined(_WIN32)
-#include <io.h> 
-#include <direct.h>
-#elif defined(__unix__) || defined(__unix) || defined(unix)
-#include <sys/stat.h>
-#include <unistd.h>
-#endif
-char chars[8] = { 'N','A','C','G','T','N','N','-' };
-int my_mk_dir(std::string output_dir)
-{
-#if defined(_WIN32)
-    if (0 != access(output_dir.c_str(), 0))
-    {
-        return mkdir(output_dir.c_str());
-    }
-    else
-        return 0;
-#elif defined(__unix__) || defined(__unix) || defined(unix)
-    if (access(output_dir.c_str(), F_OK) == -1) 
-    {
-        return mkdir(output_dir.c_str(), S_IRWXU | S_IRUSR | S_IWUSR | S_IXUSR | S_IRWXG | S_IRWXO);
-    }
-    else
-        return 0;
-#else
-    return -1;
-#endif
-    return -1;
-}
-void cout_cur_time()
-{
-    auto now = std::chrono::system_clock::now();
-    uint64_t dis_millseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count()
-        - std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count() * 1000;
-    time_t tt = std::chrono::system_clock::to_time_t(now);
-    auto time_tm = localtime(&tt);
-    char strTime[25] = { 0 };
-    sprintf(strTime, "%d-%02d-%02d %02d:%02d:%02d | ", time_tm->tm_year + 1900,
-        time_tm->tm_mon + 1, time_tm->tm_mday, time_tm->tm_hour,
-        time_tm->tm_min, time_tm->tm_sec);
-    std::cout << strTime;
-}
-
-size_t getPeakRSS()
-{
-#if defined(_WIN32)
-    /* Windows -------------------------------------------------- */
-    PROCESS_MEMORY_COUNTERS info;
-    GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info));
-    return (size_t)info.PeakWorkingSetSize;
-
-#elif (defined(_AIX) || defined(__TOS__AIX__)) || (defined(__sun__) || defined(__sun) || defined(sun) && (defined(__SVR4) || defined(__svr4__)))
-    /* AIX and Solaris ------------------------------------------ */
-    struct psinfo psinfo;
-    int fd = -1;
-    if ((fd = open("/proc/self/psinfo", O_RDONLY)) == -1)
-        return (size_t)0L;        /* Can't open? */
-    if (read(fd, &psinfo, sizeof(psinfo)) != sizeof(psinfo))
-    {
-        close(fd);
-        return (size_t)0L;        /* Can't read? */
-    }
-    close(fd);
-    return (size_t)(psinfo.pr_rssize * 1024L);
-#elif defined(__unix__) || defined(__unix) || defined(unix) || (defined(__APPLE__) && defined(__MACH__))
-    /* BSD, Linux, and OSX -------------------------------------- */
-    struct rusage rusage;
-    getrusage(RUSAGE_SELF, &rusage);
-#if defined(__APPLE__) && defined(__MACH__)
-    return (size_t)rusage.ru_maxrss;
-#else
-    return (size_t)(rusage.ru_maxrss * 1024L);
-#endif
-#else
-    /* Unknown OS ----------------------------------------------- */
-    return (size_t)0L;            /* Unsupported. */
-#endif
-}
-
-#if defined(_WIN32)
-void getFiles_win(std::string path, std::vector<std::string>& files)
-{
-    //文件句柄
-    intptr_t hFile = 0;
-    //文件信息
-    struct _finddata_t fileinfo;
-    std::string p;
-    if ((hFile = _findfirst(p.assign(path).append("\\*").c_str(), &fileinfo)) != -1)
-    {
-        do
-        {
-            if ((fileinfo.attrib & _A_SUBDIR))
-            {
-                if (strcmp(fileinfo.name, ".") != 0 && strcmp(fileinfo.name, "..") != 0)
-                    getFiles_win(p.assign(path).append("\\").append(fileinfo.name), files);
-            }
-            else
-            {
-                files.emplace_back(p.assign(path).append(fileinfo.name));
-            }
-        } while (_findnext(hFile, &fileinfo) == 0);
-        _findclose(hFile);
-    }
-}
-#elif defined(__unix__) || defined(__unix) || defined(unix)
-void getFiles_linux(std::string path, std::vector<std::string>& filenames)
-{
-    DIR* pDir = NULL;
-    struct dirent* ptr=NULL;
-    if (!(pDir = opendir(path.c_str()))) {
-        std::cout << "Folder doesn't Exist!" << std::endl;
-        return;
-    }
-    while ((ptr = readdir(pDir)) != 0) {
-        if (strcmp(ptr->d_name, ".") != 0 && strcmp(ptr->d_name, "..") != 0) {
-            filenames.emplace_back(path + ptr->d_name);
-        }
-    }
-    closedir(pDir);
-}
-#endif
-
-int NSCORE = 0;
-int HOXD70[6][6] = { {},{0,91,-114,-31,-123,NSCORE},{0,-114,100,-125,-31,NSCORE},{0,-31,-125,100,-114,NSCORE},
-    {0,-123,-31,-114,91,NSCORE},{0,NSCORE,NSCORE,NSCORE,NSCORE,NSCORE} };
-int cs[8] = { 0,91,100,100,91,0,0,0 };
-int d = 400, e = 30; 
-int stop_g = 5;
-std::vector<unsigned char> ACGT = { nucleic_acid_pseudo::A ,nucleic_acid_pseudo::C ,nucleic_acid_pseudo::G ,nucleic_acid_pseudo::T };
-
-std::string utils::remove_white_spaces(const std::string& str) 
-{
-    static const std::regex white_spaces("\\s+");
-    return std::regex_replace(str, white_spaces, "");
-}
-
-std::vector<unsigned char> utils::to_pseudo(const std::string& str)
-{
-    std::vector<unsigned char> pseu;
-    pseu.reserve((size_t)(str.size() * 1.3));
-    unsigned char c;
-    for (size_t i=0;i<str.size();i++)
-    {
-        c = to_pseudo(str[i]);
-        if (c != nucleic_acid_pseudo::N)
-            pseu.emplace_back(c); 
-        else
-            pseu.emplace_back(ACGT[i % 4]);
-    }
-    return pseu;
-}
-
-std::string utils::from_pseudo(const std::vector<unsigned char>& pseu)
-{
-    static constexpr char map[nucleic_acid_pseudo::NUMBER]{ '-', 'c', 'g', 'a', 't', 'n' };
-
-    std::string str;
-    str.reserve(pseu.size());
-
-    for (auto i : pseu) str.push_back(map[i]);
-    return str;
-}
-
-unsigned char* _get_map()
-{
-    using namespace nucleic_acid_pseudo;
-
-    static unsigned char map[std::numeric_limits<unsigned char>::max()];
-    memset(map, N, sizeof(map));
-
-    // map['-'] = GAP; // we could not process sequences with '-'
-    map['c'] = map['C'] = C;
-    map['g'] = map['G'] = G;
-    map['a'] = map['A'] = A;
-    map['t'] = map['T'] = map['u'] = map['U'] = T;
-    map['N'] = map['R'] = map['Y'] = map['M'] = map['K'] = map['S'] = map['W'] = map['H'] = map['B'] = map['V'] = map['D'] = N;
-    map['n'] = map['r'] = map['y'] = map['m'] = map['k'] = map['s'] = map['w'] = map['h'] = map['b'] = map['v'] = map['d'] = N;
-    return map;
-}
-
-static const unsigned char* _map = _get_map();
-
-unsigned char utils::to_pseudo(char ch)  
-{
-    return _map[ch];
-}
-
-std::vector<std::vector<unsigned char>> utils::read_to_pseudo(std::istream& is, std::string& center_name, int& II, int& center_) 
-{
-    std::vector<std::vector<unsigned char>> sequences;
-
-    std::string each_line;
-    std::string each_sequence;
-    for (bool flag = false; std::getline(is, each_line); )
-    {
-        if (each_line.size() == 0 || (each_line.size() == 1 && (int)each_line[0] == 13)) 
-            continue;
-
-        if (each_line[0] == '>')
-        {
-            each_line.erase(0, 1);
-            if ((int)(*each_line.rbegin()) == 13)
-                each_line.pop_back();
-            each_line.erase(std::remove_if(each_line.begin(), each_line.end(), [](char c) {
-                return (c == ' ' || c == '\t');
-                }), each_line.end());
-            if (center_ == -1 && each_line == center_name)
-                center_ = II;
-            II++;
-            if (flag)
-            {
-                sequences.emplace_back(to_pseudo(each_sequence));
-                each_sequence.clear();
-            }
-            flag = true;
-        }
-        else if (flag)
-        {
-            each_sequence += each_line;
-            if ((int)(*each_line.rbegin()) == 13)
-                each_sequence.pop_back();
-        }
-    }
-
-    sequences.emplace_back(to_pseudo(each_sequence));
-    return sequences;  
-}
-
-void insert_others(utils::Insertion2 That, utils::Insertion2 This, std::vector<std::vector<utils::Insertion2>>& more_insertions,
-    int k, int sequence_number, int* ii)
-{
-    for (int m = 0; m < sequence_number; m++)
-    {
-        if (m == k)
-        {
-            while ((ii[m] < more_insertions[m].size()) && (more_insertions[m][ii[m]].index < That.index)) ii[m]++;
-            if (ii[m] == more_insertions[m].size())
-                more_insertions[m].emplace_back(That);
-            else if (more_insertions[m][ii[m]].index == That.index)
-            {
-                more_insertions[m][ii[m]].n_num += That.n_num;
-                more_insertions[m][ii[m]].gap_num += That.gap_num;
-            }
-            else
-                more_insertions[m].insert(more_insertions[m].begin() + (ii[m]++), That);
-        }
-        else
-        {
-            while ((ii[m] < more_insertions[m].size()) && (more_insertions[m][ii[m]].index < This.index)) ii[m]++;
-            if (ii[m] == more_insertions[m].size())
-                more_insertions[m].emplace_back(This);
-            else if (more_insertions[m][ii[m]].index == This.index)
-            {
-                more_insertions[m][ii[m]].n_num += This.n_num;
-                more_insertions[m][ii[m]].gap_num += This.gap_num;
-            }
-            else
-                more_insertions[m].insert(more_insertions[m].begin() + (ii[m]++), This);
-        }
-    }
-}
-
-void utils::insert_and_write_file(std::ostream& os, std::vector<std::vector<unsigned char>>& sequences,
-    std::vector<std::vector<Insertion>>& insertions, const std::vector<std::vector<Insertion>>& N_insertions,
-    std::vector<std::string>& name, std::vector<bool>& sign)
-{
-    std::string each_sequence, each_line;
-    const size_t sequence_number = insertions.size();
-    std::vector<std::vector<Insertion2>> all_insertions;
-    std::vector<Insertion2> i_all_insertions;
-    int* len_sequences = new int[sequence_number];
-    int* ii = new int[sequence_number]();
-    int i = 0, j = 0, pre = 0, diff, mi, k;
-    std::vector<std::vector<Insertion2>> more_insertions(sequence_number);
-    
-    size_t g_num;
-
-    for (int k = 0; k < sequence_number; k++)  len_sequences[k] = sequences[k].size();
-    //变insertions
-    for (int k = 0; k < sequence_number; k++)
-    {
-        i = 0; j = 0; g_num = 0;
-        for (int kk = 0; kk < sequence_number; kk++) ii[kk] = 0;
-        std::vector<Insertion2>().swap(i_all_insertions);
-        while (i < insertions[k].size() && j < N_insertions[k].size())
-        {
-            if (insertions[k][i].index == N_insertions[k][j].index)
-            {
-                g_num += insertions[k][i].number;
-                if (N_insertions[k][j].number > insertions[k][i].number)
-                {
-                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,insertions[k][i].number, 0 })); 
-                    insert_others(Insertion2({ insertions[k][i].index + g_num ,N_insertions[k][j].number - insertions[k][i].number, 0 }), utils::Insertion2({ insertions[k][i].index + g_num ,0, N_insertions[k][j].number - insertions[k][i].number }), more_insertions, k, sequence_number, ii);
-                }
-                else
-                {
-                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,N_insertions[k][j].number ,insertions[k][i].number - N_insertions[k][j].number }));
-                }
-                i++;
-                j++;
-            }
-            else if (insertions[k][i].index > N_insertions[k][j].index)
-            {
-                insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
-                j++;
-            }
-            else
-            {
-                g_num += insertions[k][i].number;
-                i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
-                i++;
-            }
-        }
-        while (j < N_insertions[k].size())
-        {
-            insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
-            j++;
-        }
-        while (i < insertions[k].size()) 
-        {
-            g_num += insertions[k][i].number;
-            i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
-            i++;
-        }
-        all_insertions.emplace_back(i_all_insertions);
-        /*for (int m = 0; m < sequence_number; m++)
-        {
-            for (int d = 0; d < insertions[m].size(); d++)
-            {
-                std::cout << insertions[m][d].index << " " << insertions[m][d].number << "\n";
-            }
-            std::cout << "\n";
-        }
-            std::cout << k<<" \n";*/
-    }
-
-    /*for (int k = 0; k < sequence_number; k++)
-    {
-        for (int d = 0; d < insertions[k].size(); d++)
-        {
-            std::cout << insertions[k][d].index << " " << insertions[k][d].number << "\n";
-        }
-        std::cout << k << "\n";
-    }
-    for (int k = 0; k < sequence_number; k++)
-    {
-        for (int d = 0; d < N_insertions[k].size(); d++)
-        {
-            std::cout << N_insertions[k][d].index << " " << N_insertions[k][d].number << "\n";
-        }
-        std::cout << k << "\n";
-    }
-    for (int k = 0; k < sequence_number; k++)
-    {
-        for (int d = 0; d < all_insertions[k].size(); d++)
-        {
-            std::cout << all_insertions[k][d].index << " " << all_insertions[k][d].n_num<<" "<< all_insertions[k][d].gap_num << "\n";
-        }
-        std::cout << k << "\n";
-    }
-    for (int k = 0; k < sequence_number; k++)
-    {
-        for (int d = 0; d < more_insertions[k].size(); d++)
-        {
-            std::cout << more_insertions[k][d].index << " " << more_insertions[k][d].n_num << " " << more_insertions[k][d].gap_num << "\n";
-        }
-        std::cout << k<<"\n";
-    }*/
-
-    int min_size, min_i;
-    std::vector<Insertion> multi;
-    std::vector<Insertion> tmp;
-    for (int k = 0; k < sequence_number; k++)
-        if (k == 0 || more_insertions[k].size() < min_size)
-        {
-            min_size = more_insertions[k].size();
-            min_i = k;
-        }
-    i = 0; j = 0;
-    if (min_i == 0) diff = 1;
-    else diff = 0;
-    while (i < more_insertions[diff].size() && j < more_insertions[min_i].size())
-    {
-        if (more_insertions[diff][i].index == more_insertions[min_i][j].index)
-        {
-            if (more_insertions[diff][i].gap_num == 0 || more_insertions[min_i][j].gap_num == 0);
-            else if (more_insertions[diff][i].gap_num > more_insertions[min_i][j].gap_num)
-                multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[min_i][j].gap_num }));
-            else multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[diff][i].gap_num }));
-            i++; j++;
-        }
-        else if (more_insertions[diff][i].index > more_insertions[min_i][j].index) j++;
-        else i++;
-    }
-
-    if (min_i == 0)
-        for (int k = 2; k < sequence_number; k++)
-        {
-            i = 0; j = 0;
-            std::vector<Insertion>().swap(tmp);
-            while (i < more_insertions[k].size() && j < multi.size())
-            {
-                if (more_insertions[k][i].index == multi[j].index)
-                {
-                    if (more_insertions[k][i].gap_num == 0);
-                    else if (more_insertions[k][i].gap_num > multi[j].number)
-                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
-                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
-                    i++; j++;
-                }
-                else if (more_insertions[k][i].index > multi[j].index) j++;
-                else i++;
-            }
-            multi = tmp;
-        }
-    else
-        for (int k = 1; k < sequence_number; k++)
-        {
-            if (k == min_i) continue;
-            i = 0; j = 0;
-            std::vector<Insertion>().swap(tmp);
-            while (i < more_insertions[k].size() && j < multi.size())
-            {
-                if (more_insertions[k][i].index == multi[j].index)
-                {
-                    if (more_insertions[k][i].gap_num == 0);
-                    else if (more_insertions[k][i].gap_num > multi[j].number)
-                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
-                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
-                    i++; j++;
-                }
-                else if (more_insertions[k][i].index > multi[j].index) j++;
-                else i++;
-            }
-            multi = tmp;
-        }
-
-    for (i = 0; i < sequence_number; i++)
-    {
-        if (sign[i]) os << "> " << name[i] << " + " << "\n";
-        else os << "> " << name[i] << " - " << "\n";
-        std::ofstream tmpo(arguments::tmp_file_name, std::ios::binary | std::ios::out);
-        k = 0;
-        for (j = 0; j < all_insertions[i].size(); j++)
-        {
-            while (k < all_insertions[i][j].index)
-                tmpo << chars[sequences[i][k++]];
-            for (int p = 0; p < all_insertions[i][j].n_num; p++)
-                tmpo << 'N';
-            for (int p = 0; p < all_insertions[i][j].gap_num; p++)
-                tmpo << '-';
-        }while (k < sequences[i].size())tmpo << chars[sequences[i][k++]];
-        tmpo.close();
-        //read
-        std::ifstream tmpi(arguments::tmp_file_name, std::ios::binary | std::ios::in);
-        while (std::getline(tmpi, each_line))
-        {
-            if (each_line.size() == 0 || (each_line.size() == 1 && (int)each_line[0] == 13)) 
-                continue;
-            each_sequence += each_line;
-            if ((int)(*each_line.rbegin()) == 13)
-                each_sequence.pop_back();
-        }
-        tmpi.close();
-        sequences[i].assign(each_sequence.begin(), each_sequence.end());
-        each_sequence.clear();
-        each_line.clear();
-        //second insert
-        mi = 0;
-        k = 0;
-        for (j = 0; j < more_insertions[i].size(); j++)
-        {
-            while (k < more_insertions[i][j].index)
-                os << sequences[i][k++];
-            for (int p = 0; p < more_insertions[i][j].n_num; p++)
-                os << 'N';
-            if (mi < multi.size() && more_insertions[i][j].index == multi[mi].index)
-            {
-                for (int p = 0; p < (more_insertions[i][j].gap_num - multi[mi].number); p++)
-                    os << '-';
-                mi++;
-            }
-            else
-                for (int p = 0; p < more_insertions[i][j].gap_num; p++)
-                    os << '-';
-        }while (k < sequences[i].size()) os << sequences[i][k++];
-        std::vector<unsigned char>().swap(sequences[i]);
-        os << "\n";
-    }os << "\n";
-    remove(arguments::tmp_file_name.data());
-    /*std::vector<std::vector<Insertion2>>().swap(all_insertions);
-    std::vector<Insertion2>().swap(i_all_insertions);
-    std::vector<std::vector<Insertion2>>().swap(more_insertions);
-    std::vector<Insertion>().swap(multi);
-    std::vector<Insertion>().swap(tmp);
-    delete[] ii;*/
-}
-
-int* utils::vector_insertion_gap_N(std::vector<std::vector<unsigned char>>& sequences, 
-    std::vector<std::vector<Insertion>>& insertions, const std::vector<std::vector<Insertion>>& N_insertions) 
-{
-    const size_t sequence_number = insertions.size();
-    std::vector<std::vector<Insertion2>> all_insertions;
-    std::vector<Insertion2> i_all_insertions;
-    int* len_sequences = new int[sequence_number];
-    int* ii = new int[sequence_number]();
-    std::vector<unsigned char> tmp_vector;
-    int i = 0, j = 0, pre = 0, diff, mi;
-    std::vector<std::vector<Insertion2>> more_insertions(sequence_number);
-
-    size_t g_num;
-    for (int k = 0; k < sequence_number; k++)  len_sequences[k] = sequences[k].size();
-    for (i = 0; i < sequence_number; i++)
-        for (j = 0; j < N_insertions[i].size(); j++)
-            len_sequences[i] += N_insertions[i][j].number;
-    //变insertions
-    for (int k = 0; k < sequence_number; k++)
-    {
-        i = 0; j = 0; g_num = 0;
-        for (int kk = 0; kk < sequence_number; kk++) ii[kk] = 0;
-        std::vector<Insertion2>().swap(i_all_insertions);
-        while (i < insertions[k].size() && j < N_insertions[k].size())
-        {
-            if (insertions[k][i].index == N_insertions[k][j].index)
-            {
-                g_num += insertions[k][i].number;
-                if (N_insertions[k][j].number > insertions[k][i].number)
-                {
-                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,insertions[k][i].number, 0 })); 
-                    insert_others(Insertion2({ insertions[k][i].index + g_num ,N_insertions[k][j].number - insertions[k][i].number, 0 }), utils::Insertion2({ insertions[k][i].index + g_num ,0, N_insertions[k][j].number - insertions[k][i].number }), more_insertions, k, sequence_number, ii);
-                }
-                else
-                {
-                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,N_insertions[k][j].number ,insertions[k][i].number - N_insertions[k][j].number }));
-                }
-                i++;
-                j++;
-            }
-            else if (insertions[k][i].index > N_insertions[k][j].index) 
-            {
-                insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
-                j++;
-            }
-            else
-            {
-                g_num += insertions[k][i].number;
-                i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
-                i++;
-            }
-        }
-        while (j < N_insertions[k].size()) 
-        {
-            insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
-            j++;
-        }
-        while (i < insertions[k].size()) 
-        {
-            g_num += insertions[k][i].number;
-            i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
-            i++;
-        }
-        all_insertions.emplace_back(i_all_insertions);
-        /*for (int m = 0; m < sequence_number; m++)
-        {
-            for (int d = 0; d < insertions[m].size(); d++)
-            {
-                std::cout << insertions[m][d].index << " " << insertions[m][d].number << "\n";
-            }
-            std::cout << "\n";
-        }
-            std::cout << k<<" \n";*/
-    }
-
-    /*for (int k = 0; k < sequence_number; k++)
-    {
-        for (int d = 0; d < insertions[k].size(); d++)
-        {
-            std::cout << insertions[k][d].index << " " << insertions[k][d].number << "\n";
-        }
-        std::cout << k << "\n";
-    }
-    for (int k = 0; k < sequence_number; k++)
-    {
-        for (int d = 0; d < N_insertions[k].size(); d++)
-        {
-            std::cout << N_insertions[k][d].index << " " << N_insertions[k][d].number << "\n";
-        }
-        std::cout << k << "\n";
-    }
-    for (int k = 0; k < sequence_number; k++)
-    {
-        for (int d = 0; d < all_insertions[k].size(); d++)
-        {
-            std::cout << all_insertions[k][d].index << " " << all_insertions[k][d].n_num<<" "<< all_insertions[k][d].gap_num << "\n";
-        }
-        std::cout << k << "\n";
-    }
-    for (int k = 0; k < sequence_number; k++)
-    {
-        for (int d = 0; d < more_insertions[k].size(); d++)
-        {
-            std::cout << more_insertions[k][d].index << " " << more_insertions[k][d].n_num << " " << more_insertions[k][d].gap_num << "\n";
-        }
-        std::cout << k<<"\n";
-    }*/
-
-    int min_size, min_i;
-    std::vector<Insertion> multi;
-    std::vector<Insertion> tmp;
-    for (int k = 0; k < sequence_number; k++)
-        if (k == 0 || more_insertions[k].size() < min_size)
-        {
-            min_size = more_insertions[k].size();
-            min_i = k;
-        }
-    i = 0; j = 0;
-    if (min_i == 0) diff = 1;
-    else diff = 0;
-    while (i < more_insertions[diff].size() && j < more_insertions[min_i].size())
-    {
-        if (more_insertions[diff][i].index == more_insertions[min_i][j].index)
-        {
-            if (more_insertions[diff][i].gap_num == 0 || more_insertions[min_i][j].gap_num == 0);
-            else if (more_insertions[diff][i].gap_num > more_insertions[min_i][j].gap_num)
-                multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[min_i][j].gap_num }));
-            else multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[diff][i].gap_num }));
-            i++; j++;
-        }
-        else if (more_insertions[diff][i].index > more_insertions[min_i][j].index) j++;
-        else i++;
-    }
-
-    if (min_i == 0)
-        for (int k = 2; k < sequence_number; k++)
-        {
-            i = 0; j = 0;
-            std::vector<Insertion>().swap(tmp);
-            while (i < more_insertions[k].size() && j < multi.size())
-            {
-                if (more_insertions[k][i].index == multi[j].index)
-                {
-                    if (more_insertions[k][i].gap_num == 0);
-                    else if (more_insertions[k][i].gap_num > multi[j].number)
-                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
-                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
-                    i++; j++;
-                }
-                else if (more_insertions[k][i].index > multi[j].index) j++;
-                else i++;
-            }
-            multi = tmp;
-        }
-    else
-        for (int k = 1; k < sequence_number; k++)
-        {
-            if (k == min_i) continue;
-            i = 0; j = 0;
-            std::vector<Insertion>().swap(tmp);
-            while (i < more_insertions[k].size() && j < multi.size())
-            {
-                if (more_insertions[k][i].index == multi[j].index)
-                {
-                    if (more_insertions[k][i].gap_num == 0);
-                    else if (more_insertions[k][i].gap_num > multi[j].number)
-                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
-                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
-                    i++; j++;
-                }
-                else if (more_insertions[k][i].index > multi[j].index) j++;
-                else i++;
-            }
-            multi = tmp;
-        }
-
-    int more = 0, all_size = 0, ti = 0, k = 0;
-    for (i = 0; i < sequence_number; i++)
-    {
-        if (i == 0)
-        {
-            more = sequences[i].size();
-            for (j = 0; j < all_insertions[i].size(); j++)
-                more += (all_insertions[i][j].n_num + all_insertions[i][j].gap_num);
-            all_size = more;
-            mi = 0;
-            for (j = 0; j < more_insertions[i].size(); j++)
-            {
-                all_size += more_insertions[i][j].n_num;
-                if (mi < multi.size() && more_insertions[i][j].index == multi[mi].index)
-                    all_size -= multi[mi++].number;
-                all_size += more_insertions[i][j].gap_num;
-            }
-            tmp_vector.resize(more);
-        }
-
-        ti = 0;
-        k = 0;
-        for (j = 0; j < all_insertions[i].size(); j++)
-        {
-            while (k < all_insertions[i][j].index)
-                tmp_vector[ti++] = sequences[i][k++];
-            for (int p = 0; p < all_insertions[i][j].n_num; p++)
-                tmp_vector[ti++] = '\5';
-            for (int p = 0; p < all_insertions[i][j].gap_num; p++)
-                tmp_vector[ti++] = '\7';
-        }while (k < sequences[i].size())tmp_vector[ti++] = sequences[i][k++];
-
-        sequences[i].resize(all_size);
-        mi = 0;
-        k = 0;
-        ti = 0;
-        for (j = 0; j < more_insertions[i].size(); j++)
-        {
-            while (ti < more_insertions[i][j].index)
-                sequences[i][k++] = tmp_vector[ti++];
-            for (int p = 0; p < more_insertions[i][j].n_num; p++)
-                sequences[i][k++] = '\5';
-            if (mi < multi.size() && more_insertions[i][j].index == multi[mi].index)
-            {
-                for (int p = 0; p < (more_insertions[i][j].gap_num - multi[mi].number); p++)
-                    sequences[i][k++] = '\7';
-                mi++;
-            }
-            else
-                for (int p = 0; p < more_insertions[i][j].gap_num; p++)
-                    sequences[i][k++] = '\7';
-        }while (ti < more) sequences[i][k++] = tmp_vector[ti++];
-
-    }
-
-
-    std::vector<unsigned char>().swap(tmp_vector);
-    std::vector<std::vector<Insertion2>>().swap(all_insertions);
-    std::vector<Insertion2>().swap(i_all_insertions);
-    std::vector<std::vector<Insertion2>>().swap(more_insertions);
-    std::vector<Insertion>().swap(multi);
-    std::vector<Insertion>().swap(tmp);
-    delete[] ii;
-    return len_sequences;
-}
-
-void utils::insert_and_write_fasta(std::ostream& os, std::vector<std::vector<unsigned char>>& sequences,
-    std::vector<std::vector<Insertion>>& insertions, std::vector<std::vector<Insertion>>& N_insertions,
-    std::vector<std::string>& name,bool TU)
-{
-    if (!TU) chars[4] = 'U';
-    //std::cout << "0memory usage: " << getPeakRSS() << " B" << std::endl;
-    const size_t sequence_number = insertions.size();
-    //std::cout << "insertions " << sequence_number << " " << insertions[0].size() << " " << insertions[1].size() << "\n";
-    int score = 0, length = 0, name_len = 0;
-
-    for (int i = 0; i < name.size(); i++)
-        if (name_len < name[i].size())
-            name_len = name[i].size();
-    const auto align_start1 = std::chrono::high_resolution_clock::now(); 
-
-    std::vector<std::vector<Insertion2>> all_insertions;
-    std::vector<Insertion2> i_all_insertions;
-    int* len_sequences = new int[sequence_number];
-    int* ii = new int[sequence_number]();
-    int* score_two = NULL;
-    std::vector<unsigned char> tmp_vector;
-    int i = 0, j = 0, pre = 0, diff, mi;
-    std::vector<std::vector<Insertion2>> more_insertions(sequence_number);
-
-    size_t g_num;
-    for (int k = 0; k < sequence_number; k++)  len_sequences[k] = sequences[k].size();
-    for (i = 0; i < sequence_number; i++)
-        for (j = 0; j < N_insertions[i].size(); j++)
-            len_sequences[i] += N_insertions[i][j].number;
-
-    for (int k = 0; k < sequence_number; k++)
-    {
-        i = 0; j = 0; g_num = 0;
-        for (int kk = 0; kk < sequence_number; kk++) ii[kk] = 0;
-        std::vector<Insertion2>().swap(i_all_insertions);
-        while (i < insertions[k].size() && j < N_insertions[k].size())
-        {
-            if (insertions[k][i].index == N_insertions[k][j].index)
-            {
-                g_num += insertions[k][i].number;
-                if (N_insertions[k][j].number > insertions[k][i].number)
-                {
-                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,insertions[k][i].number, 0 })); 
-                    insert_others(Insertion2({ insertions[k][i].index + g_num ,N_insertions[k][j].number - insertions[k][i].number, 0 }), utils::Insertion2({ insertions[k][i].index + g_num ,0, N_insertions[k][j].number - insertions[k][i].number }), more_insertions, k, sequence_number, ii);
-                }
-                else
-                {
-                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,N_insertions[k][j].number ,insertions[k][i].number - N_insertions[k][j].number }));
-                }
-                i++;
-                j++;
-            }
-            else if (insertions[k][i].index > N_insertions[k][j].index)
-            {
-                insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
-                j++;
-            }
-            else
-            {
-                g_num += insertions[k][i].number;
-                i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
-                i++;
-            }
-        }
-        while (j < N_insertions[k].size())
-        {
-            insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
-            j++;
-        }
-        while (i < insertions[k].size()) 
-        {
-            g_num += insertions[k][i].number;
-            i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
-            i++;
-        }
-        all_insertions.emplace_back(i_all_insertions);
-    }
-
-    for (i = 0; i < N_insertions[i].size(); i++)
-    {
-        std::vector<Insertion>().swap(N_insertions[i]);
-        std::vector<Insertion>().swap(insertions[i]);
-    }
-    std::vector<std::vector<Insertion>>().swap(N_insertions);
-    std::vector<std::vector<Insertion>>().swap(insertions);
-
-    int min_size, min_i;
-    std::vector<Insertion> multi;
-    std::vector<Insertion> tmp;
-    for (int k = 0; k < sequence_number; k++)
-        if (k == 0 || more_insertions[k].size() < min_size)
-        {
-            min_size = more_insertions[k].size();
-            min_i = k;
-        }
-    i = 0; j = 0;
-    if (min_i == 0) diff = 1;
-    else diff = 0;
-    while (i < more_insertions[diff].size() && j < more_insertions[min_i].size())
-    {
-        if (more_insertions[diff][i].index == more_insertions[min_i][j].index)
-        {
-            if (more_insertions[diff][i].gap_num == 0 || more_insertions[min_i][j].gap_num == 0);
-            else if (more_insertions[diff][i].gap_num > more_insertions[min_i][j].gap_num)
-                multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[min_i][j].gap_num }));
-            else multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[diff][i].gap_num }));
-            i++; j++;
-        }
-        else if (more_insertions[diff][i].index > more_insertions[min_i][j].index) j++;
-        else i++;
-    }
-
-    if (min_i == 0)
-        for (int k = 2; k < sequence_number; k++)
-        {
-            i = 0; j = 0;
-            std::vector<Insertion>().swap(tmp);
-            while (i < more_insertions[k].size() && j < multi.size())
-            {
-                if (more_insertions[k][i].index == multi[j].index)
-                {
-                    if (more_insertions[k][i].gap_num == 0);
-                    else if (more_insertions[k][i].gap_num > multi[j].number)
-                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
-                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
-                    i++; j++;
-                }
-                else if (more_insertions[k][i].index > multi[j].index) j++;
-                else i++;
-            }
-            multi = tmp;
-        }
-    else
-        for (int k = 1; k < sequence_number; k++)
-        {
-            if (k == min_i) continue;
-            i = 0; j = 0;
-            std::vector<Insertion>().swap(tmp);
-            while (i < more_insertions[k].size() && j < multi.size())
-            {
-                if (more_insertions[k][i].index == multi[j].index)
-                {
-                    if (more_insertions[k][i].gap_num == 0);
-                    else if (more_insertions[k][i].gap_num > multi[j].number)
-                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
-                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
-                    i++; j++;
-                }
-                else if (more_insertions[k][i].index > multi[j].index) j++;
-                else i++;
-            }
-            multi = tmp;
-        }
-
-    int more = 0, all_size = 0, ti = 0, k = 0;
-    for (i = 0; i < sequence_number; i++)
-    {
-        if (i == 0)
-        {
-            more = sequences[i].size();
-            for (j = 0; j < all_insertions[i].size(); j++)
-                more += (all_insertions[i][j].n_num + all_insertions[i][j].gap_num);
-            all_size = more;
-            mi = 0;
-            for (j = 0; j < more_insertions[i].size(); j++)
-            {
-                all_size += more_insertions[i][j].n_num;
-                if (mi < multi.size() && more_insertions[i][j].index == multi[mi].index)
-                    all_size -= multi[mi++].number;
-                all_size += more_insertions[i][j].gap_num;
-            }
-            tmp_vector.resize(more);
-        }
-
-        ti = 0;
-        k = 0;
-        for (j = 0; j < all_insertions[i].size(); j++)
-        {
-            while (k < all_insertions[i][j].index)
-                tmp_vector[ti++] = sequences[i][k++];
-            for (int p = 0; p < all_insertions[i][j].n_num; p++)
-                tmp_vector[ti++] = '\5';
-            for (int p = 0; p < all_insertions[i][j].gap_num; p++)
-                tmp_vector[ti++] = '\7';
-        }
-        while (k < sequences[i].size())tmp_vector[ti++] = sequences[i][k++];
-
-        sequences[i].resize(all_size);
-        mi = 0;
-        k = 0;
-        ti = 0;
-        for (j = 0; j < more_insertions[i].size(); j++)
-        {
-            while (ti < more_insertions[i][j].index)
-                sequences[i][k++] = tmp_vector[ti++];
-            for (int p = 0; p < more_insertions[i][j].n_num; p++)
-                sequences[i][k++] = '\5';
-            if (mi < multi.size() && more_insertions[i][j].index == multi[mi].index)
-            {
-                for (int p = 0; p < (more_insertions[i][j].gap_num - multi[mi].number); p++)
-                    sequences[i][k++] = '\7';
-                mi++;
-            }
-            else
-                for (int p = 0; p < more_insertions[i][j].gap_num; p++)
-                    sequences[i][k++] = '\7';
-        }while (ti < more) sequences[i][k++] = tmp_vector[ti++];
-        os << "> " << name[i]<< "\n";
-        for (k = 0; k < sequences[i].size(); k++) os << chars[sequences[i][k]];
-        os << "\n";   
-        std::vector<unsigned char>().swap(sequences[i]);
-    }
-    std::vector<unsigned char>().swap(sequences[0]);
-    std::vector<unsigned char>().swap(tmp_vector);
-    std::vector<std::vector<Insertion2>>().swap(all_insertions);
-    std::vector<Insertion2>().swap(i_all_insertions);
-    std::vector<std::vector<Insertion2>>().swap(more_insertions);
-    std::vector<Insertion>().swap(multi);
-    std::vector<Insertion>().swap(tmp);
-    delete[] ii;
-}
-
-void utils::insert_and_write(std::ostream& os, std::istream& is, const std::vector<std::vector<Insertion>>& insertions)
-{
-    const size_t sequence_number = insertions.size();
-
-    std::string each_line;
-    std::string each_sequence;
-    std::string each_sequence_aligned;
-    for (unsigned count = 0, length, flag = false; std::getline(is, each_line); )
-    {
-        if (each_line.size() == 0 || (each_line.size() == 1 && (int)each_line[0] == 13)) //跳过空行
-            continue;
-
-        if (each_line[0] == '>')
-        {
-            if (flag)
-            {
-                if (count == 0)
-                {
-                    length = each_sequence.size();
-                    for (auto insertion : insertions[0])
-                        length += insertion.number;
-
-                    each_sequence_aligned.reserve(length);
-                    each_sequence.reserve(length);
-                }
-
-                utils::Insertion::insert_gaps(each_sequence.cbegin(), each_sequence.cend(),
-                    insertions[count].cbegin(), insertions[count].cend(), std::back_inserter(each_sequence_aligned), '-');
-
-                if (arguments::output_matrix)
-                    os << each_sequence_aligned;
-                else
-                    Fasta::cut_and_write(os, each_sequence_aligned);
-                os << '\n';
-
-                each_sequence.clear();
-                each_sequence_aligned.clear();
-                ++count;
-            }
-
-            if (arguments::output_matrix == false)
-                os << each_line << '\n';
-            flag = true;
-        }
-        else if (flag)
-        {
-            each_sequence += each_line;
-#if defined(__unix__) || defined(__unix) || defined(unix)
-            if ((int)(*each_line.rbegin()) == 13)
-                each_sequence.pop_back();
-#endif
-        }
-    }
-
-    utils::Insertion::insert_gaps(each_sequence.cbegin(), each_sequence.cend(),
-        insertions.back().cbegin(), insertions.back().cend(), std::back_inserter(each_sequence_aligned), '-');
-
-    if (arguments::output_matrix)
-        os << each_sequence_aligned;
-    else
-        Fasta::cut_and_write(os, each_sequence_aligned);
-}
-
-void utils::write_to_fasta(std::ostream& os, std::istream& is, std::vector<std::vector<Insertion>>& insertions, size_t& II)
-{
-    std::string each_line;
-    std::string each_sequence;
-    std::string pint_str;
-    std::string name;
-    for (bool flag = false; std::getline(is, each_line); )
-    {
-        if (each_line.size() == 0 || (each_line.size() == 1 && (int)each_line[0] == 13)) //跳过空行
-            continue;
-        if (each_line[0] == '>')
-        {
-            if (flag)
-            {
-                utils::write_to_str(pint_str, each_sequence, insertions[II++]);
-                os << name << "\n"<< pint_str<<"\n";
-                //insertions.erase(insertions.begin());
-                //for (int k = 0; k < pint_str.size(); k++) os << pint_str[k];
-                each_sequence.clear();
-            }
-            name = each_line;
-            flag = true;
-        }
-        else if (flag)
-        {
-            each_sequence += each_line;
-            if ((int)(*each_line.rbegin()) == 13)
-                each_sequence.pop_back();
-        }
-    }
-    utils::write_to_str(pint_str, each_sequence, insertions[II++]);
-    os << name << "\n" << pint_str << "\n";
-    //insertions.erase(insertions.begin());
-    return;
-}
-
-void utils::write_to_str(std::string& ans, std::string& each_sequence, std::vector<Insertion>& insertions)
-{
-    size_t ti = 0;
-    size_t k = 0;
-    if (arguments::ALL_LEN != 0)
-    {
-        if (ans.size() != arguments::ALL_LEN)
-            ans.resize(arguments::ALL_LEN);
-    }
-    else
-    {
-        arguments::ALL_LEN = each_sequence.size();
-        for (size_t j = 0; j < insertions.size(); j++)
-            arguments::ALL_LEN += insertions[j].number;
-        ans.resize(arguments::ALL_LEN);
-    }
-    /*for (size_t j = 0; j < insertions.size(); j++)
-    {
-        while (k < insertions[j].index)
-            ans[ti++] = each_sequence[k++];
-        for (int p = 0; p < insertions[j].number; p++)
-            ans[ti++] = '-';
-    }
-    while (k < each_sequence.size())ans[ti++] = each_sequence[k++];*/
-    for (const auto& insertion : insertions)
-    {
-        std::copy(each_sequence.begin() + k, each_sequence.begin() + insertion.index, ans.begin() + ti);
-        ti += insertion.index - k;
-
-        std::fill(ans.begin() + ti, ans.begin() + ti + insertion.number, '-');
-        ti += insertion.number;
-
-        k = insertion.index;
-    }
-
-    std::copy(each_sequence.begin() + k, each_sequence.end(), ans.begin() + ti);
-    return;
-}
-
-unsigned char* utils::copy_DNA(const std::vector<unsigned char>& sequence, unsigned char* A, size_t a_begin, size_t a_end)
-{
-    int i = 0;
-    while (a_begin < a_end)
-    {
-        A[i++] = sequence[a_begin++];
-    }
-    return A;
-}
+﻿#include "Utils.hpp"
+#include "Pseudo.hpp"
+#include "Fasta.hpp"
+#include "Arguments.hpp"
+#include "../multi-thread/multi.hpp"
+
+#include <stdio.h>
+#include <regex>
+#include <iostream>
+#include <limits>
+#include <iomanip>
+#include <list>
+#include <fstream>
+#include <cstring>
+#include <stdexcept>
+#include <exception>
+#include <mutex>
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+#if defined(_WIN32)
+#include <io.h> 
+#include <direct.h>
+#elif defined(__unix__) || defined(__unix) || defined(unix)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(__unix__) || defined(__unix) || defined(unix) || (defined(__APPLE__) && defined(__MACH__))
+#define FASTA_WRITER_USE_PWRITE 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <atomic>
+#endif
+char chars[8] = { 'N','A','C','G','T','N','N','-' };
+int my_mk_dir(std::string output_dir)
+{
+#if defined(_WIN32)
+    if (0 != access(output_dir.c_str(), 0))
+    {
+        return mkdir(output_dir.c_str());
+    }
+    else
+        return 0;
+#elif defined(__unix__) || defined(__unix) || defined(unix)
+    if (access(output_dir.c_str(), F_OK) == -1) 
+    {
+        return mkdir(output_dir.c_str(), S_IRWXU | S_IRUSR | S_IWUSR | S_IXUSR | S_IRWXG | S_IRWXO);
+    }
+    else
+        return 0;
+#else
+    return -1;
+#endif
+    return -1;
+}
+void cout_cur_time()
+{
+    auto now = std::chrono::system_clock::now();
+    uint64_t dis_millseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count()
+        - std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count() * 1000;
+    time_t tt = std::chrono::system_clock::to_time_t(now);
+    auto time_tm = localtime(&tt);
+    char strTime[25] = { 0 };
+    sprintf(strTime, "%d-%02d-%02d %02d:%02d:%02d | ", time_tm->tm_year + 1900,
+        time_tm->tm_mon + 1, time_tm->tm_mday, time_tm->tm_hour,
+        time_tm->tm_min, time_tm->tm_sec);
+    std::cout << strTime;
+}
+
+size_t getPeakRSS()
+{
+#if defined(_WIN32)
+    /* Windows -------------------------------------------------- */
+    PROCESS_MEMORY_COUNTERS info;
+    GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info));
+    return (size_t)info.PeakWorkingSetSize;
+
+#elif (defined(_AIX) || defined(__TOS__AIX__)) || (defined(__sun__) || defined(__sun) || defined(sun) && (defined(__SVR4) || defined(__svr4__)))
+    /* AIX and Solaris ------------------------------------------ */
+    struct psinfo psinfo;
+    int fd = -1;
+    if ((fd = open("/proc/self/psinfo", O_RDONLY)) == -1)
+        return (size_t)0L;        /* Can't open? */
+    if (read(fd, &psinfo, sizeof(psinfo)) != sizeof(psinfo))
+    {
+        close(fd);
+        return (size_t)0L;        /* Can't read? */
+    }
+    close(fd);
+    return (size_t)(psinfo.pr_rssize * 1024L);
+#elif defined(__unix__) || defined(__unix) || defined(unix) || (defined(__APPLE__) && defined(__MACH__))
+    /* BSD, Linux, and OSX -------------------------------------- */
+    struct rusage rusage;
+    getrusage(RUSAGE_SELF, &rusage);
+#if defined(__APPLE__) && defined(__MACH__)
+    return (size_t)rusage.ru_maxrss;
+#else
+    return (size_t)(rusage.ru_maxrss * 1024L);
+#endif
+#else
+    /* Unknown OS ----------------------------------------------- */
+    return (size_t)0L;            /* Unsupported. */
+#endif
+}
+
+#if defined(_WIN32)
+void getFiles_win(std::string path, std::vector<std::string>& files)
+{
+    //文件句柄
+    intptr_t hFile = 0;
+    //文件信息
+    struct _finddata_t fileinfo;
+    std::string p;
+    if ((hFile = _findfirst(p.assign(path).append("\\*").c_str(), &fileinfo)) != -1)
+    {
+        do
+        {
+            if ((fileinfo.attrib & _A_SUBDIR))
+            {
+                if (strcmp(fileinfo.name, ".") != 0 && strcmp(fileinfo.name, "..") != 0)
+                    getFiles_win(p.assign(path).append("\\").append(fileinfo.name), files);
+            }
+            else
+            {
+                files.emplace_back(p.assign(path).append(fileinfo.name));
+            }
+        } while (_findnext(hFile, &fileinfo) == 0);
+        _findclose(hFile);
+    }
+}
+#elif defined(__unix__) || defined(__unix) || defined(unix)
+void getFiles_linux(std::string path, std::vector<std::string>& filenames)
+{
+    DIR* pDir = NULL;
+    struct dirent* ptr=NULL;
+    if (!(pDir = opendir(path.c_str()))) {
+        std::cout << "Folder doesn't Exist!" << std::endl;
+        return;
+    }
+    while ((ptr = readdir(pDir)) != 0) {
+        if (strcmp(ptr->d_name, ".") != 0 && strcmp(ptr->d_name, "..") != 0) {
+            filenames.emplace_back(path + ptr->d_name);
+        }
+    }
+    closedir(pDir);
+}
+#endif
+
+int NSCORE = 0;
+int HOXD70[6][6] = { {},{0,91,-114,-31,-123,NSCORE},{0,-114,100,-125,-31,NSCORE},{0,-31,-125,100,-114,NSCORE},
+    {0,-123,-31,-114,91,NSCORE},{0,NSCORE,NSCORE,NSCORE,NSCORE,NSCORE} };
+int cs[8] = { 0,91,100,100,91,0,0,0 };
+int d = 400, e = 30; 
+int stop_g = 5;
+
+std::string utils::remove_white_spaces(const std::string& str) 
+{
+    static const std::regex white_spaces("\\s+");
+    return std::regex_replace(str, white_spaces, "");
+}
+
+std::vector<unsigned char> utils::to_pseudo(const std::string& str)
+{
+    std::vector<unsigned char> pseu(str.size());
+    pseu.resize(translate_to_pseudo(str.data(), str.data() + str.size(), pseu.data()));
+    fake_unknown(pseu.data(), pseu.data() + pseu.size(), 0);
+    return pseu;
+}
+
+std::string utils::from_pseudo(const std::vector<unsigned char>& pseu)
+{
+    static constexpr char map[8]{ '-', 'c', 'g', 'a', 't', 'n', '-', '-' };
+
+    std::string str(pseu.size(), '\0');
+    translate_from_pseudo(pseu.data(), pseu.data() + pseu.size(), &str[0], map);
+    return str;
+}
+
+unsigned char* _get_map()
+{
+    using namespace nucleic_acid_pseudo;
+
+    static unsigned char map[std::numeric_limits<unsigned char>::max() + 1];
+    memset(map, N, sizeof(map));
+
+    // map['-'] = GAP; // we could not process sequences with '-'
+    map['c'] = map['C'] = C;
+    map['g'] = map['G'] = G;
+    map['a'] = map['A'] = A;
+    map['t'] = map['T'] = map['u'] = map['U'] = T;
+    map['N'] = map['R'] = map['Y'] = map['M'] = map['K'] = map['S'] = map['W'] = map['H'] = map['B'] = map['V'] = map['D'] = N;
+    map['n'] = map['r'] = map['y'] = map['m'] = map['k'] = map['s'] = map['w'] = map['h'] = map['b'] = map['v'] = map['d'] = N;
+    return map;
+}
+
+static const unsigned char* _map = _get_map();
+
+unsigned char utils::to_pseudo(char ch)  
+{
+    return _map[(unsigned char)ch];
+}
+
+#if defined(__AVX2__)
+// Translate 32 bytes: case is folded with & 0xDF, then A/C/G (high nibble 4) and T/U (high nibble 5)
+// are looked up by their low nibble; every other byte becomes N, exactly as _map does
+static inline __m256i _to_pseudo_block(__m256i v)
+{
+    const __m256i lut4 = _mm256_setr_epi8(5, 1, 5, 2, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5, 5, 5,
+        5, 1, 5, 2, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5, 5, 5);
+    const __m256i lut5 = _mm256_setr_epi8(5, 5, 5, 5, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+        5, 5, 5, 5, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i upper = _mm256_and_si256(v, _mm256_set1_epi8((char)0xDF));
+    const __m256i lo = _mm256_and_si256(upper, nibble);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(upper, 4), nibble);
+    __m256i res = _mm256_set1_epi8(nucleic_acid_pseudo::N);
+    res = _mm256_blendv_epi8(res, _mm256_shuffle_epi8(lut4, lo), _mm256_cmpeq_epi8(hi, _mm256_set1_epi8(4)));
+    res = _mm256_blendv_epi8(res, _mm256_shuffle_epi8(lut5, lo), _mm256_cmpeq_epi8(hi, _mm256_set1_epi8(5)));
+    return res;
+}
+#elif defined(__SSSE3__)
+// Translate 16 bytes, same scheme as the AVX2 kernel
+static inline __m128i _to_pseudo_block(__m128i v)
+{
+    const __m128i lut4 = _mm_setr_epi8(5, 1, 5, 2, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5, 5, 5);
+    const __m128i lut5 = _mm_setr_epi8(5, 5, 5, 5, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i upper = _mm_and_si128(v, _mm_set1_epi8((char)0xDF));
+    const __m128i lo = _mm_and_si128(upper, nibble);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(upper, 4), nibble);
+    const __m128i m4 = _mm_cmpeq_epi8(hi, _mm_set1_epi8(4));
+    const __m128i m5 = _mm_cmpeq_epi8(hi, _mm_set1_epi8(5));
+    const __m128i n = _mm_andnot_si128(_mm_or_si128(m4, m5), _mm_set1_epi8(nucleic_acid_pseudo::N));
+    return _mm_or_si128(n, _mm_or_si128(_mm_and_si128(m4, _mm_shuffle_epi8(lut4, lo)), _mm_and_si128(m5, _mm_shuffle_epi8(lut5, lo))));
+}
+#endif
+
+// Translate raw bases to pseudo codes, dropping line breaks ('\r', '\n'); unknown bases stay N.
+// Returns the number of codes written. Blocks without line breaks take the SIMD path.
+size_t utils::translate_to_pseudo(const char* first, const char* last, unsigned char* des)
+{
+    unsigned char* const des_begin = des;
+#if defined(__AVX2__)
+    const __m256i cr = _mm256_set1_epi8('\r'), lf = _mm256_set1_epi8('\n');
+    for (; last - first >= 32; first += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf))) == 0)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(des), _to_pseudo_block(v));
+            des += 32;
+        }
+        else
+            for (const char* p = first; p != first + 32; ++p)
+                if (*p != '\r' && *p != '\n') *des++ = _map[(unsigned char)*p];
+    }
+#elif defined(__SSSE3__)
+    const __m128i cr = _mm_set1_epi8('\r'), lf = _mm_set1_epi8('\n');
+    for (; last - first >= 16; first += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf))) == 0)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(des), _to_pseudo_block(v));
+            des += 16;
+        }
+        else
+            for (const char* p = first; p != first + 16; ++p)
+                if (*p != '\r' && *p != '\n') *des++ = _map[(unsigned char)*p];
+    }
+#endif
+    for (; first != last; ++first)
+        if (*first != '\r' && *first != '\n') *des++ = _map[(unsigned char)*first];
+    return des - des_begin;
+}
+
+// Replace unknown bases by A/C/G/T in turn: position i (counted from offset) becomes (i & 3) + 1
+void utils::fake_unknown(unsigned char* first, unsigned char* last, size_t offset)
+{
+#if defined(__AVX2__) || defined(__SSSE3__)
+    static const unsigned char pattern[36] = { 1,2,3,4,1,2,3,4,1,2,3,4,1,2,3,4,1,2,3,4,1,2,3,4,1,2,3,4,1,2,3,4,1,2,3,4 };
+    const unsigned char* const phase = pattern + (offset & 3); // Blocks are a multiple of 4 long, so the phase never changes
+#endif
+#if defined(__AVX2__)
+    const __m256i n = _mm256_set1_epi8(nucleic_acid_pseudo::N);
+    const __m256i fake = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(phase));
+    for (; last - first >= 32; first += 32, offset += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(first), _mm256_blendv_epi8(v, fake, _mm256_cmpeq_epi8(v, n)));
+    }
+#elif defined(__SSSE3__)
+    const __m128i n = _mm_set1_epi8(nucleic_acid_pseudo::N);
+    const __m128i fake = _mm_loadu_si128(reinterpret_cast<const __m128i*>(phase));
+    for (; last - first >= 16; first += 16, offset += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const __m128i m = _mm_cmpeq_epi8(v, n);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(first), _mm_or_si128(_mm_andnot_si128(m, v), _mm_and_si128(m, fake)));
+    }
+#endif
+    for (; first != last; ++first, ++offset)
+        if (*first == nucleic_acid_pseudo::N) *first = (unsigned char)((offset & 3) + 1);
+}
+
+// Translate pseudo codes (0..7) back to characters through an 8-entry table such as chars[]
+void utils::translate_from_pseudo(const unsigned char* first, const unsigned char* last, char* des, const char* table)
+{
+#if defined(__AVX2__)
+    const __m256i lut = _mm256_broadcastsi128_si256(_mm_setr_epi8(table[0], table[1], table[2], table[3],
+        table[4], table[5], table[6], table[7], 0, 0, 0, 0, 0, 0, 0, 0));
+    const __m256i mask = _mm256_set1_epi8(7);
+    for (; last - first >= 32; first += 32, des += 32)
+    {
+        const __m256i v = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first)), mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(des), _mm256_shuffle_epi8(lut, v));
+    }
+#elif defined(__SSSE3__)
+    const __m128i lut = _mm_setr_epi8(table[0], table[1], table[2], table[3],
+        table[4], table[5], table[6], table[7], 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask = _mm_set1_epi8(7);
+    for (; last - first >= 16; first += 16, des += 16)
+    {
+        const __m128i v = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first)), mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(des), _mm_shuffle_epi8(lut, v));
+    }
+#endif
+    for (; first != last; ++first, ++des)
+        *des = table[*first & 7];
+}
+
+std::vector<std::vector<unsigned char>> utils::read_to_pseudo(std::istream& is, std::string& center_name, int& II, int& center_) 
+{
+    std::vector<std::vector<unsigned char>> sequences;
+
+    std::string each_line;
+    std::string each_sequence;
+    for (bool flag = false; std::getline(is, each_line); )
+    {
+        if (each_line.size() == 0 || (each_line.size() == 1 && (int)each_line[0] == 13)) 
+            continue;
+
+        if (each_line[0] == '>')
+        {
+            each_line.erase(0, 1);
+            if ((int)(*each_line.rbegin()) == 13)
+                each_line.pop_back();
+            each_line.erase(std::remove_if(each_line.begin(), each_line.end(), [](char c) {
+                return (c == ' ' || c == '\t');
+                }), each_line.end());
+            if (center_ == -1 && each_line == center_name)
+                center_ = II;
+            II++;
+            if (flag)
+            {
+                sequences.emplace_back(to_pseudo(each_sequence));
+                each_sequence.clear();
+            }
+            flag = true;
+        }
+        else if (flag)
+        {
+            each_sequence += each_line;
+            if ((int)(*each_line.rbegin()) == 13)
+                each_sequence.pop_back();
+        }
+    }
+
+    sequences.emplace_back(to_pseudo(each_sequence));
+    return sequences;  
+}
+
+// Parse every record of an in-memory fasta image, appending one pseudo sequence per header.
+// When records is given, the location and line layout of each record (relative to base) is recorded too.
+static void _read_records(const char* first, const char* last, const std::string& center_name, int& II, int& center_,
+    utils::PackedSequences& sequences, std::vector<utils::FastaRecord>* records = NULL,
+    uint32_t file = 0, const char* base = NULL)
+{
+    bool in_record = false;
+    std::string name;
+    std::vector<unsigned char> line; // Translated bases of the current line
+    const char* line_begin = NULL; // Previous sequence line of the current record
+    size_t line_width = 0;
+
+    for (const char* next; first < last; first = next)
+    {
+        const char* line_end = static_cast<const char*>(memchr(first, '\n', last - first));
+        if (line_end == NULL) line_end = last;
+        next = line_end + 1;
+        if (line_end != first && *(line_end - 1) == '\r')
+            --line_end;
+        if (line_end == first)
+            continue;
+
+        if (*first == '>')
+        {
+            name.clear();
+            for (const char* p = first + 1; p != line_end; ++p)
+                if (*p != ' ' && *p != '\t')
+                    name.push_back(*p);
+            if (center_ == -1 && name == center_name)
+                center_ = II;
+            II++;
+            sequences.push_back();
+            in_record = true;
+            if (records != NULL)
+            {
+                const uint64_t offset = line_end - base;
+                records->push_back(utils::FastaRecord({ file, (uint32_t)(line_end - first), 0, 0, (uint64_t)(first - base), offset, offset }));
+                line_begin = NULL;
+            }
+        }
+        else if (in_record)
+        {
+            line.resize(line_end - first);
+            line.resize(utils::translate_to_pseudo(first, line_end, line.data())); // Unknown bases stay N and are faked by the store
+            sequences.append(line.data(), line.data() + line.size());
+            if (records != NULL)
+            {
+                // The layout stays regular while every line but the last has line_width bases, no line (the last
+                // included) is longer, and lines start line_stride bytes apart, which covers the '\r' of CRLF input
+                utils::FastaRecord& record = records->back();
+                if (line_begin == NULL)
+                {
+                    record.sequence_begin = first - base;
+                    record.line_width = (uint32_t)(line_end - first);
+                    record.line_stride = (uint32_t)(next - first);
+                }
+                else if (line_width != record.line_width || (size_t)(line_end - first) > record.line_width || line_begin + record.line_stride != first)
+                    record.line_width = 0; // Ragged lines, a long last line, mixed line breaks or blank lines inside the record
+                record.sequence_end = line_end - base;
+                line_begin = first;
+                line_width = line_end - first;
+            }
+        }
+    }
+}
+
+// Read sequences from an in-memory fasta image (e.g. a MappedFile) straight into pseudo buffers
+utils::PackedSequences utils::read_to_pseudo(const char* first, const char* last, std::string& center_name, int& II, int& center_)
+{
+    PackedSequences sequences;
+    _read_records(first, last, center_name, II, center_, sequences);
+    if (sequences.empty())
+        sequences.push_back();
+    return sequences;
+}
+
+// Find the first header line starting at or after pos, or last if there is none
+static const char* _next_record(const char* first, const char* last, const char* pos)
+{
+    if (pos <= first) return first;
+    for (const char* p = pos - 1; p < last; )
+    {
+        const char* line_end = static_cast<const char*>(memchr(p, '\n', last - p));
+        if (line_end == NULL || line_end + 1 == last) break;
+        if (line_end[1] == '>') return line_end + 1;
+        p = line_end + 1;
+    }
+    return last;
+}
+
+// Read several fasta files concurrently; large files are split at record boundaries.
+// Results are stitched in file order, so II, center_ and the sequence order match a serial read.
+utils::PackedSequences utils::read_to_pseudo(const std::vector<std::string>& file_names, std::string& center_name, int& II, int& center_, FastaIndex& index)
+{
+    struct chunk_type
+    {
+        size_t file;
+        const char* first;
+        const char* last;
+        int names; // Number of headers in the chunk
+        int center; // Local index of the first header matching center_name
+        PackedSequences sequences;
+        std::vector<FastaRecord> records;
+    };
+
+    std::vector<MappedFile>& files = index.files;
+    files.reserve(file_names.size());
+    size_t total_size = 0;
+    for (const auto& file_name : file_names)
+    {
+        files.emplace_back(file_name);
+        total_size += files.back().size();
+    }
+
+    const size_t thread_num = threadPool0 == NULL ? 1 : threadPool0->Thread_num;
+    const size_t chunk_size = std::max<size_t>(size_t(1) << 26, total_size / (thread_num * 4) + 1);
+    std::vector<chunk_type> chunks;
+    for (size_t i = 0; i != files.size(); ++i)
+    {
+        const char* first = files[i].begin();
+        const char* last = files[i].end();
+        do
+        {
+            const char* stop = (size_t)(last - first) > chunk_size ? _next_record(first, last, first + chunk_size) : last;
+            chunks.push_back(chunk_type({ i, first, stop, 0, -1, PackedSequences(), std::vector<FastaRecord>() }));
+            first = stop;
+        } while (first != last);
+    }
+
+    auto read_chunk = [&files, &center_name](chunk_type& chunk) {
+        _read_records(chunk.first, chunk.last, center_name, chunk.names, chunk.center, chunk.sequences,
+            &chunk.records, (uint32_t)chunk.file, files[chunk.file].begin());
+    };
+    if (threadPool0 == NULL || chunks.size() == 1)
+        for (auto& chunk : chunks)
+            read_chunk(chunk);
+    else
+    {
+        for (auto& chunk : chunks)
+            threadPool0->execute([&chunk, &read_chunk]() { read_chunk(chunk); });
+        threadPool0->waitFinished();
+    }
+
+    PackedSequences sequences;
+    size_t sequence_number = 0;
+    for (const auto& chunk : chunks)
+        sequence_number += chunk.sequences.size();
+    index.records.reserve(sequence_number + files.size());
+    for (size_t i = 0; i != chunks.size(); ++i)
+    {
+        if (center_ == -1 && chunks[i].center != -1)
+            center_ = II + chunks[i].center;
+        II += chunks[i].names;
+        sequences.append(chunks[i].sequences);
+        chunks[i].sequences.clear();
+        index.records.insert(index.records.end(), chunks[i].records.begin(), chunks[i].records.end());
+        std::vector<FastaRecord>().swap(chunks[i].records);
+
+        // A file without any header still contributes one (empty) sequence, as read_to_pseudo does
+        if (i + 1 == chunks.size() || chunks[i + 1].file != chunks[i].file)
+        {
+            bool has_names = false;
+            for (size_t j = i + 1; j-- != 0 && chunks[j].file == chunks[i].file; )
+                has_names |= chunks[j].names != 0;
+            if (!has_names)
+            {
+                sequences.push_back();
+                index.records.push_back(FastaRecord({ (uint32_t)chunks[i].file, 0, 0, 0, 0, 0, 0 }));
+            }
+        }
+    }
+    return sequences;
+}
+
+void insert_others(utils::Insertion2 That, utils::Insertion2 This, std::vector<std::vector<utils::Insertion2>>& more_insertions,
+    int k, int sequence_number, int* ii)
+{
+    for (int m = 0; m < sequence_number; m++)
+    {
+        if (m == k)
+        {
+            while ((ii[m] < more_insertions[m].size()) && (more_insertions[m][ii[m]].index < That.index)) ii[m]++;
+            if (ii[m] == more_insertions[m].size())
+                more_insertions[m].emplace_back(That);
+            else if (more_insertions[m][ii[m]].index == That.index)
+            {
+                more_insertions[m][ii[m]].n_num += That.n_num;
+                more_insertions[m][ii[m]].gap_num += That.gap_num;
+            }
+            else
+                more_insertions[m].insert(more_insertions[m].begin() + (ii[m]++), That);
+        }
+        else
+        {
+            while ((ii[m] < more_insertions[m].size()) && (more_insertions[m][ii[m]].index < This.index)) ii[m]++;
+            if (ii[m] == more_insertions[m].size())
+                more_insertions[m].emplace_back(This);
+            else if (more_insertions[m][ii[m]].index == This.index)
+            {
+                more_insertions[m][ii[m]].n_num += This.n_num;
+                more_insertions[m][ii[m]].gap_num += This.gap_num;
+            }
+            else
+                more_insertions[m].insert(more_insertions[m].begin() + (ii[m]++), This);
+        }
+    }
+}
+
+void utils::insert_and_write_file(std::ostream& os, std::vector<std::vector<unsigned char>>& sequences,
+    std::vector<std::vector<Insertion>>& insertions, const std::vector<std::vector<Insertion>>& N_insertions,
+    std::vector<std::string>& name, std::vector<bool>& sign)
+{
+    std::string each_sequence, each_line;
+    const size_t sequence_number = insertions.size();
+    std::vector<std::vector<Insertion2>> all_insertions;
+    std::vector<Insertion2> i_all_insertions;
+    int* len_sequences = new int[sequence_number];
+    int* ii = new int[sequence_number]();
+    int i = 0, j = 0, pre = 0, diff, mi, k;
+    std::vector<std::vector<Insertion2>> more_insertions(sequence_number);
+    
+    size_t g_num;
+
+    for (int k = 0; k < sequence_number; k++)  len_sequences[k] = sequences[k].size();
+    //变insertions
+    for (int k = 0; k < sequence_number; k++)
+    {
+        i = 0; j = 0; g_num = 0;
+        for (int kk = 0; kk < sequence_number; kk++) ii[kk] = 0;
+        std::vector<Insertion2>().swap(i_all_insertions);
+        while (i < insertions[k].size() && j < N_insertions[k].size())
+        {
+            if (insertions[k][i].index == N_insertions[k][j].index)
+            {
+                g_num += insertions[k][i].number;
+                if (N_insertions[k][j].number > insertions[k][i].number)
+                {
+                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,insertions[k][i].number, 0 })); 
+                    insert_others(Insertion2({ insertions[k][i].index + g_num ,N_insertions[k][j].number - insertions[k][i].number, 0 }), utils::Insertion2({ insertions[k][i].index + g_num ,0, N_insertions[k][j].number - insertions[k][i].number }), more_insertions, k, sequence_number, ii);
+                }
+                else
+                {
+                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,N_insertions[k][j].number ,insertions[k][i].number - N_insertions[k][j].number }));
+                }
+                i++;
+                j++;
+            }
+            else if (insertions[k][i].index > N_insertions[k][j].index)
+            {
+                insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
+                j++;
+            }
+            else
+            {
+                g_num += insertions[k][i].number;
+                i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
+                i++;
+            }
+        }
+        while (j < N_insertions[k].size())
+        {
+            insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
+            j++;
+        }
+        while (i < insertions[k].size()) 
+        {
+            g_num += insertions[k][i].number;
+            i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
+            i++;
+        }
+        all_insertions.emplace_back(i_all_insertions);
+        /*for (int m = 0; m < sequence_number; m++)
+        {
+            for (int d = 0; d < insertions[m].size(); d++)
+            {
+                std::cout << insertions[m][d].index << " " << insertions[m][d].number << "\n";
+            }
+            std::cout << "\n";
+        }
+            std::cout << k<<" \n";*/
+    }
+
+    /*for (int k = 0; k < sequence_number; k++)
+    {
+        for (int d = 0; d < insertions[k].size(); d++)
+        {
+            std::cout << insertions[k][d].index << " " << insertions[k][d].number << "\n";
+        }
+        std::cout << k << "\n";
+    }
+    for (int k = 0; k < sequence_number; k++)
+    {
+        for (int d = 0; d < N_insertions[k].size(); d++)
+        {
+            std::cout << N_insertions[k][d].index << " " << N_insertions[k][d].number << "\n";
+        }
+        std::cout << k << "\n";
+    }
+    for (int k = 0; k < sequence_number; k++)
+    {
+        for (int d = 0; d < all_insertions[k].size(); d++)
+        {
+            std::cout << all_insertions[k][d].index << " " << all_insertions[k][d].n_num<<" "<< all_insertions[k][d].gap_num << "\n";
+        }
+        std::cout << k << "\n";
+    }
+    for (int k = 0; k < sequence_number; k++)
+    {
+        for (int d = 0; d < more_insertions[k].size(); d++)
+        {
+            std::cout << more_insertions[k][d].index << " " << more_insertions[k][d].n_num << " " << more_insertions[k][d].gap_num << "\n";
+        }
+        std::cout << k<<"\n";
+    }*/
+
+    int min_size, min_i;
+    std::vector<Insertion> multi;
+    std::vector<Insertion> tmp;
+    for (int k = 0; k < sequence_number; k++)
+        if (k == 0 || more_insertions[k].size() < min_size)
+        {
+            min_size = more_insertions[k].size();
+            min_i = k;
+        }
+    i = 0; j = 0;
+    if (min_i == 0) diff = 1;
+    else diff = 0;
+    while (i < more_insertions[diff].size() && j < more_insertions[min_i].size())
+    {
+        if (more_insertions[diff][i].index == more_insertions[min_i][j].index)
+        {
+            if (more_insertions[diff][i].gap_num == 0 || more_insertions[min_i][j].gap_num == 0);
+            else if (more_insertions[diff][i].gap_num > more_insertions[min_i][j].gap_num)
+                multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[min_i][j].gap_num }));
+            else multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[diff][i].gap_num }));
+            i++; j++;
+        }
+        else if (more_insertions[diff][i].index > more_insertions[min_i][j].index) j++;
+        else i++;
+    }
+
+    if (min_i == 0)
+        for (int k = 2; k < sequence_number; k++)
+        {
+            i = 0; j = 0;
+            std::vector<Insertion>().swap(tmp);
+            while (i < more_insertions[k].size() && j < multi.size())
+            {
+                if (more_insertions[k][i].index == multi[j].index)
+                {
+                    if (more_insertions[k][i].gap_num == 0);
+                    else if (more_insertions[k][i].gap_num > multi[j].number)
+                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
+                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
+                    i++; j++;
+                }
+                else if (more_insertions[k][i].index > multi[j].index) j++;
+                else i++;
+            }
+            multi = tmp;
+        }
+    else
+        for (int k = 1; k < sequence_number; k++)
+        {
+            if (k == min_i) continue;
+            i = 0; j = 0;
+            std::vector<Insertion>().swap(tmp);
+            while (i < more_insertions[k].size() && j < multi.size())
+            {
+                if (more_insertions[k][i].index == multi[j].index)
+                {
+                    if (more_insertions[k][i].gap_num == 0);
+                    else if (more_insertions[k][i].gap_num > multi[j].number)
+                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
+                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
+                    i++; j++;
+                }
+                else if (more_insertions[k][i].index > multi[j].index) j++;
+                else i++;
+            }
+            multi = tmp;
+        }
+
+    for (i = 0; i < sequence_number; i++)
+    {
+        if (sign[i]) os << "> " << name[i] << " + " << "\n";
+        else os << "> " << name[i] << " - " << "\n";
+        std::ofstream tmpo(arguments::tmp_file_name, std::ios::binary | std::ios::out);
+        k = 0;
+        for (j = 0; j < all_insertions[i].size(); j++)
+        {
+            while (k < all_insertions[i][j].index)
+                tmpo << chars[sequences[i][k++]];
+            for (int p = 0; p < all_insertions[i][j].n_num; p++)
+                tmpo << 'N';
+            for (int p = 0; p < all_insertions[i][j].gap_num; p++)
+                tmpo << '-';
+        }while (k < sequences[i].size())tmpo << chars[sequences[i][k++]];
+        tmpo.close();
+        //read
+        std::ifstream tmpi(arguments::tmp_file_name, std::ios::binary | std::ios::in);
+        while (std::getline(tmpi, each_line))
+        {
+            if (each_line.size() == 0 || (each_line.size() == 1 && (int)each_line[0] == 13)) 
+                continue;
+            each_sequence += each_line;
+            if ((int)(*each_line.rbegin()) == 13)
+                each_sequence.pop_back();
+        }
+        tmpi.close();
+        sequences[i].assign(each_sequence.begin(), each_sequence.end());
+        each_sequence.clear();
+        each_line.clear();
+        //second insert
+        mi = 0;
+        k = 0;
+        for (j = 0; j < more_insertions[i].size(); j++)
+        {
+            while (k < more_insertions[i][j].index)
+                os << sequences[i][k++];
+            for (int p = 0; p < more_insertions[i][j].n_num; p++)
+                os << 'N';
+            if (mi < multi.size() && more_insertions[i][j].index == multi[mi].index)
+            {
+                for (int p = 0; p < (more_insertions[i][j].gap_num - multi[mi].number); p++)
+                    os << '-';
+                mi++;
+            }
+            else
+                for (int p = 0; p < more_insertions[i][j].gap_num; p++)
+                    os << '-';
+        }while (k < sequences[i].size()) os << sequences[i][k++];
+        std::vector<unsigned char>().swap(sequences[i]);
+        os << "\n";
+    }os << "\n";
+    remove(arguments::tmp_file_name.data());
+    /*std::vector<std::vector<Insertion2>>().swap(all_insertions);
+    std::vector<Insertion2>().swap(i_all_insertions);
+    std::vector<std::vector<Insertion2>>().swap(more_insertions);
+    std::vector<Insertion>().swap(multi);
+    std::vector<Insertion>().swap(tmp);
+    delete[] ii;*/
+}
+
+int* utils::vector_insertion_gap_N(std::vector<std::vector<unsigned char>>& sequences, 
+    std::vector<std::vector<Insertion>>& insertions, const std::vector<std::vector<Insertion>>& N_insertions) 
+{
+    const size_t sequence_number = insertions.size();
+    std::vector<std::vector<Insertion2>> all_insertions;
+    std::vector<Insertion2> i_all_insertions;
+    int* len_sequences = new int[sequence_number];
+    int* ii = new int[sequence_number]();
+    std::vector<unsigned char> tmp_vector;
+    int i = 0, j = 0, pre = 0, diff, mi;
+    std::vector<std::vector<Insertion2>> more_insertions(sequence_number);
+
+    size_t g_num;
+    for (int k = 0; k < sequence_number; k++)  len_sequences[k] = sequences[k].size();
+    for (i = 0; i < sequence_number; i++)
+        for (j = 0; j < N_insertions[i].size(); j++)
+            len_sequences[i] += N_insertions[i][j].number;
+    //变insertions
+    for (int k = 0; k < sequence_number; k++)
+    {
+        i = 0; j = 0; g_num = 0;
+        for (int kk = 0; kk < sequence_number; kk++) ii[kk] = 0;
+        std::vector<Insertion2>().swap(i_all_insertions);
+        while (i < insertions[k].size() && j < N_insertions[k].size())
+        {
+            if (insertions[k][i].index == N_insertions[k][j].index)
+            {
+                g_num += insertions[k][i].number;
+                if (N_insertions[k][j].number > insertions[k][i].number)
+                {
+                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,insertions[k][i].number, 0 })); 
+                    insert_others(Insertion2({ insertions[k][i].index + g_num ,N_insertions[k][j].number - insertions[k][i].number, 0 }), utils::Insertion2({ insertions[k][i].index + g_num ,0, N_insertions[k][j].number - insertions[k][i].number }), more_insertions, k, sequence_number, ii);
+                }
+                else
+                {
+                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,N_insertions[k][j].number ,insertions[k][i].number - N_insertions[k][j].number }));
+                }
+                i++;
+                j++;
+            }
+            else if (insertions[k][i].index > N_insertions[k][j].index) 
+            {
+                insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
+                j++;
+            }
+            else
+            {
+                g_num += insertions[k][i].number;
+                i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
+                i++;
+            }
+        }
+        while (j < N_insertions[k].size()) 
+        {
+            insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
+            j++;
+        }
+        while (i < insertions[k].size()) 
+        {
+            g_num += insertions[k][i].number;
+            i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
+            i++;
+        }
+        all_insertions.emplace_back(i_all_insertions);
+        /*for (int m = 0; m < sequence_number; m++)
+        {
+            for (int d = 0; d < insertions[m].size(); d++)
+            {
+                std::cout << insertions[m][d].index << " " << insertions[m][d].number << "\n";
+            }
+            std::cout << "\n";
+        }
+            std::cout << k<<" \n";*/
+    }
+
+    /*for (int k = 0; k < sequence_number; k++)
+    {
+        for (int d = 0; d < insertions[k].size(); d++)
+        {
+            std::cout << insertions[k][d].index << " " << insertions[k][d].number << "\n";
+        }
+        std::cout << k << "\n";
+    }
+    for (int k = 0; k < sequence_number; k++)
+    {
+        for (int d = 0; d < N_insertions[k].size(); d++)
+        {
+            std::cout << N_insertions[k][d].index << " " << N_insertions[k][d].number << "\n";
+        }
+        std::cout << k << "\n";
+    }
+    for (int k = 0; k < sequence_number; k++)
+    {
+        for (int d = 0; d < all_insertions[k].size(); d++)
+        {
+            std::cout << all_insertions[k][d].index << " " << all_insertions[k][d].n_num<<" "<< all_insertions[k][d].gap_num << "\n";
+        }
+        std::cout << k << "\n";
+    }
+    for (int k = 0; k < sequence_number; k++)
+    {
+        for (int d = 0; d < more_insertions[k].size(); d++)
+        {
+            std::cout << more_insertions[k][d].index << " " << more_insertions[k][d].n_num << " " << more_insertions[k][d].gap_num << "\n";
+        }
+        std::cout << k<<"\n";
+    }*/
+
+    int min_size, min_i;
+    std::vector<Insertion> multi;
+    std::vector<Insertion> tmp;
+    for (int k = 0; k < sequence_number; k++)
+        if (k == 0 || more_insertions[k].size() < min_size)
+        {
+            min_size = more_insertions[k].size();
+            min_i = k;
+        }
+    i = 0; j = 0;
+    if (min_i == 0) diff = 1;
+    else diff = 0;
+    while (i < more_insertions[diff].size() && j < more_insertions[min_i].size())
+    {
+        if (more_insertions[diff][i].index == more_insertions[min_i][j].index)
+        {
+            if (more_insertions[diff][i].gap_num == 0 || more_insertions[min_i][j].gap_num == 0);
+            else if (more_insertions[diff][i].gap_num > more_insertions[min_i][j].gap_num)
+                multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[min_i][j].gap_num }));
+            else multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[diff][i].gap_num }));
+            i++; j++;
+        }
+        else if (more_insertions[diff][i].index > more_insertions[min_i][j].index) j++;
+        else i++;
+    }
+
+    if (min_i == 0)
+        for (int k = 2; k < sequence_number; k++)
+        {
+            i = 0; j = 0;
+            std::vector<Insertion>().swap(tmp);
+            while (i < more_insertions[k].size() && j < multi.size())
+            {
+                if (more_insertions[k][i].index == multi[j].index)
+                {
+                    if (more_insertions[k][i].gap_num == 0);
+                    else if (more_insertions[k][i].gap_num > multi[j].number)
+                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
+                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
+                    i++; j++;
+                }
+                else if (more_insertions[k][i].index > multi[j].index) j++;
+                else i++;
+            }
+            multi = tmp;
+        }
+    else
+        for (int k = 1; k < sequence_number; k++)
+        {
+            if (k == min_i) continue;
+            i = 0; j = 0;
+            std::vector<Insertion>().swap(tmp);
+            while (i < more_insertions[k].size() && j < multi.size())
+            {
+                if (more_insertions[k][i].index == multi[j].index)
+                {
+                    if (more_insertions[k][i].gap_num == 0);
+                    else if (more_insertions[k][i].gap_num > multi[j].number)
+                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
+                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
+                    i++; j++;
+                }
+                else if (more_insertions[k][i].index > multi[j].index) j++;
+                else i++;
+            }
+            multi = tmp;
+        }
+
+    int more = 0, all_size = 0, ti = 0, k = 0;
+    for (i = 0; i < sequence_number; i++)
+    {
+        if (i == 0)
+        {
+            more = sequences[i].size();
+            for (j = 0; j < all_insertions[i].size(); j++)
+                more += (all_insertions[i][j].n_num + all_insertions[i][j].gap_num);
+            all_size = more;
+            mi = 0;
+            for (j = 0; j < more_insertions[i].size(); j++)
+            {
+                all_size += more_insertions[i][j].n_num;
+                if (mi < multi.size() && more_insertions[i][j].index == multi[mi].index)
+                    all_size -= multi[mi++].number;
+                all_size += more_insertions[i][j].gap_num;
+            }
+            tmp_vector.resize(more);
+        }
+
+        ti = 0;
+        k = 0;
+        for (j = 0; j < all_insertions[i].size(); j++)
+        {
+            while (k < all_insertions[i][j].index)
+                tmp_vector[ti++] = sequences[i][k++];
+            for (int p = 0; p < all_insertions[i][j].n_num; p++)
+                tmp_vector[ti++] = '\5';
+            for (int p = 0; p < all_insertions[i][j].gap_num; p++)
+                tmp_vector[ti++] = '\7';
+        }while (k < sequences[i].size())tmp_vector[ti++] = sequences[i][k++];
+
+        sequences[i].resize(all_size);
+        mi = 0;
+        k = 0;
+        ti = 0;
+        for (j = 0; j < more_insertions[i].size(); j++)
+        {
+            while (ti < more_insertions[i][j].index)
+                sequences[i][k++] = tmp_vector[ti++];
+            for (int p = 0; p < more_insertions[i][j].n_num; p++)
+                sequences[i][k++] = '\5';
+            if (mi < multi.size() && more_insertions[i][j].index == multi[mi].index)
+            {
+                for (int p = 0; p < (more_insertions[i][j].gap_num - multi[mi].number); p++)
+                    sequences[i][k++] = '\7';
+                mi++;
+            }
+            else
+                for (int p = 0; p < more_insertions[i][j].gap_num; p++)
+                    sequences[i][k++] = '\7';
+        }while (ti < more) sequences[i][k++] = tmp_vector[ti++];
+
+    }
+
+
+    std::vector<unsigned char>().swap(tmp_vector);
+    std::vector<std::vector<Insertion2>>().swap(all_insertions);
+    std::vector<Insertion2>().swap(i_all_insertions);
+    std::vector<std::vector<Insertion2>>().swap(more_insertions);
+    std::vector<Insertion>().swap(multi);
+    std::vector<Insertion>().swap(tmp);
+    delete[] ii;
+    return len_sequences;
+}
+
+void utils::insert_and_write_fasta(std::ostream& os, std::vector<std::vector<unsigned char>>& sequences,
+    std::vector<std::vector<Insertion>>& insertions, std::vector<std::vector<Insertion>>& N_insertions,
+    std::vector<std::string>& name,bool TU)
+{
+    if (!TU) chars[4] = 'U';
+    //std::cout << "0memory usage: " << getPeakRSS() << " B" << std::endl;
+    const size_t sequence_number = insertions.size();
+    //std::cout << "insertions " << sequence_number << " " << insertions[0].size() << " " << insertions[1].size() << "\n";
+    int score = 0, length = 0, name_len = 0;
+
+    for (int i = 0; i < name.size(); i++)
+        if (name_len < name[i].size())
+            name_len = name[i].size();
+    const auto align_start1 = std::chrono::high_resolution_clock::now(); 
+
+    std::vector<std::vector<Insertion2>> all_insertions;
+    std::vector<Insertion2> i_all_insertions;
+    int* len_sequences = new int[sequence_number];
+    int* ii = new int[sequence_number]();
+    int* score_two = NULL;
+    std::vector<unsigned char> tmp_vector;
+    int i = 0, j = 0, pre = 0, diff, mi;
+    std::vector<std::vector<Insertion2>> more_insertions(sequence_number);
+
+    size_t g_num;
+    for (int k = 0; k < sequence_number; k++)  len_sequences[k] = sequences[k].size();
+    for (i = 0; i < sequence_number; i++)
+        for (j = 0; j < N_insertions[i].size(); j++)
+            len_sequences[i] += N_insertions[i][j].number;
+
+    for (int k = 0; k < sequence_number; k++)
+    {
+        i = 0; j = 0; g_num = 0;
+        for (int kk = 0; kk < sequence_number; kk++) ii[kk] = 0;
+        std::vector<Insertion2>().swap(i_all_insertions);
+        while (i < insertions[k].size() && j < N_insertions[k].size())
+        {
+            if (insertions[k][i].index == N_insertions[k][j].index)
+            {
+                g_num += insertions[k][i].number;
+                if (N_insertions[k][j].number > insertions[k][i].number)
+                {
+                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,insertions[k][i].number, 0 })); 
+                    insert_others(Insertion2({ insertions[k][i].index + g_num ,N_insertions[k][j].number - insertions[k][i].number, 0 }), utils::Insertion2({ insertions[k][i].index + g_num ,0, N_insertions[k][j].number - insertions[k][i].number }), more_insertions, k, sequence_number, ii);
+                }
+                else
+                {
+                    i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index ,N_insertions[k][j].number ,insertions[k][i].number - N_insertions[k][j].number }));
+                }
+                i++;
+                j++;
+            }
+            else if (insertions[k][i].index > N_insertions[k][j].index)
+            {
+                insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
+                j++;
+            }
+            else
+            {
+                g_num += insertions[k][i].number;
+                i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
+                i++;
+            }
+        }
+        while (j < N_insertions[k].size())
+        {
+            insert_others(Insertion2({ N_insertions[k][j].index + g_num ,N_insertions[k][j].number, 0 }), utils::Insertion2({ N_insertions[k][j].index + g_num ,0, N_insertions[k][j].number }), more_insertions, k, sequence_number, ii);
+            j++;
+        }
+        while (i < insertions[k].size()) 
+        {
+            g_num += insertions[k][i].number;
+            i_all_insertions.emplace_back(Insertion2({ insertions[k][i].index, 0,insertions[k][i].number }));
+            i++;
+        }
+        all_insertions.emplace_back(i_all_insertions);
+    }
+
+    for (i = 0; i < N_insertions[i].size(); i++)
+    {
+        std::vector<Insertion>().swap(N_insertions[i]);
+        std::vector<Insertion>().swap(insertions[i]);
+    }
+    std::vector<std::vector<Insertion>>().swap(N_insertions);
+    std::vector<std::vector<Insertion>>().swap(insertions);
+
+    int min_size, min_i;
+    std::vector<Insertion> multi;
+    std::vector<Insertion> tmp;
+    for (int k = 0; k < sequence_number; k++)
+        if (k == 0 || more_insertions[k].size() < min_size)
+        {
+            min_size = more_insertions[k].size();
+            min_i = k;
+        }
+    i = 0; j = 0;
+    if (min_i == 0) diff = 1;
+    else diff = 0;
+    while (i < more_insertions[diff].size() && j < more_insertions[min_i].size())
+    {
+        if (more_insertions[diff][i].index == more_insertions[min_i][j].index)
+        {
+            if (more_insertions[diff][i].gap_num == 0 || more_insertions[min_i][j].gap_num == 0);
+            else if (more_insertions[diff][i].gap_num > more_insertions[min_i][j].gap_num)
+                multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[min_i][j].gap_num }));
+            else multi.emplace_back(Insertion({ more_insertions[diff][i].index ,more_insertions[diff][i].gap_num }));
+            i++; j++;
+        }
+        else if (more_insertions[diff][i].index > more_insertions[min_i][j].index) j++;
+        else i++;
+    }
+
+    if (min_i == 0)
+        for (int k = 2; k < sequence_number; k++)
+        {
+            i = 0; j = 0;
+            std::vector<Insertion>().swap(tmp);
+            while (i < more_insertions[k].size() && j < multi.size())
+            {
+                if (more_insertions[k][i].index == multi[j].index)
+                {
+                    if (more_insertions[k][i].gap_num == 0);
+                    else if (more_insertions[k][i].gap_num > multi[j].number)
+                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
+                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
+                    i++; j++;
+                }
+                else if (more_insertions[k][i].index > multi[j].index) j++;
+                else i++;
+            }
+            multi = tmp;
+        }
+    else
+        for (int k = 1; k < sequence_number; k++)
+        {
+            if (k == min_i) continue;
+            i = 0; j = 0;
+            std::vector<Insertion>().swap(tmp);
+            while (i < more_insertions[k].size() && j < multi.size())
+            {
+                if (more_insertions[k][i].index == multi[j].index)
+                {
+                    if (more_insertions[k][i].gap_num == 0);
+                    else if (more_insertions[k][i].gap_num > multi[j].number)
+                        tmp.emplace_back(Insertion({ more_insertions[k][i].index ,multi[j].number }));
+                    else tmp.emplace_back(Insertion({ more_insertions[k][i].index ,more_insertions[k][i].gap_num }));
+                    i++; j++;
+                }
+                else if (more_insertions[k][i].index > multi[j].index) j++;
+                else i++;
+            }
+            multi = tmp;
+        }
+
+    int more = 0, all_size = 0, ti = 0, k = 0;
+    for (i = 0; i < sequence_number; i++)
+    {
+        if (i == 0)
+        {
+            more = sequences[i].size();
+            for (j = 0; j < all_insertions[i].size(); j++)
+                more += (all_insertions[i][j].n_num + all_insertions[i][j].gap_num);
+            all_size = more;
+            mi = 0;
+            for (j = 0; j < more_insertions[i].size(); j++)
+            {
+                all_size += more_insertions[i][j].n_num;
+                if (mi < multi.size() && more_insertions[i][j].index == multi[mi].index)
+                    all_size -= multi[mi++].number;
+                all_size += more_insertions[i][j].gap_num;
+            }
+            tmp_vector.resize(more);
+        }
+
+        ti = 0;
+        k = 0;
+        for (j = 0; j < all_insertions[i].size(); j++)
+        {
+            while (k < all_insertions[i][j].index)
+                tmp_vector[ti++] = sequences[i][k++];
+            for (int p = 0; p < all_insertions[i][j].n_num; p++)
+                tmp_vector[ti++] = '\5';
+            for (int p = 0; p < all_insertions[i][j].gap_num; p++)
+                tmp_vector[ti++] = '\7';
+        }
+        while (k < sequences[i].size())tmp_vector[ti++] = sequences[i][k++];
+
+        sequences[i].resize(all_size);
+        mi = 0;
+        k = 0;
+        ti = 0;
+        for (j = 0; j < more_insertions[i].size(); j++)
+        {
+            while (ti < more_insertions[i][j].index)
+                sequences[i][k++] = tmp_vector[ti++];
+            for (int p = 0; p < more_insertions[i][j].n_num; p++)
+                sequences[i][k++] = '\5';
+            if (mi < multi.size() && more_insertions[i][j].index == multi[mi].index)
+            {
+                for (int p = 0; p < (more_insertions[i][j].gap_num - multi[mi].number); p++)
+                    sequences[i][k++] = '\7';
+                mi++;
+            }
+            else
+                for (int p = 0; p < more_insertions[i][j].gap_num; p++)
+                    sequences[i][k++] = '\7';
+        }while (ti < more) sequences[i][k++] = tmp_vector[ti++];
+        os << "> " << name[i]<< "\n";
+        std::string aligned(sequences[i].size(), '\0');
+        translate_from_pseudo(sequences[i].data(), sequences[i].data() + sequences[i].size(), &aligned[0], chars);
+        os << aligned << "\n";
+        std::vector<unsigned char>().swap(sequences[i]);
+    }
+    std::vector<unsigned char>().swap(sequences[0]);
+    std::vector<unsigned char>().swap(tmp_vector);
+    std::vector<std::vector<Insertion2>>().swap(all_insertions);
+    std::vector<Insertion2>().swap(i_all_insertions);
+    std::vector<std::vector<Insertion2>>().swap(more_insertions);
+    std::vector<Insertion>().swap(multi);
+    std::vector<Insertion>().swap(tmp);
+    delete[] ii;
+}
+
+void utils::insert_and_write(std::ostream& os, std::istream& is, const std::vector<std::vector<Insertion>>& insertions)
+{
+    const size_t sequence_number = insertions.size();
+
+    std::string each_line;
+    std::string each_sequence;
+    std::string each_sequence_aligned;
+    for (unsigned count = 0, length, flag = false; std::getline(is, each_line); )
+    {
+        if (each_line.size() == 0 || (each_line.size() == 1 && (int)each_line[0] == 13)) //跳过空行
+            continue;
+
+        if (each_line[0] == '>')
+        {
+            if (flag)
+            {
+                if (count == 0)
+                {
+                    length = each_sequence.size();
+                    for (auto insertion : insertions[0])
+                        length += insertion.number;
+
+                    each_sequence_aligned.reserve(length);
+                    each_sequence.reserve(length);
+                }
+
+                utils::Insertion::insert_gaps(each_sequence.cbegin(), each_sequence.cend(),
+                    insertions[count].cbegin(), insertions[count].cend(), std::back_inserter(each_sequence_aligned), '-');
+
+                if (arguments::output_matrix)
+                    os << each_sequence_aligned;
+                else
+                    Fasta::cut_and_write(os, each_sequence_aligned);
+                os << '\n';
+
+                each_sequence.clear();
+                each_sequence_aligned.clear();
+                ++count;
+            }
+
+            if (arguments::output_matrix == false)
+                os << each_line << '\n';
+            flag = true;
+        }
+        else if (flag)
+        {
+            each_sequence += each_line;
+#if defined(__unix__) || defined(__unix) || defined(unix)
+            if ((int)(*each_line.rbegin()) == 13)
+                each_sequence.pop_back();
+#endif
+        }
+    }
+
+    utils::Insertion::insert_gaps(each_sequence.cbegin(), each_sequence.cend(),
+        insertions.back().cbegin(), insertions.back().cend(), std::back_inserter(each_sequence_aligned), '-');
+
+    if (arguments::output_matrix)
+        os << each_sequence_aligned;
+    else
+        Fasta::cut_and_write(os, each_sequence_aligned);
+}
+
+void utils::write_to_fasta(std::ostream& os, std::istream& is, std::vector<std::vector<Insertion>>& insertions, size_t& II)
+{
+    std::string each_line;
+    std::string each_sequence;
+    std::string pint_str;
+    std::string name;
+    for (bool flag = false; std::getline(is, each_line); )
+    {
+        if (each_line.size() == 0 || (each_line.size() == 1 && (int)each_line[0] == 13)) //跳过空行
+            continue;
+        if (each_line[0] == '>')
+        {
+            if (flag)
+            {
+                utils::write_to_str(pint_str, each_sequence, insertions[II++]);
+                os << name << "\n"<< pint_str<<"\n";
+                //insertions.erase(insertions.begin());
+                //for (int k = 0; k < pint_str.size(); k++) os << pint_str[k];
+                each_sequence.clear();
+            }
+            name = each_line;
+            flag = true;
+        }
+        else if (flag)
+        {
+            each_sequence += each_line;
+            if ((int)(*each_line.rbegin()) == 13)
+                each_sequence.pop_back();
+        }
+    }
+    utils::write_to_str(pint_str, each_sequence, insertions[II++]);
+    os << name << "\n" << pint_str << "\n";
+    //insertions.erase(insertions.begin());
+    return;
+}
+
+// Helper function to get the length of a row once its gaps are inserted
+static size_t _row_length(const std::string& sequence, const std::vector<utils::Insertion>& gaps)
+{
+    size_t length = sequence.size();
+    for (const auto& insertion : gaps)
+        length += insertion.number;
+    return length;
+}
+
+// Helper function to check that a row's gaps are in order, within the sequence, and make a row of the given length
+static bool _row_fits(const std::string& sequence, const std::vector<utils::Insertion>& gaps, size_t length)
+{
+    for (size_t k = 0, g = 0; g != gaps.size(); k = gaps[g++].index)
+        if (gaps[g].index < k || gaps[g].index > sequence.size())
+            return false;
+    return _row_length(sequence, gaps) == length;
+}
+
+// Helper function to describe a row that does not fit the alignment
+static std::runtime_error _row_length_error(const utils::FastaIndex& input, size_t row, size_t length, size_t expected)
+{
+    const utils::FastaRecord& record = input.records[row];
+    return std::runtime_error("row " + std::to_string(row) + " ("
+        + std::string(input.files[record.file].begin() + record.header_begin, record.header_length)
+        + ") does not fit the alignment: " + std::to_string(length) + " columns, expected " + std::to_string(expected));
+}
+
+// Write the aligned records using the index built while reading, without parsing the input again;
+// spilled gap lists are streamed back from the spill file in row order. Throws std::runtime_error if the rows
+// do not all have the same length.
+void utils::write_to_fasta(std::ostream& os, const FastaIndex& input, GapStore& insertions,
+    const std::vector<size_t>& representatives)
+{
+    std::string each_sequence;
+    std::string pint_str;
+    std::vector<Insertion> gaps; // Row read back from the spill file
+    for (size_t i = 0; i != input.records.size(); ++i)
+    {
+        const FastaRecord& record = input.records[i];
+        input.get_sequence(i, each_sequence);
+        const std::vector<Insertion>& row_gaps = insertions.get(representatives[i], gaps); // Duplicates share their representative's gaps
+        const size_t length = _row_length(each_sequence, row_gaps);
+        if (!_row_fits(each_sequence, row_gaps, arguments::ALL_LEN != 0 ? arguments::ALL_LEN : length))
+            throw _row_length_error(input, i, length, arguments::ALL_LEN != 0 ? arguments::ALL_LEN : length);
+        utils::write_to_str(pint_str, each_sequence, row_gaps);
+        os.write(input.files[record.file].begin() + record.header_begin, record.header_length);
+        os << "\n" << pint_str << "\n";
+    }
+}
+
+// Write the aligned records with all threads: every row has the same length, so the offset of each record in the
+// output is known up front. Threads expand disjoint runs of records and pwrite them into the preallocated file.
+// Returns false if the file cannot be written this way, the caller then uses the stream writer. A row whose length
+// differs from the first row's is not an I/O problem: the file is removed and std::runtime_error is thrown, as
+// it is when the spill file cannot be read back.
+bool utils::write_to_fasta_parallel(const std::string& file_name, const FastaIndex& input, GapStore& insertions,
+    const std::vector<size_t>& representatives)
+{
+#if defined(FASTA_WRITER_USE_PWRITE)
+    const size_t record_count = input.records.size();
+    if (record_count == 0) return false;
+
+    // Row length: the bases plus the gaps of any row
+    std::string each_sequence;
+    std::vector<Insertion> buffer;
+    input.get_sequence(0, each_sequence);
+    const size_t row_length = _row_length(each_sequence, insertions.get(representatives[0], buffer));
+    arguments::ALL_LEN = row_length;
+
+    // Record i takes its header, a line break, the row and a line break from offsets[i] on
+    std::vector<uint64_t> offsets(record_count + 1, 0);
+    for (size_t i = 0; i != record_count; ++i)
+        offsets[i + 1] = offsets[i] + input.records[i].header_length + row_length + 2;
+
+    const int fd = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) return false;
+    if (ftruncate(fd, (off_t)offsets[record_count]) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    // Runs of about chunk_bytes of output, each written with one pwrite
+    const uint64_t chunk_bytes = (uint64_t)8 << 20;
+    std::vector<size_t> chunks(1, 0);
+    for (size_t i = 1; i <= record_count; ++i)
+        if (i == record_count || offsets[i] - offsets[chunks.back()] >= chunk_bytes)
+            chunks.push_back(i);
+
+    std::atomic<bool> failed(false); // A write failed
+    std::atomic<size_t> bad_row(record_count); // First row found with another length, or record_count
+    std::atomic<bool> read_failed(false); // Reading a spill file row failed
+    std::exception_ptr read_error; // First such error, raised again once the workers are done
+    std::mutex read_error_mutex;
+    auto write_chunk = [&](size_t c) {
+        const size_t first = chunks[c], last = chunks[c + 1];
+        if (failed || bad_row != record_count || read_failed) return;
+        std::string out(offsets[last] - offsets[first], '\0');
+        std::string sequence;
+        std::vector<Insertion> gaps;
+        GapStore::Cursor cursor;
+        char* p = &out[0];
+        for (size_t i = first; i != last; ++i)
+        {
+            const FastaRecord& record = input.records[i];
+            std::memcpy(p, input.files[record.file].begin() + record.header_begin, record.header_length);
+            p += record.header_length;
+            *p++ = '\n';
+
+            input.get_sequence(i, sequence);
+            const std::vector<Insertion>* row_gaps_ptr = nullptr;
+            try
+            {
+                row_gaps_ptr = &insertions.get(representatives[i], gaps, cursor); // Duplicates share their representative's gaps
+            }
+            catch (const std::exception&) // Exceptions must not leave a pool task
+            {
+                std::lock_guard<std::mutex> lock(read_error_mutex);
+                if (!read_error) read_error = std::current_exception();
+                read_failed = true;
+                return;
+            }
+            const std::vector<Insertion>& row_gaps = *row_gaps_ptr;
+            if (!_row_fits(sequence, row_gaps, row_length))
+            {
+                // Rows of another length, or with gaps out of order, cannot be placed at fixed offsets; keep the first such row
+                for (size_t row = bad_row; i < row && !bad_row.compare_exchange_weak(row, i); );
+                return;
+            }
+            size_t k = 0;
+            for (const auto& insertion : row_gaps)
+            {
+                p = std::copy(sequence.begin() + k, sequence.begin() + insertion.index, p);
+                p = std::fill_n(p, insertion.number, '-');
+                k = insertion.index;
+            }
+            p = std::copy(sequence.begin() + k, sequence.end(), p);
+            *p++ = '\n';
+        }
+
+        for (size_t written = 0; written != out.size(); )
+        {
+            const ssize_t n = pwrite(fd, out.data() + written, out.size() - written, (off_t)(offsets[first] + written));
+            if (n <= 0)
+            {
+                failed = true;
+                return;
+            }
+            written += (size_t)n;
+        }
+    };
+
+    if (threadPool0 == NULL || chunks.size() == 2)
+        for (size_t c = 0; c + 1 < chunks.size(); ++c)
+            write_chunk(c);
+    else
+        threadPool0->run_stealing(chunks.size() - 1, write_chunk);
+    close(fd);
+    if (read_failed)
+    {
+        std::remove(file_name.c_str());
+        std::rethrow_exception(read_error);
+    }
+    if (bad_row != record_count)
+    {
+        std::remove(file_name.c_str());
+        input.get_sequence(bad_row, each_sequence);
+        throw _row_length_error(input, bad_row, _row_length(each_sequence, insertions.get(representatives[bad_row], buffer)), row_length);
+    }
+    if (failed)
+        std::cout << "                    | Info : parallel write failed, writing again with one thread\n";
+    return !failed;
+#else
+    return false;
+#endif
+}
+
+void utils::write_to_str(std::string& ans, std::string& each_sequence, const std::vector<Insertion>& insertions)
+{
+    size_t ti = 0;
+    size_t k = 0;
+    if (arguments::ALL_LEN != 0)
+    {
+        if (ans.size() != arguments::ALL_LEN)
+            ans.resize(arguments::ALL_LEN);
+    }
+    else
+    {
+        arguments::ALL_LEN = each_sequence.size();
+        for (size_t j = 0; j < insertions.size(); j++)
+            arguments::ALL_LEN += insertions[j].number;
+        ans.resize(arguments::ALL_LEN);
+    }
+    /*for (size_t j = 0; j < insertions.size(); j++)
+    {
+        while (k < insertions[j].index)
+            ans[ti++] = each_sequence[k++];
+        for (int p = 0; p < insertions[j].number; p++)
+            ans[ti++] = '-';
+    }
+    while (k < each_sequence.size())ans[ti++] = each_sequence[k++];*/
+    for (const auto& insertion : insertions)
+    {
+        std::copy(each_sequence.begin() + k, each_sequence.begin() + insertion.index, ans.begin() + ti);
+        ti += insertion.index - k;
+
+        std::fill(ans.begin() + ti, ans.begin() + ti + insertion.number, '-');
+        ti += insertion.number;
+
+        k = insertion.index;
+    }
+
+    std::copy(each_sequence.begin() + k, each_sequence.end(), ans.begin() + ti);
+    return;
+}
+
+unsigned char* utils::copy_DNA(const std::vector<unsigned char>& sequence, unsigned char* A, size_t a_begin, size_t a_end)
+{
+    int i = 0;
+    while (a_begin < a_end)
+    {
+        A[i++] = sequence[a_begin++];
+    }
+    return A;
+}
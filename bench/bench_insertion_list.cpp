@@ -0,0 +1,107 @@
+// Delta-encoded insertion lists against vectors of Insertion: memory of the per-row pairwise results, then
+// Insertion::plus and minus over both containers and the sequential decoding rate.
+// Usage: bench_insertion_list [rows, default 20000] [runs per row, default 300]
+#include "../Utils/Insertion.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using utils::Insertion;
+using utils::InsertionList;
+
+static double _rate(size_t runs, std::chrono::steady_clock::time_point start)
+{
+    return runs / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t rows = argc > 1 ? (size_t)atol(argv[1]) : 20000;
+    const size_t runs = argc > 2 ? (size_t)atol(argv[2]) : 300;
+
+    // Mostly short distances and gap counts, as pairwise results have, with an occasional long jump or long gap
+    std::mt19937_64 random(5);
+    std::vector<std::vector<Insertion>> vectors(rows);
+    std::vector<InsertionList> lists(rows);
+    for (size_t i = 0; i != rows; ++i)
+    {
+        size_t index = 0;
+        for (size_t k = 0; k != runs; ++k)
+        {
+            index += 1 + random() % (k % 50 == 0 ? 50000 : 200);
+            vectors[i].push_back(Insertion({ index, 1 + (random() % 10 == 0 ? random() % 200 : random() % 3) }));
+        }
+        vectors[i].shrink_to_fit();
+        lists[i] = InsertionList(vectors[i].cbegin(), vectors[i].cend());
+        lists[i].shrink_to_fit();
+    }
+
+    size_t vector_bytes = 0, list_bytes = 0;
+    for (size_t i = 0; i != rows; ++i)
+    {
+        vector_bytes += vectors[i].capacity() * sizeof(Insertion) + sizeof(std::vector<Insertion>);
+        list_bytes += lists[i].memory_usage() + sizeof(InsertionList);
+    }
+    std::cout << "memory : vectors " << vector_bytes / 1048576.0 << " MB, lists " << list_bytes / 1048576.0 << " MB ("
+        << (double)list_bytes / (rows * runs) << " B per run)\n";
+
+    bool same = true;
+    for (size_t i = 0; i != rows; ++i)
+        same = same && std::equal(vectors[i].cbegin(), vectors[i].cend(), lists[i].begin());
+
+    // Row i plus row i + 1 into a new container of the same kind
+    const size_t pair_runs = (rows - 1) * runs * 2;
+    std::vector<std::vector<Insertion>> vector_sums(rows - 1);
+    std::vector<InsertionList> list_sums(rows - 1);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i + 1 < rows; ++i)
+    {
+        vector_sums[i].reserve(2 * runs);
+        Insertion::plus(vectors[i].cbegin(), vectors[i].cend(), vectors[i + 1].cbegin(), vectors[i + 1].cend(), std::back_inserter(vector_sums[i]));
+    }
+    const double vector_plus = _rate(pair_runs, start);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i + 1 < rows; ++i)
+    {
+        list_sums[i].reserve(2 * runs);
+        Insertion::plus(lists[i].begin(), lists[i].end(), lists[i + 1].begin(), lists[i + 1].end(), std::back_inserter(list_sums[i]));
+    }
+    const double list_plus = _rate(pair_runs, start);
+    std::cout << "plus   : vectors " << vector_plus << " M runs/s, lists " << list_plus << " M runs/s\n";
+
+    // The sum minus row i + 1 gives row i back
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i + 1 < rows; ++i)
+    {
+        std::vector<Insertion> difference;
+        difference.reserve(runs);
+        Insertion::minus(vector_sums[i].cbegin(), vector_sums[i].cend(), vectors[i + 1].cbegin(), vectors[i + 1].cend(), std::back_inserter(difference));
+        same = same && difference == vectors[i];
+    }
+    const double vector_minus = _rate(pair_runs, start);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i + 1 < rows; ++i)
+    {
+        InsertionList difference;
+        difference.reserve(runs);
+        Insertion::minus(list_sums[i].begin(), list_sums[i].end(), lists[i + 1].begin(), lists[i + 1].end(), std::back_inserter(difference));
+        same = same && difference.byte_size() == lists[i].byte_size() && std::equal(difference.begin(), difference.end(), lists[i].begin());
+    }
+    const double list_minus = _rate(pair_runs, start);
+    std::cout << "minus  : vectors " << vector_minus << " M runs/s, lists " << list_minus << " M runs/s\n";
+
+    // Walking every list once, as _merge_row does
+    start = std::chrono::steady_clock::now();
+    size_t total = 0;
+    for (const auto& list : lists)
+        for (const auto& insertion : list)
+            total += insertion.number;
+    std::cout << "decode : " << _rate(rows * runs, start) << " M runs/s (" << total % 7 << ")\n";
+    std::cout << "results of both containers " << (same ? "match" : "DIFFER") << "\n";
+    return same ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+// Thread pool throughput with the bounded lock-free ring against the previous pool (a std::queue under one mutex,
+// the submitter sleeping 1 ms while more tasks than workers are queued), then the two queues on their own.
+// Usage: bench_queue [tasks per run, default 200000]
+#include "../multi-thread/multi.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// The thread pool as it was before BoundedQueue, reduced to execute and waitFinished
+class MutexPool
+{
+public:
+    explicit MutexPool(size_t threads) : stop(false), busy(0)
+    {
+        for (size_t i = 0; i < threads; ++i)
+            workers.emplace_back([this]() {
+                while (true)
+                {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(queueMutex);
+                        condition.wait(lock, [this] { return stop || !tasks.empty(); });
+                        if (stop && tasks.empty()) return;
+                        ++busy;
+                        task = std::move(tasks.front());
+                        tasks.pop();
+                    }
+                    task();
+                    {
+                        std::lock_guard<std::mutex> lock(queueMutex);
+                        --busy;
+                        cv_finished.notify_one();
+                    }
+                }
+            });
+    }
+
+    template<typename Func>
+    void execute(Func&& func)
+    {
+        while (tasks.size() > workers.size())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            tasks.emplace(std::forward<Func>(func));
+        }
+        condition.notify_one();
+    }
+
+    void waitFinished()
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        cv_finished.wait(lock, [this] { return tasks.empty() && (busy == 0); });
+    }
+
+    ~MutexPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stop = true;
+        }
+        condition.notify_all();
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex queueMutex;
+    std::condition_variable condition;
+    std::condition_variable cv_finished;
+    bool stop;
+    size_t busy;
+};
+
+// Bounded queue under one mutex with two condition variables, the usual blocking design
+template<typename T>
+class MutexQueue
+{
+public:
+    explicit MutexQueue(size_t capacity) : _capacity(capacity), _stop(false) {}
+
+    void push(T item)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _not_full.wait(lock, [this] { return _items.size() < _capacity; });
+        _items.push(std::move(item));
+        lock.unlock();
+        _not_empty.notify_one();
+    }
+
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _not_empty.wait(lock, [this] { return !_items.empty() || _stop; });
+        if (_items.empty()) return false;
+        item = std::move(_items.front());
+        _items.pop();
+        lock.unlock();
+        _not_full.notify_one();
+        return true;
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _not_empty.notify_all();
+    }
+
+private:
+    size_t _capacity;
+    bool _stop;
+    std::queue<T> _items;
+    std::mutex _mutex;
+    std::condition_variable _not_full;
+    std::condition_variable _not_empty;
+};
+
+// Function to run tasks of work multiply-adds each from one submitting thread; returns tasks per second
+template<typename Pool>
+static double _pool_rate(Pool& pool, size_t tasks, int work)
+{
+    std::atomic<size_t> sum(0);
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != tasks; ++i)
+        pool.execute([&sum, work]() {
+            size_t x = 0;
+            for (int k = 0; k < work; ++k)
+                x += (size_t)k * k;
+            sum += x | 1;
+        });
+    pool.waitFinished();
+    return tasks / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Function to move items from producers to consumers through a queue of 16 cells; returns items per second
+template<typename Queue>
+static double _queue_rate(int producers, int consumers, size_t items)
+{
+    Queue queue(16);
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+    for (int c = 0; c != consumers; ++c)
+        threads.emplace_back([&queue]() {
+            size_t item;
+            while (queue.pop(item));
+        });
+    std::vector<std::thread> producer_threads;
+    for (int p = 0; p != producers; ++p)
+        producer_threads.emplace_back([&queue, items, producers]() {
+            for (size_t k = 0; k != items / producers; ++k)
+                queue.push(k);
+        });
+    for (auto& thread : producer_threads)
+        thread.join();
+    queue.close();
+    for (auto& thread : threads)
+        thread.join();
+    return items / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    const size_t tasks = argc > 1 ? (size_t)atol(argv[1]) : 200000;
+    std::cout << "hardware threads : " << std::thread::hardware_concurrency() << "\n";
+    for (int work : { 0, 2000 })
+    {
+        std::cout << "pool, " << work << " multiply-adds per task (tasks/s)\n";
+        for (size_t threads : { 1, 2, 4, 8, 16 })
+        {
+            // The old pool sleeps 1 ms whenever its queue is full, so it gets fewer tasks to keep the run short
+            MutexPool old_pool(threads);
+            const double old_rate = _pool_rate(old_pool, tasks / 20, work);
+            ThreadPool new_pool(threads);
+            const double new_rate = _pool_rate(new_pool, tasks, work);
+            std::cout << "  threads " << threads << " : mutex queue " << (size_t)old_rate << ", ring " << (size_t)new_rate << "\n";
+        }
+    }
+
+    std::cout << "queue of 16 cells (items/s)\n";
+    for (int threads : { 1, 2, 4 })
+        std::cout << "  " << threads << " producers, " << threads << " consumers : mutex queue "
+            << (size_t)_queue_rate<MutexQueue<size_t>>(threads, threads, tasks * 5) << ", ring "
+            << (size_t)_queue_rate<BoundedQueue<size_t>>(threads, threads, tasks * 5) << "\n";
+    return 0;
+}
@@ -0,0 +1,226 @@
+// Rank queries of the 2-bit packed BWT against a byte BWT with a count table per position (the layout the index used
+// before), then the backward search of whole rows: the original search that scans the interval with find/rfind at
+// every step, the same search with rank queries, and the center index as it is now.
+// Usage: bench_rank [center length, default 5000000]
+#include "../SuffixArray/SuffixArray.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using sequence_type = std::vector<unsigned char>;
+using triple = std::array<size_t, 3>;
+
+// The index as search_for_prefix used it before rank queries: byte BWT, count table at every position, and
+// intervals narrowed by scanning them for the first and last occurrence of the next symbol
+class ScanIndex
+{
+public:
+    // Constructor: B and the counts from the suffix array of the reversed center with its end mark
+    ScanIndex(const sequence_type& centre, const int32_t* SA)
+        : length((int)centre.size() + 1)
+        , B(length)
+        , O(length + 1)
+        , SA(SA)
+    {
+        std::vector<unsigned char> reword(centre.rbegin(), centre.rend());
+        reword.push_back(nucleic_acid_pseudo::end_mark);
+        std::array<int32_t, 4> num = { 0, 0, 0, 0 };
+        for (int i = 0; i < length; i++)
+        {
+            B[i] = reword[(SA[i] + length - 1) % length];
+            if (B[i] != 0)
+                num[B[i] - 1]++;
+            O[i] = num;
+        }
+        begin = { 1, num[0] + 1, num[0] + num[1] + 1, num[0] + num[1] + num[2] + 1, length };
+    }
+
+    // Function to get common substrings above a threshold length, as the center index did; rank selects the
+    // interval update: false scans the interval with find/rfind, true counts the symbol before its bounds
+    template<typename RandomAccessIterator>
+    std::vector<triple> get_common_substrings(RandomAccessIterator first, RandomAccessIterator last, size_t threshold, bool rank) const
+    {
+        std::vector<triple> common_substrings;
+        const size_t rhs_len = last - first;
+        if (rhs_len < threshold)
+            return common_substrings;
+
+        for (size_t rhs_index = 0; rhs_index < rhs_len;)
+        {
+            auto found = search_for_prefix(first + rhs_index, last, threshold, rank);
+            if (found.empty())
+            {
+                ++rhs_index;
+            }
+            else
+            {
+                for (size_t i = 1; i != found.size(); ++i)
+                    common_substrings.emplace_back(triple({ found[i], rhs_index, found[0] }));
+                rhs_index += found[0] - threshold + 1;
+            }
+        }
+        return common_substrings;
+    }
+
+private:
+    template<typename InputIterator>
+    std::vector<size_t> search_for_prefix(InputIterator first, InputIterator last, size_t threshold, bool rank) const
+    {
+        int start, end, len_sub = last - first;
+        char sub = *(first++);
+        start = begin[(int)sub - 1];
+        end = begin[(int)sub] - 1;
+
+        while (first < last)
+        {
+            sub = *(first);
+            if (rank)
+            {
+                // Occurrences of sub in B[0, start) and B[0, end]
+                const int lower = start == 0 ? 0 : O[start - 1][(int)sub - 1], upper = O[end][(int)sub - 1];
+                if (lower == upper)
+                    break;
+                start = begin[(int)sub - 1] + lower;
+                end = begin[(int)sub - 1] + upper - 1;
+            }
+            else
+            {
+                const int lbegin = find(sub, start, end);
+                const int lend = rfind(sub, start, end);
+                if (lbegin == -1)
+                    break;
+                start = begin[(int)sub - 1] + O[lbegin][(int)sub - 1] - 1;
+                end = begin[(int)sub - 1] + O[lend][(int)sub - 1] - 1;
+            }
+            first++;
+        }
+
+        const size_t common_prefix_length = len_sub - (last - first);
+        if (common_prefix_length < threshold)
+            return std::vector<size_t>();
+
+        std::vector<size_t> starts{ common_prefix_length };
+        for (int i = start; i <= end; i++)
+            starts.emplace_back(length - 1 - SA[i] - common_prefix_length);
+        return starts;
+    }
+
+    int find(char now, int start, int end) const
+    {
+        for (int i = start; i <= end; i++)
+            if (B[i] == now)
+                return i;
+        return -1;
+    }
+
+    int rfind(char now, int start, int end) const
+    {
+        for (int i = end; i >= start; i--)
+            if (B[i] == now)
+                return i;
+        return -1;
+    }
+
+    const int length;
+    std::vector<unsigned char> B;
+    std::vector<std::array<int32_t, 4>> O; // Counts of A/C/G/T in B[0, i]
+    std::array<int, 5> begin;
+    const int32_t* SA;
+};
+
+static double _seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    const size_t length = argc > 1 ? (size_t)atol(argv[1]) : 5000000;
+    std::mt19937_64 random(3);
+    sequence_type centre(length);
+    for (auto& c : centre)
+        c = (unsigned char)(random() % 4 + 1);
+
+    // Random rank queries, the access pattern of backward search steps
+    const size_t query_count = 20000000;
+    std::vector<std::pair<unsigned char, size_t>> queries(query_count);
+    for (auto& query : queries)
+        query = std::make_pair((unsigned char)(random() % 4 + 1), (size_t)(random() % (length + 1)));
+
+    {
+        // Byte BWT with the counts of A/C/G/T before every position: 17 bytes per base
+        std::vector<std::array<uint32_t, 4>> counts(length + 1);
+        for (size_t i = 0; i != length; ++i)
+        {
+            counts[i + 1] = counts[i];
+            ++counts[i + 1][centre[i] - 1];
+        }
+        const auto start = std::chrono::steady_clock::now();
+        size_t sum = 0;
+        for (const auto& query : queries)
+            sum += counts[query.second][query.first - 1];
+        const double seconds = _seconds_since(start);
+        std::cout << "byte table   : " << (length + 1) * 17 / 1048576.0 << " MB, " << query_count / seconds / 1e6 << " M rank/s (" << sum % 7 << ")\n";
+    }
+
+    for (size_t words : { 2, 6, 8 })
+    {
+        suffix_array::PackedBwt<uint32_t> bwt;
+        bwt.build(length, words, [&centre](size_t i) { return centre[i]; });
+        const auto start = std::chrono::steady_clock::now();
+        size_t sum = 0;
+        for (const auto& query : queries)
+            sum += bwt.rank(query.first, query.second);
+        const double seconds = _seconds_since(start);
+        std::cout << "packed, " << words * 32 << " symbols per checkpoint : " << bwt.memory_usage() / 1048576.0 << " MB, "
+            << query_count / seconds / 1e6 << " M rank/s (" << sum % 7 << ")\n";
+    }
+
+    // Backward search of rows cut from the center with 3% substitutions, one row at a time and in batches
+    std::vector<sequence_type> rows(3);
+    for (auto& row : rows)
+    {
+        const size_t first = random() % (length - length / 5);
+        row.assign(centre.begin() + first, centre.begin() + first + length / 5);
+        for (auto& c : row)
+            if (random() % 100 < 3)
+                c = (unsigned char)(c % 4 + 1);
+    }
+    const suffix_array::SuffixArray<nucleic_acid_pseudo::NUMBER> index(centre.cbegin(), centre.cend(), nucleic_acid_pseudo::end_mark);
+
+    {
+        const ScanIndex scan(centre, index.SA);
+        for (bool rank : { false, true })
+        {
+            const auto start = std::chrono::steady_clock::now();
+            size_t anchors = 0;
+            for (const auto& row : rows)
+                anchors += scan.get_common_substrings(row.cbegin(), row.cend(), 15, rank).size();
+            const double seconds = _seconds_since(start);
+            std::cout << (rank ? "rank search  : " : "scan search  : ") << anchors << " anchors in " << seconds << " s, "
+                << anchors / seconds / 1e3 << " k anchors/s\n";
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t anchors = 0;
+    for (const auto& row : rows)
+        anchors += index.get_common_substrings(row.cbegin(), row.cend(), 15).size();
+    double seconds = _seconds_since(start);
+    std::cout << "search       : " << anchors << " anchors in " << seconds << " s, " << anchors / seconds / 1e3 << " k anchors/s\n";
+
+    std::vector<std::pair<sequence_type::const_iterator, sequence_type::const_iterator>> batch;
+    for (const auto& row : rows)
+        batch.emplace_back(row.cbegin(), row.cend());
+    start = std::chrono::steady_clock::now();
+    anchors = 0;
+    for (const auto& result : index.get_common_substrings_batch(batch, 15))
+        anchors += result.size();
+    seconds = _seconds_since(start);
+    std::cout << "batch search : " << anchors << " anchors in " << seconds << " s, " << anchors / seconds / 1e3 << " k anchors/s\n";
+    return 0;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+// Bounded multi-producer multi-consumer ring queue. Pushing and popping are lock-free: every cell carries a
+// sequence number telling whether it is ready for the producer or the consumer of the current lap. Only a
+// thread that has to wait (a producer on a full queue, a consumer on an empty one) takes the mutex and sleeps
+// on a condition variable, and the other side only locks it to wake a thread that is actually waiting.
+// A cell is claimed (the position advanced) before it is published (its sequence stored), so for a short window
+// the positions say an item or a free cell is there while try_pop or try_push still fails; push and pop wait
+// that window out with a short spin and then by yielding, see _backoff.
+template<typename T>
+class BoundedQueue {
+public:
+    // Constructor; the capacity is rounded up to a power of two
+    explicit BoundedQueue(size_t capacity) : _stop(false), _push_waiters(0), _pop_waiters(0), _enqueue_pos(0), _dequeue_pos(0) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        _mask = size - 1;
+        _cells = std::vector<Cell>(size);
+        for (size_t i = 0; i != size; ++i)
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Function to add an item, or return false at once if the queue is full
+    bool try_push(T& item) {
+        size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = _cells[pos & _mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
+            if (diff == 0) {
+                if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = std::move(item);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    _wake(_pop_waiters, _not_empty);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+                return false; // The cell still holds an item of the previous lap
+            else
+                pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Function to take an item, or return false at once if the queue is empty
+    bool try_pop(T& item) {
+        size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = _cells[pos & _mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)(pos + 1);
+            if (diff == 0) {
+                if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    item = std::move(cell.data);
+                    cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+                    _wake(_push_waiters, _not_full);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+                return false; // The cell has not been filled in this lap
+            else
+                pos = _dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Function to add an item, blocking while the queue is full
+    void push(T item) {
+        for (unsigned attempts = 0; !try_push(item); )
+            if (_full())
+                _sleep(_push_waiters, _not_full, [this] { return !_full(); });
+            else
+                _backoff(attempts); // A consumer has taken the head cell but not released it yet
+    }
+
+    // Function to take an item, blocking while the queue is empty; returns false once the queue is closed and empty
+    bool pop(T& item) {
+        for (unsigned attempts = 0; !try_pop(item); ) {
+            if (_stop.load()) return false;
+            if (_empty())
+                _sleep(_pop_waiters, _not_empty, [this] { return !_empty() || _stop.load(); });
+            else
+                _backoff(attempts); // A producer has claimed the tail cell but not published it yet
+        }
+        return true;
+    }
+
+    // Function to wake all waiting consumers; pop fails once the remaining items are taken
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop.store(true);
+        }
+        _not_empty.notify_all();
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    bool _empty() const { return _dequeue_pos.load() >= _enqueue_pos.load(); }
+    bool _full() const { return _enqueue_pos.load() - _dequeue_pos.load() > _mask; }
+
+    // Helper function to sleep until ready() holds. The waiter is counted before ready() is checked under the
+    // mutex, and _wake reads the count after its change to the queue, so one of the two always sees the other.
+    template<typename Ready>
+    void _sleep(std::atomic<size_t>& waiters, std::condition_variable& condition, Ready ready) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        waiters.fetch_add(1);
+        condition.wait(lock, ready);
+        waiters.fetch_sub(1);
+    }
+
+    // Helper function to wait for a claimed cell to be published. The positions already say it is ready, so _sleep
+    // would return at once: the window is a few instructions unless the other thread is preempted inside it, hence
+    // a short spin first, then yielding the processor to that thread
+    static void _backoff(unsigned& attempts) {
+        if (++attempts > 32)
+            std::this_thread::yield();
+    }
+
+    // Helper function to wake one waiter, locking the mutex only if there is one
+    void _wake(std::atomic<size_t>& waiters, std::condition_variable& condition) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load() == 0) return;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+        }
+        condition.notify_one();
+    }
+
+    std::vector<Cell> _cells; // Ring of cells, a power of two
+    size_t _mask; // Number of cells minus one
+    std::atomic<bool> _stop; // Set by close
+    std::atomic<size_t> _push_waiters; // Producers sleeping on a full queue
+    std::atomic<size_t> _pop_waiters; // Consumers sleeping on an empty queue
+    std::mutex _mutex; // Only taken to sleep or to wake a sleeping thread
+    std::condition_variable _not_full;
+    std::condition_variable _not_empty;
+    alignas(64) std::atomic<size_t> _enqueue_pos; // Next position to fill
+    alignas(64) std::atomic<size_t> _dequeue_pos; // Next position to take
+};
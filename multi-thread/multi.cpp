@@ -1,3 +1,3 @@
-#include "multi.hpp"
-
+#include "multi.hpp"
+
 ThreadPool* threadPool0 = NULL;
\ No newline at end of file
@@ -1,106 +1,124 @@
-#pragma once
-
-#include <iostream>
-#include <vector>
-#include <queue>
-#include <functional>
-#include <thread>
-#include <mutex>
-#include <condition_variable>
-#include <chrono>
-
-class ThreadPool {
-public:
-    // Constructor to initialize the thread pool with a given number of threads
-    explicit ThreadPool(size_t numThreads) :Thread_num(numThreads), stop(false), busy(0) {
-        for (size_t i = 0; i < numThreads; ++i) {
-            workers.emplace_back([this]() {
-                while (true) {
-                    std::function<void()> task;
-                    {
-                        // Acquire lock to access the task queue
-                        std::unique_lock<std::mutex> lock(queueMutex);
-                        // Wait until there are tasks or the pool is stopping
-                        condition.wait(lock, [this] { return stop || !tasks.empty(); });
-                        if (stop && tasks.empty()) return; // Exit thread if stopping and no tasks
-                        ++busy;
-                        // Get the next task from the queue
-                        task = std::move(tasks.front());
-                        tasks.pop();
-                    }
-                    // Execute the task
-                    task();
-                    {
-                        // Lock to update the busy count and notify finished condition
-                        std::lock_guard<std::mutex> lock(queueMutex);
-                        --busy;
-                        cv_finished.notify_one();
-                    }
-                }
-            });
-        }
-    }
-
-    // Template function to execute a given task with arguments
-    template<typename Func, typename... Args>
-    void execute(Func&& func, Args&&... args) {
-        // Wait until there's enough capacity in the queue
-        while (tasks.size() > workers.size())
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        {
-            // Lock and add the task to the queue
-            std::lock_guard<std::mutex> lock(queueMutex);
-            tasks.emplace(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
-        }
-        // Notify one worker thread to pick up the new task
-        condition.notify_one();
-    }
-
-    // Overloaded execute function for member function pointers
-    template<typename Func, typename... Args>
-    void execute(void (Func::* func)(Args...), Func* obj, Args&&... args) {
-        // Wait until there's enough capacity in the queue
-        while (tasks.size() > workers.size())
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        {
-            // Lock and add the member function task to the queue
-            std::lock_guard<std::mutex> lock(queueMutex);
-            tasks.emplace(std::bind(std::mem_fn(func), obj, std::forward<Args>(args)...));
-        }
-        // Notify one worker thread to pick up the new task
-        condition.notify_one();
-    }
-
-    // Wait until all tasks in the queue are completed
-    void waitFinished() {
-        std::unique_lock<std::mutex> lock(queueMutex);
-        cv_finished.wait(lock, [this] { return tasks.empty() && (busy == 0); });
-    }
-
-    // Destructor to stop all threads and clean up
-    ~ThreadPool() {
-        {
-            std::lock_guard<std::mutex> lock(queueMutex);
-            stop = true; // Set the stop flag to true
-        }
-        condition.notify_all(); // Notify all worker threads to finish
-        for (std::thread& worker : workers) {
-            if (worker.joinable()) worker.join(); // Join all worker threads
-        }
-    }
-
-    size_t Thread_num; // Number of threads in the pool
-    std::vector<std::thread> workers; // Vector of worker threads
-    std::mutex mutex_ns, mutex_fp; // Mutex for potential future use (currently unused)
-
-private:
-    std::queue<std::function<void()>> tasks; // Task queue
-    std::mutex queueMutex; // Mutex for task queue synchronization
-    std::condition_variable condition; // Condition variable for task availability
-    std::condition_variable cv_finished; // Condition variable to signal when tasks are finished
-    bool stop; // Flag to stop all threads
-    size_t busy; // Count of currently busy threads
-};
-
-// External pointer to a ThreadPool instance
-extern ThreadPool* threadPool0;
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "BoundedQueue.hpp"
+
+class ThreadPool {
+public:
+    // Constructor to initialize the thread pool with a given number of threads; at most twice as many tasks wait in the queue
+    explicit ThreadPool(size_t numThreads) :Thread_num(numThreads), tasks(2 * numThreads), pending(0) {
+        for (size_t i = 0; i < numThreads; ++i) {
+            workers.emplace_back([this, i]() {
+                _worker_index() = (int)i; // Lets tasks find per-worker state
+                std::function<void()> task;
+                // Take tasks until the queue is closed and empty, sleeping while it is empty
+                while (tasks.pop(task)) {
+                    task();
+                    task = nullptr; // Release what the task holds before it counts as finished
+                    if (pending.fetch_sub(1) == 1) {
+                        // Lock so the last task cannot finish between the check and the wait of waitFinished
+                        std::lock_guard<std::mutex> lock(finishedMutex);
+                        cv_finished.notify_all();
+                    }
+                }
+            });
+        }
+    }
+
+    // Template function to execute a given task with arguments; blocks while the queue is full
+    template<typename Func, typename... Args>
+    void execute(Func&& func, Args&&... args) {
+        pending.fetch_add(1);
+        tasks.push(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
+    }
+
+    // Overloaded execute function for member function pointers
+    template<typename Func, typename... Args>
+    void execute(void (Func::* func)(Args...), Func* obj, Args&&... args) {
+        pending.fetch_add(1);
+        tasks.push(std::bind(std::mem_fn(func), obj, std::forward<Args>(args)...));
+    }
+
+    // Run func(task) for every task in [0, count) on all workers and wait for them. Tasks are dealt round-robin
+    // to one deque per worker; a worker takes its own tasks from the front and, once it runs out, steals from
+    // the back of the others. List the most expensive tasks first so the cheap ones fill the gaps at the end.
+    template<typename Func>
+    void run_stealing(size_t count, Func func) {
+        struct Deque {
+            std::mutex mutex;
+            std::deque<size_t> tasks;
+        };
+        const size_t n = workers.size();
+        std::vector<Deque> deques(n);
+        for (size_t task = 0; task != count; ++task)
+            deques[task % n].tasks.push_back(task);
+
+        for (size_t w = 0; w != n; ++w)
+            execute([&deques, &func, n, w]() {
+                while (true) {
+                    size_t task = 0;
+                    bool found = false;
+                    {
+                        std::lock_guard<std::mutex> lock(deques[w].mutex);
+                        if (!deques[w].tasks.empty()) {
+                            task = deques[w].tasks.front();
+                            deques[w].tasks.pop_front();
+                            found = true;
+                        }
+                    }
+                    // Own deque empty: steal the cheapest task left in another one
+                    for (size_t v = (w + 1) % n; !found && v != w; v = (v + 1) % n) {
+                        std::lock_guard<std::mutex> lock(deques[v].mutex);
+                        if (!deques[v].tasks.empty()) {
+                            task = deques[v].tasks.back();
+                            deques[v].tasks.pop_back();
+                            found = true;
+                        }
+                    }
+                    if (!found) return; // No task is ever added, so all deques stay empty
+                    func(task);
+                }
+            });
+        waitFinished();
+    }
+
+    // Wait until all tasks in the queue are completed
+    void waitFinished() {
+        std::unique_lock<std::mutex> lock(finishedMutex);
+        cv_finished.wait(lock, [this] { return pending.load() == 0; });
+    }
+
+    // Destructor to stop all threads and clean up
+    ~ThreadPool() {
+        tasks.close(); // Workers finish the queued tasks, then exit
+        for (std::thread& worker : workers) {
+            if (worker.joinable()) worker.join(); // Join all worker threads
+        }
+    }
+
+    // Index of the calling thread among the workers of its pool, or -1 for a thread outside any pool
+    static int worker_index() { return _worker_index(); }
+
+    size_t Thread_num; // Number of threads in the pool
+    std::vector<std::thread> workers; // Vector of worker threads
+    std::mutex mutex_ns, mutex_fp; // Mutex for potential future use (currently unused)
+
+private:
+    static int& _worker_index() { thread_local int index = -1; return index; }
+
+    BoundedQueue<std::function<void()>> tasks; // Task queue
+    std::atomic<size_t> pending; // Tasks submitted and not finished yet
+    std::mutex finishedMutex; // Mutex for waiting on finished tasks
+    std::condition_variable cv_finished; // Condition variable to signal when tasks are finished
+};
+
+// External pointer to a ThreadPool instance
+extern ThreadPool* threadPool0;
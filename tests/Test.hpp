@@ -0,0 +1,30 @@
+#pragma once
+// Minimal checks shared by the test programs: a failed CHECK prints its location, and main returns report()
+#include <iostream>
+
+namespace test
+{
+    inline int& failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    // Function to print the result of a test program and get its exit code
+    inline int report(const char* name)
+    {
+        if (failures() == 0)
+            std::cout << name << " : passed\n";
+        else
+            std::cout << name << " : " << failures() << " checks failed\n";
+        return failures() == 0 ? 0 : 1;
+    }
+}
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cout << __FILE__ << ":" << __LINE__ << " : check failed : " #condition "\n"; \
+            ++test::failures(); \
+        } \
+    } while (0)
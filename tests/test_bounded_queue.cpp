@@ -0,0 +1,93 @@
+// Bounded lock-free queue and the thread pool on top of it: every item pushed by several producers through a small
+// ring is popped exactly once, close wakes the consumers, and the pool runs every task of execute and run_stealing
+#include "Test.hpp"
+#include "../multi-thread/multi.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static void _check_queue(size_t capacity, int producers, int consumers, size_t items_per_producer)
+{
+    BoundedQueue<size_t> queue(capacity);
+    const size_t total = items_per_producer * producers;
+    std::vector<std::atomic<int>> received(total);
+    for (auto& count : received)
+        count = 0;
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c != consumers; ++c)
+        threads.emplace_back([&queue, &received]() {
+            size_t item;
+            while (queue.pop(item))
+                ++received[item];
+        });
+    std::vector<std::thread> producer_threads;
+    for (int p = 0; p != producers; ++p)
+        producer_threads.emplace_back([&queue, p, producers, items_per_producer]() {
+            for (size_t k = 0; k != items_per_producer; ++k)
+                queue.push(k * producers + p);
+        });
+    for (auto& thread : producer_threads)
+        thread.join();
+    queue.close();
+    for (auto& thread : threads)
+        thread.join();
+
+    bool once = true;
+    for (auto& count : received)
+        once = once && count == 1;
+    CHECK(once);
+}
+
+static void _check_pool(size_t threads)
+{
+    ThreadPool pool(threads);
+    std::atomic<size_t> done(0);
+    bool counted = true;
+    for (size_t round = 1; round <= 100; ++round)
+    {
+        for (int i = 0; i != 50; ++i)
+            pool.execute([&done]() { ++done; });
+        pool.waitFinished();
+        counted = counted && done == round * 50;
+    }
+    CHECK(counted);
+
+    std::vector<std::atomic<int>> hits(5000);
+    for (auto& hit : hits)
+        hit = 0;
+    pool.run_stealing(hits.size(), [&hits](size_t task) { ++hits[task]; });
+    bool once = true;
+    for (auto& hit : hits)
+        once = once && hit == 1;
+    CHECK(once);
+}
+
+int main()
+{
+    _check_queue(2, 1, 1, 100000);
+    _check_queue(8, 4, 4, 100000);
+    _check_queue(64, 3, 1, 100000);
+    _check_queue(4, 1, 6, 100000);
+
+    // close with nothing queued wakes every consumer
+    {
+        BoundedQueue<int> queue(4);
+        std::vector<std::thread> consumers;
+        std::atomic<int> stopped(0);
+        for (int c = 0; c != 4; ++c)
+            consumers.emplace_back([&queue, &stopped]() {
+                int item;
+                if (!queue.pop(item)) ++stopped;
+            });
+        queue.close();
+        for (auto& thread : consumers)
+            thread.join();
+        CHECK(stopped == 4);
+    }
+
+    for (size_t threads : { 1, 3, 8 })
+        _check_pool(threads);
+    return test::report("test_bounded_queue");
+}
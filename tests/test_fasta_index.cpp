@@ -0,0 +1,79 @@
+// Record index of the input: the raw bases of every record, read back through the regular-layout fast path or the
+// line walk, match the bases that were packed, for LF and CRLF files and for every kind of ragged layout
+#include "Test.hpp"
+#include "../Utils/Utils.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct Case
+{
+    const char* name;
+    std::string text; // File contents
+    std::vector<std::string> bases; // Bases of every record
+};
+
+static void _check_case(const Case& c)
+{
+    const std::string file_name = "test_fasta_index.fa";
+    std::ofstream(file_name, std::ios::binary | std::ios::trunc) << c.text;
+
+    std::string center_name;
+    int II = 0, center = -1;
+    utils::FastaIndex index;
+    const utils::PackedSequences sequences = utils::read_to_pseudo(std::vector<std::string>{ file_name }, center_name, II, center, index);
+
+    bool same = index.records.size() == c.bases.size() && sequences.size() == c.bases.size();
+    std::string bases;
+    for (size_t i = 0; same && i != c.bases.size(); ++i)
+    {
+        index.get_sequence(i, bases);
+        same = bases == c.bases[i] && sequences.length(i) == bases.size();
+    }
+    if (!same)
+        std::cout << "case " << c.name << " : bases differ from the input\n";
+    CHECK(same);
+    std::remove(file_name.c_str());
+}
+
+// Function to write bases in lines of the given widths (the last width repeats) with the given line break
+static std::string _lines(const std::string& bases, const std::vector<size_t>& widths, const std::string& line_break, bool last_break = true)
+{
+    std::string text;
+    for (size_t p = 0, line = 0; p < bases.size(); ++line)
+    {
+        const size_t width = widths[std::min(line, widths.size() - 1)];
+        text += bases.substr(p, width);
+        p += width;
+        if (p < bases.size() || last_break) text += line_break;
+    }
+    return text;
+}
+
+int main()
+{
+    std::string bases;
+    for (size_t i = 0; i != 1000; ++i)
+        bases.push_back("ACGT"[(i * 7 + i / 13) % 4]);
+    const std::string a = bases.substr(0, 24), b = bases.substr(100, 10), c = bases.substr(300, 301);
+
+    const std::vector<Case> cases = {
+        { "regular", ">r1\n" + _lines(a, { 10 }, "\n") + ">r2\n" + _lines(c, { 60 }, "\n"), { a, c } },
+        { "long last line", ">r1\n" + a.substr(0, 10) + "\n" + a.substr(10) + "\n", { a } },
+        { "last line longer than the others", ">r1\nACGTACGTAC\nACGTACGTAC\nACGTACGTACGT\n", { "ACGTACGTACACGTACGTACACGTACGTACGT" } },
+        { "short first line", ">r1\n" + _lines(a, { 4, 10 }, "\n"), { a } },
+        { "ragged middle line", ">r1\n" + _lines(c, { 60, 60, 59, 60 }, "\n"), { c } },
+        { "crlf", ">r1\r\n" + _lines(a, { 10 }, "\r\n") + ">r2\r\n" + _lines(b, { 4 }, "\r\n"), { a, b } },
+        { "crlf long last line", ">r2\r\nACGT\r\nACGT\r\nACGTAC\r\n", { "ACGTACGTACGTAC" } },
+        { "crlf without final break", ">r1\r\n" + _lines(b, { 4 }, "\r\n", false), { b } },
+        { "mixed line breaks", ">r1\n" + b.substr(0, 4) + "\r\n" + b.substr(4, 4) + "\n" + b.substr(8) + "\n", { b } },
+        { "blank line inside", ">r1\n" + b.substr(0, 4) + "\n\n" + b.substr(4, 4) + "\n" + b.substr(8) + "\n", { b } },
+        { "without final break", ">r1\n" + _lines(c, { 70 }, "\n", false) + "\n>r2\n" + _lines(a, { 10 }, "\n", false), { c, a } },
+        { "one line", ">r1\n" + c + "\n>r2\n" + b, { c, b } },
+    };
+    for (const auto& test_case : cases)
+        _check_case(test_case);
+    return test::report("test_fasta_index");
+}
@@ -0,0 +1,116 @@
+// Output writers: the parallel writer and the stream writer give the same file, duplicates are written with their
+// representative's gaps, and a row of another length is reported as an error instead of being written
+#include "Test.hpp"
+#include "../Utils/Utils.hpp"
+#include "../Utils/Arguments.hpp"
+#include "../multi-thread/multi.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+static const std::string input_name = "test_fasta_writer_in.fa";
+static const std::string output_name = "test_fasta_writer_out.fa";
+
+static std::string _read_file(const std::string& file_name)
+{
+    std::ifstream ifs(file_name, std::ios::binary);
+    std::ostringstream text;
+    text << ifs.rdbuf();
+    return text.str();
+}
+
+static bool _file_exists(const std::string& file_name)
+{
+    return std::ifstream(file_name).good();
+}
+
+// Function to run both writers on the input with one gap list per record; returns the parallel writer's file, or
+// the error both writers report. With truncate_spill_file the rows are spilled and the last byte of the spill file is cut off.
+static std::string _write(const std::vector<std::vector<utils::Insertion>>& gaps, std::string& stream_output, bool truncate_spill_file = false)
+{
+    const std::string text = ">a\nACGTACGT\n>b\nACGTAC\n>c\nACGTACGT\n>d\nAAAA\n";
+    const std::vector<size_t> representatives = { 0, 1, 0, 3 }; // c is a duplicate of a
+    std::ofstream(input_name, std::ios::binary | std::ios::trunc) << text;
+
+    std::string center_name;
+    int II = 0, center = -1;
+    utils::FastaIndex index;
+    utils::read_to_pseudo(std::vector<std::string>{ input_name }, center_name, II, center, index);
+    utils::GapStore store(truncate_spill_file ? "." : "", 1);
+    for (const auto& row : gaps)
+        store.push_back(std::vector<utils::Insertion>(row));
+    store.finish();
+    if (truncate_spill_file)
+        std::filesystem::resize_file("./halign4_gaps_" + std::to_string(getpid()) + ".bin", store.spilled_bytes() - 1);
+
+    std::string parallel_output;
+    arguments::ALL_LEN = 0;
+    try
+    {
+        CHECK(utils::write_to_fasta_parallel(output_name, index, store, representatives));
+        parallel_output = _read_file(output_name);
+    }
+    catch (const std::runtime_error& e)
+    {
+        CHECK(!_file_exists(output_name)); // The partial output is removed
+        parallel_output = e.what();
+    }
+
+    arguments::ALL_LEN = 0;
+    std::ostringstream os;
+    try
+    {
+        utils::write_to_fasta(os, index, store, representatives);
+        stream_output = os.str();
+    }
+    catch (const std::runtime_error& e)
+    {
+        stream_output = e.what();
+    }
+    std::remove(output_name.c_str());
+    std::remove(input_name.c_str());
+    return parallel_output;
+}
+
+int main()
+{
+    for (size_t threads : { 0, 3 })
+    {
+        threadPool0 = threads ? new ThreadPool(threads) : NULL;
+
+        // Every row nine columns wide
+        std::string stream_output;
+        const std::string output = _write({ { { 2, 1 } }, { { 2, 1 }, { 4, 2 } }, {}, { { 1, 2 }, { 2, 3 } } }, stream_output);
+        CHECK(output == ">a\nAC-GTACGT\n>b\nAC-GT--AC\n>c\nAC-GTACGT\n>d\nA--A---AA\n");
+        CHECK(stream_output == output);
+
+        // Row d six columns wide: both writers name it instead of writing a shifted file
+        const std::string error = _write({ { { 2, 1 } }, { { 2, 1 }, { 4, 2 } }, {}, { { 1, 2 } } }, stream_output);
+        CHECK(error.find("row 3 (>d)") != std::string::npos && error.find("6 columns, expected 9") != std::string::npos);
+        CHECK(stream_output == error);
+
+        // Gaps past the end of row b, with the right total
+        const std::string misplaced = _write({ { { 2, 1 } }, { { 7, 3 } }, {}, { { 1, 2 }, { 2, 3 } } }, stream_output);
+        CHECK(misplaced.find("row 1 (>b)") != std::string::npos && stream_output == misplaced);
+
+        // A spilled row that cannot be read back is reported, not written with stale gaps
+        const std::string lost = _write({ { { 2, 1 } }, { { 2, 1 }, { 4, 2 } }, {}, { { 1, 2 }, { 2, 3 } } }, stream_output, true);
+        CHECK(lost.find("cannot read row 3 from spill file") != std::string::npos && stream_output == lost);
+
+        delete threadPool0;
+        threadPool0 = NULL;
+    }
+    return test::report("test_fasta_writer");
+}
@@ -0,0 +1,143 @@
+// Gap lists of the final alignment: rows kept in memory and rows spilled to disk read back the same, in any order
+// and through several cursors, and the spill file is removed with the store
+#include "Test.hpp"
+#include "../Utils/GapStore.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+static std::vector<std::vector<utils::Insertion>> _random_rows(std::mt19937& random, size_t rows)
+{
+    std::vector<std::vector<utils::Insertion>> gaps(rows);
+    for (auto& row : gaps)
+    {
+        size_t index = 0;
+        for (size_t runs = random() % 40; runs != 0; --runs)
+        {
+            index += random() % 3 == 0 ? random() % 100000 : random() % 100; // Deltas of one to three bytes
+            row.push_back(utils::Insertion({ index, random() % 4 == 0 ? 1 + random() % 5000 : 1 + random() % 10 }));
+            ++index;
+        }
+    }
+    return gaps;
+}
+
+static bool _file_exists(const std::string& path)
+{
+    return std::ifstream(path).good();
+}
+
+static void _check_store(const std::vector<std::vector<utils::Insertion>>& rows, size_t memory_limit, bool spill)
+{
+    const std::string spill_file = "./halign4_gaps_" + std::to_string(getpid()) + ".bin";
+    {
+        utils::GapStore store(spill ? "." : "", memory_limit);
+        for (const auto& row : rows)
+            store.push_back(std::vector<utils::Insertion>(row));
+        store.finish();
+        CHECK(store.size() == rows.size());
+        CHECK(store.spilled() == spill);
+        CHECK(_file_exists(spill_file) == spill);
+        if (spill)
+            CHECK(store.memory_usage() <= memory_limit + 2 * (rows.size() + 1) * sizeof(uint64_t)); // Only the offsets stay, with the growth of their vector
+
+        // In order through the store's own cursor
+        std::vector<utils::Insertion> buffer;
+        bool same = true;
+        for (size_t i = 0; i != rows.size(); ++i)
+            same = same && store.get(i, buffer) == rows[i];
+        CHECK(same);
+
+        // Backwards and interleaved through two cursors, as the parallel writer reads
+        utils::GapStore::Cursor first, second;
+        std::vector<utils::Insertion> first_buffer, second_buffer;
+        same = true;
+        for (size_t i = rows.size(); i-- != 0; )
+        {
+            same = same && store.get(i, first_buffer, first) == rows[i];
+            same = same && store.get(rows.size() - 1 - i, second_buffer, second) == rows[rows.size() - 1 - i];
+        }
+        CHECK(same);
+    }
+    CHECK(!_file_exists(spill_file));
+}
+
+int main()
+{
+    std::mt19937 random(5);
+    const auto rows = _random_rows(random, 3000);
+    _check_store(rows, 0, false); // No spill directory: everything stays in memory
+    _check_store(rows, size_t(1) << 30, false); // Below the limit nothing is written
+    _check_store(rows, 64 << 10, true); // Spilled in several batches
+    _check_store(rows, 1, true); // Spilled row by row
+    _check_store(std::vector<std::vector<utils::Insertion>>(10), 1, true); // Empty rows take no bytes
+
+    // A spill file that cannot be created is reported as an error and leaves nothing behind
+    {
+        const std::string directory = "./halign4_missing_" + std::to_string(getpid());
+        utils::GapStore store(directory, 1);
+        bool thrown = false;
+        try
+        {
+            store.push_back(std::vector<utils::Insertion>(rows[1]));
+        }
+        catch (const std::runtime_error& e)
+        {
+            thrown = std::string(e.what()).find(directory) != std::string::npos;
+        }
+        CHECK(thrown);
+        CHECK(!_file_exists(directory + "/halign4_gaps_" + std::to_string(getpid()) + ".bin"));
+    }
+
+    // A spill file that ends early or is gone is reported instead of being decoded from stale bytes
+    {
+        const std::string spill_file = "./halign4_gaps_" + std::to_string(getpid()) + ".bin";
+        utils::GapStore store(".", 1);
+        for (const auto& row : rows)
+            store.push_back(std::vector<utils::Insertion>(row));
+        store.finish();
+        size_t last = rows.size() - 1;
+        while (rows[last].empty())
+            --last;
+        std::filesystem::resize_file(spill_file, store.spilled_bytes() - 1);
+
+        utils::GapStore::Cursor cursor;
+        std::vector<utils::Insertion> buffer;
+        bool thrown = false;
+        try
+        {
+            store.get(last, buffer, cursor);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+        CHECK(store.get(0, buffer, cursor) == rows[0]); // The cursor recovers for rows still in the file
+
+        std::remove(spill_file.c_str());
+        utils::GapStore::Cursor fresh;
+        thrown = false;
+        try
+        {
+            store.get(0, buffer, fresh);
+        }
+        catch (const std::runtime_error& e)
+        {
+            thrown = std::string(e.what()).find(spill_file) != std::string::npos;
+        }
+        CHECK(thrown);
+    }
+    return test::report("test_gap_store");
+}
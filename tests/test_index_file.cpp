@@ -0,0 +1,182 @@
+// Saved center index (format version 4): an index mapped from its file answers queries like the index it was saved
+// from, the forward BWT is saved once built and mapped with the rest, and a file of another sequence or a damaged
+// file is rebuilt instead of being mapped
+#include "Test.hpp"
+#include "../SuffixArray/SuffixArray.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using sequence_type = std::vector<unsigned char>;
+
+static sequence_type _random_sequence(std::mt19937& random, size_t length)
+{
+    sequence_type sequence(length);
+    for (auto& c : sequence)
+        c = (unsigned char)(random() % 4 + 1);
+    return sequence;
+}
+
+// Queries cut from the center with a few substitutions, plus one unrelated query
+static std::vector<sequence_type> _queries(std::mt19937& random, const sequence_type& centre)
+{
+    std::vector<sequence_type> queries;
+    for (int q = 0; q != 8; ++q)
+    {
+        const size_t first = random() % (centre.size() / 2);
+        sequence_type query(centre.begin() + first, centre.begin() + first + centre.size() / 4);
+        for (size_t i = 0; i < query.size(); i += 37 + random() % 40)
+            query[i] = (unsigned char)(query[i] % 4 + 1);
+        queries.push_back(query);
+    }
+    queries.push_back(_random_sequence(random, centre.size() / 8));
+    return queries;
+}
+
+// Function to build an index while capturing its report, so the test can tell whether the file was mapped
+template<typename index_type>
+static std::unique_ptr<suffix_array::SuffixArray<nucleic_acid_pseudo::NUMBER, index_type>> _build(const sequence_type& centre,
+    const std::string& index_file, size_t sa_sampling, bool& loaded)
+{
+    std::ostringstream report;
+    std::streambuf* const previous = std::cout.rdbuf(report.rdbuf());
+    std::unique_ptr<suffix_array::SuffixArray<nucleic_acid_pseudo::NUMBER, index_type>> index(
+        new suffix_array::SuffixArray<nucleic_acid_pseudo::NUMBER, index_type>(centre.cbegin(), centre.cend(),
+            nucleic_acid_pseudo::end_mark, index_file, 192, sa_sampling));
+    std::cout.rdbuf(previous);
+    loaded = report.str().find("index loaded") != std::string::npos;
+    return index;
+}
+
+template<typename Index>
+static bool _same_answers(const Index& lhs, const Index& rhs, const std::vector<sequence_type>& queries)
+{
+    for (const auto& query : queries)
+        if (lhs.get_common_substrings(query.cbegin(), query.cend(), 15) != rhs.get_common_substrings(query.cbegin(), query.cend(), 15))
+            return false;
+    return true;
+}
+
+template<typename Index>
+static bool _same_smems(const Index& lhs, const Index& rhs, const std::vector<sequence_type>& queries)
+{
+    for (const auto& query : queries)
+        if (lhs.get_smems(query.cbegin(), query.cend(), 15) != rhs.get_smems(query.cbegin(), query.cend(), 15))
+            return false;
+    return true;
+}
+
+// Function to add the forward BWT while capturing the report; returns whether it had to be built
+template<typename Index>
+static bool _build_forward(Index& index, const sequence_type& centre)
+{
+    std::ostringstream report;
+    std::streambuf* const previous = std::cout.rdbuf(report.rdbuf());
+    index.build_forward(centre.cbegin(), centre.cend());
+    std::cout.rdbuf(previous);
+    return report.str().find("forward index built") != std::string::npos;
+}
+
+template<typename index_type>
+static void _check_forward(std::mt19937& random, size_t sa_sampling)
+{
+    const std::string index_file = "test_index_file.idx";
+    std::remove(index_file.c_str());
+    const sequence_type centre = _random_sequence(random, 100000);
+    const auto queries = _queries(random, centre);
+    bool loaded = false;
+
+    const auto built = _build<index_type>(centre, "", sa_sampling, loaded);
+    CHECK(_build_forward(*built, centre));
+
+    // The first run saves the index, then saves it again with the forward BWT
+    const auto saved = _build<index_type>(centre, index_file, sa_sampling, loaded);
+    CHECK(!loaded && !saved->bidirectional());
+    CHECK(_build_forward(*saved, centre));
+
+    // Later runs map both BWTs
+    const auto mapped = _build<index_type>(centre, index_file, sa_sampling, loaded);
+    CHECK(loaded && mapped->bidirectional());
+    CHECK(!_build_forward(*mapped, centre));
+    CHECK(_same_answers(*built, *mapped, queries));
+    CHECK(_same_smems(*built, *saved, queries));
+    CHECK(_same_smems(*built, *mapped, queries));
+
+    // An index file saved without the forward BWT is still mapped, and gets it on the first bidirectional run
+    std::remove(index_file.c_str());
+    _build<index_type>(centre, index_file, sa_sampling, loaded);
+    const auto unidirectional = _build<index_type>(centre, index_file, sa_sampling, loaded);
+    CHECK(loaded && !unidirectional->bidirectional());
+    CHECK(_build_forward(*unidirectional, centre));
+    CHECK(_same_smems(*built, *unidirectional, queries));
+    const auto upgraded = _build<index_type>(centre, index_file, sa_sampling, loaded);
+    CHECK(loaded && upgraded->bidirectional());
+    CHECK(_same_smems(*built, *upgraded, queries));
+    std::remove(index_file.c_str());
+}
+
+template<typename index_type>
+static void _check_round_trip(std::mt19937& random, size_t sa_sampling)
+{
+    const std::string index_file = "test_index_file.idx";
+    std::remove(index_file.c_str());
+    const sequence_type centre = _random_sequence(random, 200000);
+    const auto queries = _queries(random, centre);
+    bool loaded = false;
+
+    const auto built = _build<index_type>(centre, "", sa_sampling, loaded);
+    const auto saved = _build<index_type>(centre, index_file, sa_sampling, loaded);
+    CHECK(!loaded);
+    const auto mapped = _build<index_type>(centre, index_file, sa_sampling, loaded);
+    CHECK(loaded);
+    CHECK(_same_answers(*built, *saved, queries));
+    CHECK(_same_answers(*built, *mapped, queries));
+
+    // Another sequence of the same length: the checksum differs, so the index is rebuilt and saved again
+    sequence_type other = centre;
+    other[other.size() / 2] = (unsigned char)(other[other.size() / 2] % 4 + 1);
+    const auto other_built = _build<index_type>(other, "", sa_sampling, loaded);
+    const auto rebuilt = _build<index_type>(other, index_file, sa_sampling, loaded);
+    CHECK(!loaded);
+    CHECK(_same_answers(*other_built, *rebuilt, queries));
+    const auto remapped = _build<index_type>(other, index_file, sa_sampling, loaded);
+    CHECK(loaded);
+    CHECK(_same_answers(*other_built, *remapped, queries));
+
+    // Another SA sampling rate does not match the saved layout
+    _build<index_type>(other, index_file, sa_sampling == 1 ? 4 : 1, loaded);
+    CHECK(!loaded);
+    std::remove(index_file.c_str());
+}
+
+int main()
+{
+    std::mt19937 random(11);
+    _check_round_trip<int32_t>(random, 1);
+    _check_round_trip<int32_t>(random, 8);
+    _check_round_trip<int64_t>(random, 1);
+    _check_forward<int32_t>(random, 1);
+    _check_forward<int32_t>(random, 8);
+    _check_forward<int64_t>(random, 1);
+
+    // A truncated file is not mapped
+    {
+        const std::string index_file = "test_index_file.idx";
+        std::remove(index_file.c_str());
+        const sequence_type centre = _random_sequence(random, 50000);
+        bool loaded = false;
+        _build<int32_t>(centre, index_file, 1, loaded);
+        std::ifstream ifs(index_file, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        ifs.close();
+        std::ofstream(index_file, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size() / 2);
+        const auto rebuilt = _build<int32_t>(centre, index_file, 1, loaded);
+        CHECK(!loaded);
+        std::remove(index_file.c_str());
+    }
+    return test::report("test_index_file");
+}
@@ -0,0 +1,101 @@
+// Delta-encoded insertion lists: runs read back unchanged through the one-byte fast path and through varints of two
+// bytes or more, and the lists work with Insertion::plus, minus and insert_gaps as vectors do
+#include "Test.hpp"
+#include "../Utils/Insertion.hpp"
+
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using utils::Insertion;
+using utils::InsertionList;
+
+static bool _round_trip(const std::vector<Insertion>& insertions)
+{
+    InsertionList list;
+    for (const auto& insertion : insertions)
+        list.push_back(insertion);
+    const std::vector<Insertion> decoded(list.begin(), list.end());
+
+    // The encoded bytes decode the same from a copy, as the spill file and the residuals read them
+    const std::vector<unsigned char> bytes(list.data(), list.data() + list.byte_size());
+    const std::vector<Insertion> reread(InsertionList::const_iterator(bytes.data(), bytes.data() + bytes.size()),
+        InsertionList::const_iterator(bytes.data() + bytes.size(), bytes.data() + bytes.size()));
+    return list.size() == insertions.size() && decoded == insertions && reread == insertions;
+}
+
+int main()
+{
+    // Encoded sizes: one byte per value below 0x80, then one more byte per 7 bits
+    {
+        InsertionList list;
+        list.push_back(Insertion({ 5, 3 }));
+        CHECK(list.byte_size() == 2); // Fast path
+        list.push_back(Insertion({ 5 + 0x7f, 0x7f }));
+        CHECK(list.byte_size() == 4); // Largest values of the fast path
+        list.push_back(Insertion({ 5 + 0x7f + 0x80, 1 }));
+        CHECK(list.byte_size() == 7); // Two-byte delta
+        list.push_back(Insertion({ 5 + 0x7f + 0x80, 0 }));
+        CHECK(list.byte_size() == 9); // A zero delta
+        list.push_back(Insertion({ 5 + 0x7f + 0x80 + 0x4000, 0x4000 }));
+        CHECK(list.byte_size() == 15); // Three-byte delta and number
+        CHECK(list.size() == 5);
+    }
+
+    CHECK(_round_trip({}));
+    CHECK(_round_trip({ { 0, 1 } }));
+    CHECK(_round_trip({ { 0, 127 }, { 127, 127 }, { 128, 128 }, { 16511, 16383 }, { 16512, 16384 } }));
+    CHECK(_round_trip({ { 1000000, 5 }, { 1000000 + (size_t(1) << 35), size_t(1) << 40 } }));
+    const size_t largest = ~size_t(0);
+    CHECK(_round_trip({ { 0, largest }, { largest, 1 } })); // Ten-byte varints
+
+    // Random lists mixing every encoded width
+    std::mt19937_64 random(9);
+    bool same = true;
+    for (int n = 0; n != 2000; ++n)
+    {
+        std::vector<Insertion> insertions;
+        size_t index = 0;
+        for (size_t runs = random() % 50; runs != 0; --runs)
+        {
+            const int width = (int)(random() % 4);
+            index += random() % (width == 0 ? 0x80 : width == 1 ? 0x4000 : width == 2 ? 0x200000 : 0x10000000);
+            insertions.push_back(Insertion({ index, 1 + random() % (width == 3 ? 0x4000 : 0x80) }));
+        }
+        same = same && _round_trip(insertions);
+    }
+    CHECK(same);
+
+    // clear starts the deltas over
+    {
+        InsertionList list;
+        list.push_back(Insertion({ 1000, 2 }));
+        list.clear();
+        list.push_back(Insertion({ 3, 4 }));
+        CHECK(list.size() == 1 && list.byte_size() == 2 && list.begin()->index == 3 && list.begin()->number == 4);
+    }
+
+    // The algorithms of Insertion give the same runs over lists as over vectors
+    const std::vector<Insertion> lhs = { { 0, 2 }, { 3, 1 }, { 200, 300 }, { 20000, 1 } };
+    const std::vector<Insertion> rhs = { { 3, 4 }, { 150, 1 }, { 20000, 2 }, { 70000, 1 } };
+    const InsertionList lhs_list(lhs.cbegin(), lhs.cend()), rhs_list(rhs.cbegin(), rhs.cend());
+
+    std::vector<Insertion> sum, list_sum;
+    Insertion::plus(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(), std::back_inserter(sum));
+    InsertionList sum_list;
+    Insertion::plus(lhs_list.begin(), lhs_list.end(), rhs_list.begin(), rhs_list.end(), std::back_inserter(sum_list));
+    list_sum.assign(sum_list.begin(), sum_list.end());
+    CHECK(list_sum == sum);
+
+    InsertionList difference;
+    Insertion::minus(sum_list.begin(), sum_list.end(), rhs_list.begin(), rhs_list.end(), std::back_inserter(difference));
+    CHECK(std::vector<Insertion>(difference.begin(), difference.end()) == lhs);
+
+    const std::string sequence(70010, 'A');
+    std::string gapped, list_gapped;
+    Insertion::insert_gaps(sequence.cbegin(), sequence.cend(), rhs.cbegin(), rhs.cend(), std::back_inserter(gapped), '-');
+    Insertion::insert_gaps(sequence.cbegin(), sequence.cend(), rhs_list.begin(), rhs_list.end(), std::back_inserter(list_gapped), '-');
+    CHECK(gapped == list_gapped && gapped.size() == sequence.size() + 8);
+    return test::report("test_insertion_list");
+}
@@ -0,0 +1,117 @@
+// Minimizer index: every copy of a repeated minimizer is found even when other minimizers of its bucket are stored
+// between the copies, the occurrence cap counts all copies, and every maximal exact match of at least k + w - 1
+// symbols is reported, as a scan of all diagonals finds them
+#include "Test.hpp"
+#include "../MinimizerIndex/MinimizerIndex.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using triple = minimizer_index::MinimizerIndex::triple;
+
+static std::vector<unsigned char> _random_sequence(std::mt19937& random, size_t length)
+{
+    std::vector<unsigned char> sequence(length);
+    for (auto& c : sequence)
+        c = (unsigned char)(1 + random() % 4);
+    return sequence;
+}
+
+// Function to list the maximal exact matches of at least threshold symbols by walking every diagonal
+static std::vector<triple> _maximal_matches(const std::vector<unsigned char>& center, const std::vector<unsigned char>& query, size_t threshold)
+{
+    std::vector<triple> matches;
+    for (int64_t diagonal = -(int64_t)query.size(); diagonal < (int64_t)center.size(); ++diagonal)
+    {
+        size_t length = 0;
+        for (size_t rhs = diagonal < 0 ? (size_t)-diagonal : 0; ; ++rhs)
+        {
+            const size_t lhs = (size_t)(diagonal + (int64_t)rhs);
+            if (rhs < query.size() && lhs < center.size() && center[lhs] == query[rhs])
+            {
+                ++length;
+                continue;
+            }
+            if (length >= threshold)
+                matches.push_back(triple({ lhs - length, rhs - length, length }));
+            length = 0;
+            if (rhs >= query.size() || lhs >= center.size())
+                break;
+        }
+    }
+    return matches;
+}
+
+// Function to check that the index reports every maximal exact match long enough to contain a whole window, and
+// only maximal exact matches of at least k symbols
+static bool _check_matches(const std::vector<unsigned char>& center, const std::vector<unsigned char>& query, int k, int w)
+{
+    const minimizer_index::MinimizerIndex index(center.data(), center.size(), k, w);
+    std::vector<triple> found = index.get_common_substrings(query.cbegin(), query.cend(), (size_t)k);
+    std::vector<triple> all = _maximal_matches(center, query, (size_t)k);
+    std::sort(found.begin(), found.end());
+    std::sort(all.begin(), all.end());
+    if (!std::includes(all.begin(), all.end(), found.begin(), found.end()))
+        return false;
+    for (const auto& match : all)
+        if (match[2] >= (size_t)(k + w - 1) && !std::binary_search(found.begin(), found.end(), match))
+            return false;
+    return true;
+}
+
+int main()
+{
+    const int k = 15;
+    std::mt19937 random(3);
+    const std::vector<unsigned char> repeat = _random_sequence(random, k);
+
+    // 100 copies of one k-mer between random spacers: with w = 1 every other k-mer is a minimizer too, and many
+    // share the bucket of the repeat
+    bool all_copies = true, all_masked = true;
+    for (int seed = 0; seed != 200; ++seed)
+    {
+        std::mt19937 spacer_random(seed);
+        std::vector<unsigned char> center;
+        for (int copy = 0; copy != 100; ++copy)
+        {
+            const std::vector<unsigned char> spacer = _random_sequence(spacer_random, 20 + spacer_random() % 40);
+            center.insert(center.end(), spacer.begin(), spacer.end());
+            center.insert(center.end(), repeat.begin(), repeat.end());
+        }
+
+        minimizer_index::MinimizerIndex index(center.data(), center.size(), k, 1);
+        size_t copies = 0;
+        for (const auto& match : index.get_common_substrings(repeat.cbegin(), repeat.cend(), (size_t)k))
+            copies += match[2] == (size_t)k && std::equal(repeat.begin(), repeat.end(), center.begin() + match[0]);
+        all_copies = all_copies && copies == 100;
+
+        // The cap sees all 100 copies
+        index.set_occurrence_cap(99);
+        suffix_array::RepeatStats stats;
+        all_masked = all_masked && index.get_common_substrings(repeat.cbegin(), repeat.cend(), (size_t)k, &stats).empty()
+            && stats.masked_seeds == 1 && stats.masked_occurrences == 100 && stats.masked_bases == (size_t)k;
+        index.set_occurrence_cap(100);
+        all_masked = all_masked && index.get_common_substrings(repeat.cbegin(), repeat.cend(), (size_t)k).size() == 100;
+    }
+    CHECK(all_copies);
+    CHECK(all_masked);
+
+    // Queries sharing segments of several lengths, some repeated, with the center
+    bool same = true;
+    for (int n = 0; n != 40; ++n)
+    {
+        std::vector<unsigned char> center = _random_sequence(random, 3000), query = _random_sequence(random, 800);
+        for (int segment = 0; segment != 12; ++segment)
+        {
+            const size_t length = 10 + random() % 40, from = random() % (center.size() - length), to = random() % (query.size() - length);
+            std::copy(center.begin() + from, center.begin() + from + length, query.begin() + to);
+            if (segment % 3 == 0) // A second copy in the center
+                std::copy(center.begin() + from, center.begin() + from + length, center.begin() + random() % (center.size() - length));
+        }
+        for (int w : { 1, 5, 10 })
+            same = same && _check_matches(center, query, k, w) && _check_matches(center, query, 11, w);
+    }
+    CHECK(same);
+    return test::report("test_minimizer_index");
+}
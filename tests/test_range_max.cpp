@@ -0,0 +1,128 @@
+// Anchor chaining: RangeMaxTree answers like a scan over all points as values are raised, and chain_anchors finds
+// valid chains that score as much as the longest path of the all-pairs anchor graph
+#include "Test.hpp"
+#include "../Utils/RangeMax.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using anchor = std::array<size_t, 3>;
+
+// Function to raise values in random order and compare every query with a scan over the points
+static bool _check_tree(std::mt19937& random, size_t n, int64_t spread)
+{
+    std::vector<int64_t> u(n), v(n), value(n);
+    std::vector<bool> set(n, false);
+    for (size_t i = 0; i != n; ++i)
+    {
+        u[i] = (int64_t)(random() % spread) - spread / 2; // Repeated and negative coordinates
+        v[i] = (int64_t)(random() % spread) - spread / 2;
+    }
+    utils::RangeMaxTree tree(u, v);
+
+    for (size_t step = 0; step != 4 * n; ++step)
+    {
+        const size_t point = random() % n;
+        const int64_t raised = (int64_t)(random() % 1000) - 300;
+        tree.update(point, raised);
+        value[point] = set[point] ? std::max(value[point], raised) : raised;
+        set[point] = true;
+
+        int64_t u_low = (int64_t)(random() % spread) - spread / 2, u_high = (int64_t)(random() % spread) - spread / 2;
+        if (random() % 8 == 0) u_low = std::numeric_limits<int64_t>::min();
+        if (random() % 8 == 0) u_high = std::numeric_limits<int64_t>::max();
+        const int64_t v_high = (int64_t)(random() % spread) - spread / 2;
+
+        // Best point in the range: highest value, then lowest index
+        int64_t best = -1;
+        for (size_t i = 0; i != n; ++i)
+            if (set[i] && u[i] >= u_low && u[i] <= u_high && v[i] <= v_high && (best == -1 || value[i] > value[best]))
+                best = (int64_t)i;
+        const auto found = tree.query(u_low, u_high, v_high);
+        if (found.index != best || (best != -1 && found.value != value[best]))
+            return false;
+    }
+    return true;
+}
+
+// Score of the best chain by the longest path over the all-pairs graph, as _optimal_path computed it before
+static int64_t _graph_score(const std::vector<anchor>& anchors)
+{
+    const size_t n = anchors.size();
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i != n; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&anchors](size_t lhs, size_t rhs) { return anchors[lhs][0] + anchors[lhs][2] < anchors[rhs][0] + anchors[rhs][2]; });
+
+    std::vector<int64_t> score(n);
+    int64_t best = 0;
+    for (size_t k = 0; k != n; ++k)
+    {
+        const anchor& rhs = anchors[order[k]];
+        score[order[k]] = (int64_t)rhs[2];
+        for (size_t l = 0; l != k; ++l)
+        {
+            const anchor& lhs = anchors[order[l]];
+            if (lhs[0] + lhs[2] < rhs[0] + rhs[2] && lhs[1] + lhs[2] < rhs[1] + rhs[2])
+            {
+                const int64_t overlap = std::max((int64_t)(lhs[0] + lhs[2]) - (int64_t)rhs[0], (int64_t)(lhs[1] + lhs[2]) - (int64_t)rhs[1]);
+                score[order[k]] = std::max(score[order[k]], score[order[l]] + (int64_t)rhs[2] - std::max<int64_t>(0, overlap));
+            }
+        }
+        best = std::max(best, score[order[k]]);
+    }
+    return best;
+}
+
+// Function to check that consecutive anchors of a chain end later on both sequences and add up to the score
+static bool _valid_chain(const std::vector<anchor>& anchors, const std::vector<size_t>& chain, int64_t score)
+{
+    if (chain.empty())
+        return anchors.empty() && score == 0;
+    int64_t total = (int64_t)anchors[chain[0]][2];
+    for (size_t i = 1; i < chain.size(); ++i)
+    {
+        const anchor& lhs = anchors[chain[i - 1]];
+        const anchor& rhs = anchors[chain[i]];
+        if (lhs[0] + lhs[2] >= rhs[0] + rhs[2] || lhs[1] + lhs[2] >= rhs[1] + rhs[2])
+            return false;
+        const int64_t overlap = std::max((int64_t)(lhs[0] + lhs[2]) - (int64_t)rhs[0], (int64_t)(lhs[1] + lhs[2]) - (int64_t)rhs[1]);
+        total += (int64_t)rhs[2] - std::max<int64_t>(0, overlap);
+    }
+    return total == score;
+}
+
+int main()
+{
+    std::mt19937 random(13);
+    bool same = true;
+    for (size_t n : { 1, 2, 7, 64, 300 })
+        for (int64_t spread : { 4, 50, 100000 })
+            same = same && _check_tree(random, n, spread);
+    CHECK(same);
+
+    // Anchors near one diagonal with noise, overlapping and nested ones, and some far off it
+    bool scores = true, chains = true;
+    for (int set = 0; set != 3000; ++set)
+    {
+        const size_t n = random() % 60, span = 50 + random() % 2000;
+        std::vector<anchor> anchors;
+        for (size_t i = 0; i != n; ++i)
+        {
+            const size_t x = random() % span;
+            const size_t y = random() % 4 == 0 ? random() % span : (size_t)std::max<int64_t>(0, (int64_t)x + (int64_t)(random() % 21) - 10);
+            anchors.push_back(anchor({ x, y, 1 + random() % 40 }));
+        }
+        if (n > 2 && random() % 3 == 0)
+            anchors.push_back(anchors[random() % n]); // Duplicate anchor
+
+        int64_t score = -1;
+        const auto chain = utils::chain_anchors(anchors, &score);
+        scores = scores && score == _graph_score(anchors);
+        chains = chains && _valid_chain(anchors, chain, score);
+    }
+    CHECK(scores);
+    CHECK(chains);
+    return test::report("test_range_max");
+}
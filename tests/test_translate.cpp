@@ -0,0 +1,68 @@
+// SIMD translation kernels against the scalar tables, at every alignment and block boundary
+#include "Test.hpp"
+#include "../Utils/Utils.hpp"
+#include "../Utils/Pseudo.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+extern char chars[8];
+
+// Scalar reference of translate_to_pseudo: one table lookup per byte, line breaks dropped
+static std::vector<unsigned char> _reference(const std::string& text)
+{
+    std::vector<unsigned char> codes;
+    for (char c : text)
+        if (c != '\r' && c != '\n')
+            codes.push_back(utils::to_pseudo(c));
+    return codes;
+}
+
+static void _check_to_pseudo(const std::string& text)
+{
+    // Translate from every offset of a padded buffer so the vector loads start at every alignment
+    for (size_t offset = 0; offset != 33; ++offset)
+    {
+        const std::string padded = std::string(offset, 'x') + text;
+        std::vector<unsigned char> codes(text.size());
+        codes.resize(utils::translate_to_pseudo(padded.data() + offset, padded.data() + padded.size(), codes.data()));
+        CHECK(codes == _reference(text));
+    }
+}
+
+int main()
+{
+    // Every byte value, in blocks with and without line breaks
+    std::string all_bytes;
+    for (int c = 0; c != 256; ++c)
+        all_bytes.push_back((char)c);
+    _check_to_pseudo(all_bytes);
+    _check_to_pseudo(std::string(64, 'A') + "\r\n" + std::string(61, 'c') + "\n");
+
+    // Random bases, lower case, IUPAC codes and line breaks at every length around the block sizes
+    std::mt19937 random(7);
+    const std::string alphabet = "ACGTUacgtuNnRYKMSWBDHV-*.\r\n";
+    for (size_t length = 0; length != 200; ++length)
+    {
+        std::string text;
+        for (size_t i = 0; i != length; ++i)
+            text.push_back(alphabet[random() % alphabet.size()]);
+        _check_to_pseudo(text);
+    }
+
+    // Every code back to characters through the output table
+    std::vector<unsigned char> codes(1000);
+    for (size_t i = 0; i != codes.size(); ++i)
+        codes[i] = (unsigned char)(random() % 8);
+    for (size_t offset = 0; offset != 33; ++offset)
+    {
+        std::string text(codes.size() - offset, '\0');
+        utils::translate_from_pseudo(codes.data() + offset, codes.data() + codes.size(), &text[0], chars);
+        bool same = true;
+        for (size_t i = 0; i != text.size(); ++i)
+            same = same && text[i] == chars[codes[offset + i]];
+        CHECK(same);
+    }
+    return test::report("test_translate");
+}